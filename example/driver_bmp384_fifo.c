@@ -56,6 +56,43 @@ uint8_t bmp384_fifo_irq_handler(void)
     return 0;
 }
 
+/**
+ * @brief     fifo example irq handler with the interrupt payload
+ * @param[in] *buf pointer a fifo data buffer
+ * @param[in] buf_len fifo data buffer length
+ * @param[in] *sample pointer a sample buffer
+ * @param[in] sample_len sample buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+uint8_t bmp384_fifo_irq_handler_read(uint8_t *buf, uint16_t buf_len, bmp384_sample_t *sample, uint16_t sample_len)
+{
+    /* run irq handler and read the payload */
+    if (bmp384_irq_handler_read(&gs_handle, buf, buf_len, sample, sample_len) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     fifo example link the receive data callback
+ * @param[in] *fifo_receive_data_callback pointer to a fifo receive data callback
+ * @return    status code
+ *            - 0 success
+ * @note      call it after bmp384_fifo_init
+ */
+uint8_t bmp384_fifo_link_receive_data_callback(void (*fifo_receive_data_callback)(uint8_t type, bmp384_sample_t *sample, uint16_t len))
+{
+    /* link receive data callback */
+    DRIVER_BMP384_LINK_RECEIVE_DATA_CALLBACK(&gs_handle, fifo_receive_data_callback);
+    
+    return 0;
+}
+
 /**
  * @brief     fifo example init
  * @param[in] interface chip interface
@@ -70,6 +107,7 @@ uint8_t bmp384_fifo_init(bmp384_interface_t interface, bmp384_address_t addr_pin
                          void (*fifo_receive_callback)(uint8_t type))
 {
     uint8_t res;
+    bmp384_config_t config;
     
     /* link functions */
     DRIVER_BMP384_LINK_INIT(&gs_handle, bmp384_handle_t);
@@ -77,10 +115,13 @@ uint8_t bmp384_fifo_init(bmp384_interface_t interface, bmp384_address_t addr_pin
     DRIVER_BMP384_LINK_IIC_DEINIT(&gs_handle, bmp384_interface_iic_deinit);
     DRIVER_BMP384_LINK_IIC_READ(&gs_handle, bmp384_interface_iic_read);
     DRIVER_BMP384_LINK_IIC_WRITE(&gs_handle, bmp384_interface_iic_write);
+    DRIVER_BMP384_LINK_IIC_TRANSFER(&gs_handle, bmp384_interface_iic_transfer);
     DRIVER_BMP384_LINK_SPI_INIT(&gs_handle, bmp384_interface_spi_init);
     DRIVER_BMP384_LINK_SPI_DEINIT(&gs_handle, bmp384_interface_spi_deinit);
     DRIVER_BMP384_LINK_SPI_READ(&gs_handle, bmp384_interface_spi_read);
     DRIVER_BMP384_LINK_SPI_WRITE(&gs_handle, bmp384_interface_spi_write);
+    DRIVER_BMP384_LINK_SPI_READ_DIRECT(&gs_handle, bmp384_interface_spi_read_direct);
+    DRIVER_BMP384_LINK_SPI_TRANSFER(&gs_handle, bmp384_interface_spi_transfer);
     DRIVER_BMP384_LINK_DELAY_MS(&gs_handle, bmp384_interface_delay_ms);
     DRIVER_BMP384_LINK_DEBUG_PRINT(&gs_handle, bmp384_interface_debug_print);
     DRIVER_BMP384_LINK_RECEIVE_CALLBACK(&gs_handle, fifo_receive_callback);
@@ -112,246 +153,52 @@ uint8_t bmp384_fifo_init(bmp384_interface_t interface, bmp384_address_t addr_pin
         return 1;
     }
     
-    /* set spi wire 4 */
-    res = bmp384_set_spi_wire(&gs_handle, BMP384_FIFO_DEFAULT_SPI_WIRE);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set spi wire failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default iic watchdog timer */
-    res = bmp384_set_iic_watchdog_timer(&gs_handle, BMP384_FIFO_DEFAULT_IIC_WATCHDOG_TIMER);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set iic watchdog timer failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default iic watchdog period */
-    res = bmp384_set_iic_watchdog_period(&gs_handle, BMP384_FIFO_DEFAULT_IIC_WATCHDOG_PERIOD);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set iic watchdog period failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* enable fifo */
-    res = bmp384_set_fifo(&gs_handle, BMP384_BOOL_TRUE);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set fifo failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default fifo stop on full */
-    res = bmp384_set_fifo_stop_on_full(&gs_handle, BMP384_FIFO_DEFAULT_FIFO_STOP_ON_FULL);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set fifo stop on full failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default fifo watermark */
-    res = bmp384_set_fifo_watermark(&gs_handle, BMP384_FIFO_DEFAULT_FIFO_WATERMARK);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set fifo watermark failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default fifo sensor time on */
-    res = bmp384_set_fifo_sensortime_on(&gs_handle, BMP384_FIFO_DEFAULT_FIFO_SENSORTIME_ON);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set fifo sensor time on failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default fifo pressure on */
-    res = bmp384_set_fifo_pressure_on(&gs_handle, BMP384_FIFO_DEFAULT_FIFO_PRESSURE_ON);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set fifo sensor time on failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default fifo temperature on */
-    res = bmp384_set_fifo_temperature_on(&gs_handle, BMP384_FIFO_DEFAULT_FIFO_TEMPERATURE_ON);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set fifo temperature on failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default fifo subsampling */
-    res = bmp384_set_fifo_subsampling(&gs_handle, BMP384_FIFO_DEFAULT_FIFO_SUBSAMPLING);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set fifo subsampling failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default fifo data source */
-    res = bmp384_set_fifo_data_source(&gs_handle,BMP384_FIFO_DEFAULT_FIFO_DATA_SOURCE);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set fifo data source failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default interrupt pin type */
-    res = bmp384_set_interrupt_pin_type(&gs_handle, BMP384_FIFO_DEFAULT_INTERRUPT_PIN_TYPE);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set interrupt pin type failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default interrupt active level */
-    res = bmp384_set_interrupt_active_level(&gs_handle, BMP384_FIFO_DEFAULT_INTERRUPT_ACTIVE_LEVEL);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set interrupt active level failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default latch interrupt pin and interrupt status */
-    res = bmp384_set_latch_interrupt_pin_and_interrupt_status(&gs_handle, BMP384_FIFO_DEFAULT_LATCH_INTERRUPT);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set latch interrupt pin and interrupt status failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default interrupt fifo watermark */
-    res = bmp384_set_interrupt_fifo_watermark(&gs_handle, BMP384_FIFO_DEFAULT_INTERRUPT_WATERMARK);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set interrupt fifo watermark failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default interrupt fifo full */
-    res = bmp384_set_interrupt_fifo_full(&gs_handle, BMP384_FIFO_DEFAULT_INTERRUPT_FIFO_FULL);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set interrupt fifo full failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default interrupt data ready */
-    res = bmp384_set_interrupt_data_ready(&gs_handle,BMP384_FIFO_DEFAULT_INTERRUPT_DATA_READY);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set interrupt data ready failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default pressure */
-    res = bmp384_set_pressure(&gs_handle, BMP384_FIFO_DEFAULT_PRESSURE);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set pressure failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default temperature */
-    res = bmp384_set_temperature(&gs_handle, BMP384_FIFO_DEFAULT_TEMPERATURE);
+    /* enable register shadow */
+    res = bmp384_set_register_shadow(&gs_handle, BMP384_BOOL_TRUE);
     if (res != 0)
     {
-        bmp384_interface_debug_print("bmp384: set temperature failed.\n");
+        bmp384_interface_debug_print("bmp384: set register shadow failed.\n");
         (void)bmp384_deinit(&gs_handle);
         
         return 1;
     }
     
-    /* set default pressure oversampling */
-    res = bmp384_set_pressure_oversampling(&gs_handle, BMP384_FIFO_DEFAULT_PRESSURE_OVERSAMPLING);
+    /* set default config */
+    config.spi_wire = BMP384_FIFO_DEFAULT_SPI_WIRE;
+    config.iic_watchdog_timer = BMP384_FIFO_DEFAULT_IIC_WATCHDOG_TIMER;
+    config.iic_watchdog_period = BMP384_FIFO_DEFAULT_IIC_WATCHDOG_PERIOD;
+    config.fifo = BMP384_BOOL_TRUE;
+    config.fifo_stop_on_full = BMP384_FIFO_DEFAULT_FIFO_STOP_ON_FULL;
+    config.fifo_watermark = BMP384_FIFO_DEFAULT_FIFO_WATERMARK;
+    config.fifo_sensortime_on = BMP384_FIFO_DEFAULT_FIFO_SENSORTIME_ON;
+    config.fifo_pressure_on = BMP384_FIFO_DEFAULT_FIFO_PRESSURE_ON;
+    config.fifo_temperature_on = BMP384_FIFO_DEFAULT_FIFO_TEMPERATURE_ON;
+    config.fifo_subsampling = BMP384_FIFO_DEFAULT_FIFO_SUBSAMPLING;
+    config.fifo_data_source = BMP384_FIFO_DEFAULT_FIFO_DATA_SOURCE;
+    config.interrupt_pin_type = BMP384_FIFO_DEFAULT_INTERRUPT_PIN_TYPE;
+    config.interrupt_active_level = BMP384_FIFO_DEFAULT_INTERRUPT_ACTIVE_LEVEL;
+    config.latch_interrupt_pin_and_interrupt_status = BMP384_FIFO_DEFAULT_LATCH_INTERRUPT;
+    config.interrupt_fifo_watermark = BMP384_FIFO_DEFAULT_INTERRUPT_WATERMARK;
+    config.interrupt_fifo_full = BMP384_FIFO_DEFAULT_INTERRUPT_FIFO_FULL;
+    config.interrupt_data_ready = BMP384_FIFO_DEFAULT_INTERRUPT_DATA_READY;
+    config.pressure = BMP384_FIFO_DEFAULT_PRESSURE;
+    config.temperature = BMP384_FIFO_DEFAULT_TEMPERATURE;
+    config.pressure_oversampling = BMP384_FIFO_DEFAULT_PRESSURE_OVERSAMPLING;
+    config.temperature_oversampling = BMP384_FIFO_DEFAULT_TEMPERATURE_OVERSAMPLING;
+    config.odr = BMP384_FIFO_DEFAULT_ODR;
+    config.filter_coefficient = BMP384_FIFO_DEFAULT_FILTER_COEFFICIENT;
+    config.mode = BMP384_MODE_NORMAL_MODE;
+    
+    /* apply config */
+    res = bmp384_apply_config(&gs_handle, &config);
     if (res != 0)
     {
-        bmp384_interface_debug_print("bmp384: set pressure oversampling failed.\n");
+        bmp384_interface_debug_print("bmp384: apply config failed.\n");
         (void)bmp384_deinit(&gs_handle);
         
         return 1;
     }
     
-    /* set default temperature oversampling */
-    res = bmp384_set_temperature_oversampling(&gs_handle, BMP384_FIFO_DEFAULT_TEMPERATURE_OVERSAMPLING);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set temperature oversampling failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default odr */
-    res = bmp384_set_odr(&gs_handle, BMP384_FIFO_DEFAULT_ODR);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set odr failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default filter coefficient */
-    res = bmp384_set_filter_coefficient(&gs_handle, BMP384_FIFO_DEFAULT_FILTER_COEFFICIENT);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set filter coefficient failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set normal mode */
-    res = bmp384_set_mode(&gs_handle, BMP384_MODE_NORMAL_MODE);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set mode failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    } 
-    
     return 0;
 }
 
@@ -382,6 +229,33 @@ uint8_t bmp384_fifo_read(uint8_t *buf, uint16_t buf_len, bmp384_frame_t *frame,
     return 0;
 }
 
+/**
+ * @brief         fifo example read samples
+ * @param[in]     *buf pointer a data buffer
+ * @param[in]     buf_len data buffer length
+ * @param[out]    *sample pointer a sample structure
+ * @param[in,out] *sample_len pointer a sample length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 read failed
+ * @note          none
+ */
+uint8_t bmp384_fifo_read_sample(uint8_t *buf, uint16_t buf_len, bmp384_sample_t *sample, uint16_t *sample_len)
+{
+    /* read fifo */
+    if (bmp384_read_fifo(&gs_handle, (uint8_t *)buf, (uint16_t *)&buf_len) != 0)
+    {
+        return 1;
+    }
+    /* parse fifo samples */
+    if (bmp384_fifo_parse_sample(&gs_handle, (uint8_t *)buf, buf_len, (bmp384_sample_t *)sample, (uint16_t *)sample_len) != 0)
+    {
+        return 1;
+    }
+   
+    return 0;
+}
+
 /**
  * @brief  fifo example deinit
  * @return status code
@@ -83,6 +83,19 @@ extern "C"{
  */
 uint8_t bmp384_fifo_irq_handler(void);
 
+/**
+ * @brief     fifo example irq handler with the interrupt payload
+ * @param[in] *buf pointer a fifo data buffer
+ * @param[in] buf_len fifo data buffer length
+ * @param[in] *sample pointer a sample buffer
+ * @param[in] sample_len sample buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+uint8_t bmp384_fifo_irq_handler_read(uint8_t *buf, uint16_t buf_len, bmp384_sample_t *sample, uint16_t sample_len);
+
 /**
  * @brief     fifo example init
  * @param[in] interface chip interface
@@ -96,6 +109,15 @@ uint8_t bmp384_fifo_irq_handler(void);
 uint8_t bmp384_fifo_init(bmp384_interface_t interface, bmp384_address_t addr_pin,
                          void (*fifo_receive_callback)(uint8_t type));
 
+/**
+ * @brief     fifo example link the receive data callback
+ * @param[in] *fifo_receive_data_callback pointer to a fifo receive data callback
+ * @return    status code
+ *            - 0 success
+ * @note      call it after bmp384_fifo_init
+ */
+uint8_t bmp384_fifo_link_receive_data_callback(void (*fifo_receive_data_callback)(uint8_t type, bmp384_sample_t *sample, uint16_t len));
+
 /**
  * @brief  fifo example deinit
  * @return status code
@@ -118,6 +140,19 @@ uint8_t bmp384_fifo_deinit(void);
  */
 uint8_t bmp384_fifo_read(uint8_t *buf, uint16_t buf_len, bmp384_frame_t *frame, uint16_t *frame_len);
 
+/**
+ * @brief         fifo example read samples
+ * @param[in]     *buf pointer a data buffer
+ * @param[in]     buf_len data buffer length
+ * @param[out]    *sample pointer a sample structure
+ * @param[in,out] *sample_len pointer a sample length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 read failed
+ * @note          none
+ */
+uint8_t bmp384_fifo_read_sample(uint8_t *buf, uint16_t buf_len, bmp384_sample_t *sample, uint16_t *sample_len);
+
 /**
  * @}
  */
@@ -70,6 +70,7 @@ uint8_t bmp384_interrupt_init(bmp384_interface_t interface, bmp384_address_t add
                               void (*interrupt_receive_callback)(uint8_t type))
 {
     uint8_t res;
+    bmp384_config_t config;
     
     /* link functions */
     DRIVER_BMP384_LINK_INIT(&gs_handle, bmp384_handle_t);
@@ -77,10 +78,13 @@ uint8_t bmp384_interrupt_init(bmp384_interface_t interface, bmp384_address_t add
     DRIVER_BMP384_LINK_IIC_DEINIT(&gs_handle, bmp384_interface_iic_deinit);
     DRIVER_BMP384_LINK_IIC_READ(&gs_handle, bmp384_interface_iic_read);
     DRIVER_BMP384_LINK_IIC_WRITE(&gs_handle, bmp384_interface_iic_write);
+    DRIVER_BMP384_LINK_IIC_TRANSFER(&gs_handle, bmp384_interface_iic_transfer);
     DRIVER_BMP384_LINK_SPI_INIT(&gs_handle, bmp384_interface_spi_init);
     DRIVER_BMP384_LINK_SPI_DEINIT(&gs_handle, bmp384_interface_spi_deinit);
     DRIVER_BMP384_LINK_SPI_READ(&gs_handle, bmp384_interface_spi_read);
     DRIVER_BMP384_LINK_SPI_WRITE(&gs_handle, bmp384_interface_spi_write);
+    DRIVER_BMP384_LINK_SPI_READ_DIRECT(&gs_handle, bmp384_interface_spi_read_direct);
+    DRIVER_BMP384_LINK_SPI_TRANSFER(&gs_handle, bmp384_interface_spi_transfer);
     DRIVER_BMP384_LINK_DELAY_MS(&gs_handle, bmp384_interface_delay_ms);
     DRIVER_BMP384_LINK_DEBUG_PRINT(&gs_handle, bmp384_interface_debug_print);
     DRIVER_BMP384_LINK_RECEIVE_CALLBACK(&gs_handle, interrupt_receive_callback);
@@ -112,171 +116,47 @@ uint8_t bmp384_interrupt_init(bmp384_interface_t interface, bmp384_address_t add
         return 1;
     }
     
-    /* set default spi wire */
-    res = bmp384_set_spi_wire(&gs_handle, BMP384_INTERRUPT_DEFAULT_SPI_WIRE);
+    /* enable register shadow */
+    res = bmp384_set_register_shadow(&gs_handle, BMP384_BOOL_TRUE);
     if (res != 0)
     {
-        bmp384_interface_debug_print("bmp384: set spi wire failed.\n");
+        bmp384_interface_debug_print("bmp384: set register shadow failed.\n");
         (void)bmp384_deinit(&gs_handle);
         
         return 1;
     }
     
-    /* set default iic watchdog timer */
-    res = bmp384_set_iic_watchdog_timer(&gs_handle, BMP384_INTERRUPT_DEFAULT_IIC_WATCHDOG_TIMER);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set iic watchdog timer failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default iic watchdog period */
-    res = bmp384_set_iic_watchdog_period(&gs_handle, BMP384_INTERRUPT_DEFAULT_IIC_WATCHDOG_PERIOD);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set iic watchdog period failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* disable fifo */
-    res = bmp384_set_fifo(&gs_handle, BMP384_BOOL_FALSE);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set fifo failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default interrupt pin type */
-    res = bmp384_set_interrupt_pin_type(&gs_handle, BMP384_INTERRUPT_DEFAULT_INTERRUPT_PIN_TYPE);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set interrupt pin type failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default interrupt active level */
-    res = bmp384_set_interrupt_active_level(&gs_handle, BMP384_INTERRUPT_DEFAULT_INTERRUPT_ACTIVE_LEVEL);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set interrupt active level failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* disable latch interrupt pin and interrupt status */
-    res = bmp384_set_latch_interrupt_pin_and_interrupt_status(&gs_handle, BMP384_BOOL_FALSE);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set latch interrupt pin and interrupt status failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* disable interrupt fifo watermark */
-    res = bmp384_set_interrupt_fifo_watermark(&gs_handle, BMP384_BOOL_FALSE);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set interrupt fifo watermark failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* disable interrupt fifo full */
-    res = bmp384_set_interrupt_fifo_full(&gs_handle, BMP384_BOOL_FALSE);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set interrupt fifo full failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* enable interrupt data ready */
-    res = bmp384_set_interrupt_data_ready(&gs_handle,BMP384_BOOL_TRUE);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set interrupt data ready failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default pressure */
-    res = bmp384_set_pressure(&gs_handle, BMP384_INTERRUPT_DEFAULT_PRESSURE);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set pressure failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default temperature */
-    res = bmp384_set_temperature(&gs_handle, BMP384_INTERRUPT_DEFAULT_TEMPERATURE);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set temperature failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default pressure oversampling */
-    res = bmp384_set_pressure_oversampling(&gs_handle, BMP384_INTERRUPT_DEFAULT_PRESSURE_OVERSAMPLING);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set pressure oversampling failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default temperature oversampling */
-    res = bmp384_set_temperature_oversampling(&gs_handle, BMP384_INTERRUPT_DEFAULT_TEMPERATURE_OVERSAMPLING);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set temperature oversampling failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default odr */
-    res = bmp384_set_odr(&gs_handle, BMP384_INTERRUPT_DEFAULT_ODR);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set odr failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
-    
-    /* set default filter coefficient */
-    res = bmp384_set_filter_coefficient(&gs_handle, BMP384_INTERRUPT_DEFAULT_FILTER_COEFFICIENT);
-    if (res != 0)
-    {
-        bmp384_interface_debug_print("bmp384: set filter coefficient failed.\n");
-        (void)bmp384_deinit(&gs_handle);
-        
-        return 1;
-    }
+    /* set default config */
+    config.spi_wire = BMP384_INTERRUPT_DEFAULT_SPI_WIRE;
+    config.iic_watchdog_timer = BMP384_INTERRUPT_DEFAULT_IIC_WATCHDOG_TIMER;
+    config.iic_watchdog_period = BMP384_INTERRUPT_DEFAULT_IIC_WATCHDOG_PERIOD;
+    config.fifo = BMP384_BOOL_FALSE;
+    config.fifo_stop_on_full = BMP384_BOOL_TRUE;
+    config.fifo_watermark = 1;
+    config.fifo_sensortime_on = BMP384_BOOL_FALSE;
+    config.fifo_pressure_on = BMP384_BOOL_FALSE;
+    config.fifo_temperature_on = BMP384_BOOL_FALSE;
+    config.fifo_subsampling = 2;
+    config.fifo_data_source = BMP384_FIFO_DATA_SOURCE_UNFILTERED;
+    config.interrupt_pin_type = BMP384_INTERRUPT_DEFAULT_INTERRUPT_PIN_TYPE;
+    config.interrupt_active_level = BMP384_INTERRUPT_DEFAULT_INTERRUPT_ACTIVE_LEVEL;
+    config.latch_interrupt_pin_and_interrupt_status = BMP384_BOOL_FALSE;
+    config.interrupt_fifo_watermark = BMP384_BOOL_FALSE;
+    config.interrupt_fifo_full = BMP384_BOOL_FALSE;
+    config.interrupt_data_ready = BMP384_BOOL_TRUE;
+    config.pressure = BMP384_INTERRUPT_DEFAULT_PRESSURE;
+    config.temperature = BMP384_INTERRUPT_DEFAULT_TEMPERATURE;
+    config.pressure_oversampling = BMP384_INTERRUPT_DEFAULT_PRESSURE_OVERSAMPLING;
+    config.temperature_oversampling = BMP384_INTERRUPT_DEFAULT_TEMPERATURE_OVERSAMPLING;
+    config.odr = BMP384_INTERRUPT_DEFAULT_ODR;
+    config.filter_coefficient = BMP384_INTERRUPT_DEFAULT_FILTER_COEFFICIENT;
+    config.mode = BMP384_MODE_NORMAL_MODE;
     
-    /* set normal mode */
-    res = bmp384_set_mode(&gs_handle, BMP384_MODE_NORMAL_MODE);
+    /* apply config */
+    res = bmp384_apply_config(&gs_handle, &config);
     if (res != 0)
     {
-        bmp384_interface_debug_print("bmp384: set mode failed.\n");
+        bmp384_interface_debug_print("bmp384: apply config failed.\n");
         (void)bmp384_deinit(&gs_handle);
         
         return 1;
@@ -57,10 +57,13 @@ uint8_t bmp384_shot_init(bmp384_interface_t interface, bmp384_address_t addr_pin
     DRIVER_BMP384_LINK_IIC_DEINIT(&gs_handle, bmp384_interface_iic_deinit);
     DRIVER_BMP384_LINK_IIC_READ(&gs_handle, bmp384_interface_iic_read);
     DRIVER_BMP384_LINK_IIC_WRITE(&gs_handle, bmp384_interface_iic_write);
+    DRIVER_BMP384_LINK_IIC_TRANSFER(&gs_handle, bmp384_interface_iic_transfer);
     DRIVER_BMP384_LINK_SPI_INIT(&gs_handle, bmp384_interface_spi_init);
     DRIVER_BMP384_LINK_SPI_DEINIT(&gs_handle, bmp384_interface_spi_deinit);
     DRIVER_BMP384_LINK_SPI_READ(&gs_handle, bmp384_interface_spi_read);
     DRIVER_BMP384_LINK_SPI_WRITE(&gs_handle, bmp384_interface_spi_write);
+    DRIVER_BMP384_LINK_SPI_READ_DIRECT(&gs_handle, bmp384_interface_spi_read_direct);
+    DRIVER_BMP384_LINK_SPI_TRANSFER(&gs_handle, bmp384_interface_spi_transfer);
     DRIVER_BMP384_LINK_DELAY_MS(&gs_handle, bmp384_interface_delay_ms);
     DRIVER_BMP384_LINK_DEBUG_PRINT(&gs_handle, bmp384_interface_debug_print);
     DRIVER_BMP384_LINK_RECEIVE_CALLBACK(&gs_handle, bmp384_interface_receive_callback);
@@ -92,6 +95,16 @@ uint8_t bmp384_shot_init(bmp384_interface_t interface, bmp384_address_t addr_pin
         return 1;
     }
     
+    /* enable register shadow */
+    res = bmp384_set_register_shadow(&gs_handle, BMP384_BOOL_TRUE);
+    if (res != 0)
+    {
+        bmp384_interface_debug_print("bmp384: set register shadow failed.\n");
+        (void)bmp384_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
     /* set default spi wire */
     res = bmp384_set_spi_wire(&gs_handle, BMP384_SHOT_DEFAULT_SPI_WIRE);
     if (res != 0)
@@ -92,6 +92,22 @@ uint8_t bmp384_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint
     return 0;
 }
 
+/**
+ * @brief     interface iic bus transfer
+ * @param[in] addr iic device write address
+ * @param[in] *transfer pointer to a transfer array
+ * @param[in] num transfer number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      runs all transfers in one bus transaction with repeated starts,
+ *            num is at most BMP384_TRANSFER_MAX_NUM
+ */
+uint8_t bmp384_interface_iic_transfer(uint8_t addr, bmp384_transfer_t *transfer, uint16_t num)
+{
+    return 0;
+}
+
 /**
  * @brief  interface spi bus init
  * @return status code
@@ -146,6 +162,37 @@ uint8_t bmp384_interface_spi_write(uint8_t reg, uint8_t *buf, uint16_t len)
     return 0;
 }
 
+/**
+ * @brief      interface spi bus read without the dummy byte copy
+ * @param[in]  reg register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       sends reg and one dummy byte, then reads len bytes straight into buf
+ */
+uint8_t bmp384_interface_spi_read_direct(uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface spi bus transfer
+ * @param[in] *transfer pointer to a transfer array
+ * @param[in] num transfer number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      runs all transfers in one bus call with one chip select each,
+ *            a read sends reg and one dummy byte, then reads len bytes straight into buf,
+ *            num is at most BMP384_TRANSFER_MAX_NUM
+ */
+uint8_t bmp384_interface_spi_transfer(bmp384_transfer_t *transfer, uint16_t num)
+{
+    return 0;
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
@@ -201,3 +248,193 @@ void bmp384_interface_receive_callback(uint8_t type)
         }
     }
 }
+
+/**
+ * @brief     interface iic bus init with context
+ * @param[in] *ctx pointer to an interface context
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic init failed
+ * @note      none
+ */
+uint8_t bmp384_interface_iic_init_ctx(void *ctx)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface iic bus deinit with context
+ * @param[in] *ctx pointer to an interface context
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic deinit failed
+ * @note      none
+ */
+uint8_t bmp384_interface_iic_deinit_ctx(void *ctx)
+{
+    return 0;
+}
+
+/**
+ * @brief      interface iic bus read with context
+ * @param[in]  *ctx pointer to an interface context
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t bmp384_interface_iic_read_ctx(void *ctx, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface iic bus write with context
+ * @param[in] *ctx pointer to an interface context
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t bmp384_interface_iic_write_ctx(void *ctx, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface iic bus transfer with context
+ * @param[in] *ctx pointer to an interface context
+ * @param[in] addr iic device write address
+ * @param[in] *transfer pointer to a transfer array
+ * @param[in] num transfer number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      runs all transfers in one bus transaction with repeated starts,
+ *            num is at most BMP384_TRANSFER_MAX_NUM
+ */
+uint8_t bmp384_interface_iic_transfer_ctx(void *ctx, uint8_t addr, bmp384_transfer_t *transfer, uint16_t num)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface spi bus init with context
+ * @param[in] *ctx pointer to an interface context
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi init failed
+ * @note      none
+ */
+uint8_t bmp384_interface_spi_init_ctx(void *ctx)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface spi bus deinit with context
+ * @param[in] *ctx pointer to an interface context
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi deinit failed
+ * @note      none
+ */
+uint8_t bmp384_interface_spi_deinit_ctx(void *ctx)
+{
+    return 0;
+}
+
+/**
+ * @brief      interface spi bus read with context
+ * @param[in]  *ctx pointer to an interface context
+ * @param[in]  reg register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t bmp384_interface_spi_read_ctx(void *ctx, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface spi bus write with context
+ * @param[in] *ctx pointer to an interface context
+ * @param[in] reg register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t bmp384_interface_spi_write_ctx(void *ctx, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return 0;
+}
+
+/**
+ * @brief      interface spi bus read without the dummy byte copy with context
+ * @param[in]  *ctx pointer to an interface context
+ * @param[in]  reg register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       sends reg and one dummy byte, then reads len bytes straight into buf
+ */
+uint8_t bmp384_interface_spi_read_direct_ctx(void *ctx, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface spi bus transfer with context
+ * @param[in] *ctx pointer to an interface context
+ * @param[in] *transfer pointer to a transfer array
+ * @param[in] num transfer number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      runs all transfers in one bus call with one chip select each,
+ *            a read sends reg and one dummy byte, then reads len bytes straight into buf,
+ *            num is at most BMP384_TRANSFER_MAX_NUM
+ */
+uint8_t bmp384_interface_spi_transfer_ctx(void *ctx, bmp384_transfer_t *transfer, uint16_t num)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface delay ms with context
+ * @param[in] *ctx pointer to an interface context
+ * @param[in] ms time
+ * @note      none
+ */
+void bmp384_interface_delay_ms_ctx(void *ctx, uint32_t ms)
+{
+
+}
+
+/**
+ * @brief     interface receive callback with context
+ * @param[in] *ctx pointer to an interface context
+ * @param[in] type interrupt type
+ * @note      none
+ */
+void bmp384_interface_receive_callback_ctx(void *ctx, uint8_t type)
+{
+    bmp384_interface_receive_callback(type);
+}
@@ -34,7 +34,7 @@
  * </table>
  */
 
-#include "driver_bmp384_interface.h"
+#include "raspberrypi4b_driver_bmp384_interface.h"
 #include "iic.h"
 #include "spi.h"
 #include <stdarg.h>
@@ -115,6 +115,114 @@ uint8_t bmp384_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint
     return iic_write(gs_iic_fd, addr, reg, buf, len);
 }
 
+/**
+ * @brief     interface iic bus transfer
+ * @param[in] addr iic device write address
+ * @param[in] *transfer pointer to a transfer array
+ * @param[in] num transfer number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      runs all transfers in one bus transaction with repeated starts,
+ *            num is at most BMP384_TRANSFER_MAX_NUM
+ */
+uint8_t bmp384_interface_iic_transfer(uint8_t addr, bmp384_transfer_t *transfer, uint16_t num)
+{
+    uint16_t i;
+    iic_transfer_t list[BMP384_TRANSFER_MAX_NUM];
+    
+    /* check the transfer number */
+    if ((num == 0) || (num > BMP384_TRANSFER_MAX_NUM))
+    {
+        return 1;
+    }
+    
+    for (i = 0; i < num; i++)
+    {
+        list[i].reg = transfer[i].reg;
+        list[i].read = transfer[i].read;
+        list[i].buf = transfer[i].buf;
+        list[i].len = transfer[i].len;
+    }
+    
+    return iic_transfer(gs_iic_fd, addr, list, num);
+}
+
+/**
+ * @brief     run bmp384 transfers on a spi handle
+ * @param[in] fd spi handle
+ * @param[in] *transfer pointer to a transfer array
+ * @param[in] num transfer number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      a read takes a command segment with reg and one dummy byte and a data segment,
+ *            a write takes one segment, every transfer ends with a chip select release,
+ *            the writes fit in BMP384_TRANSFER_MAX_NUM * 2 command bytes
+ */
+static uint8_t a_bmp384_interface_spi_transfer(int fd, bmp384_transfer_t *transfer, uint16_t num)
+{
+    uint16_t i;
+    uint16_t n;
+    uint32_t total;
+    uint32_t offset;
+    spi_transfer_t list[BMP384_TRANSFER_MAX_NUM * 2];
+    uint8_t command[BMP384_TRANSFER_MAX_NUM * 2];
+    
+    /* check the transfer number */
+    if ((num == 0) || (num > BMP384_TRANSFER_MAX_NUM))
+    {
+        return 1;
+    }
+    
+    /* get the command length */
+    total = 0;
+    for (i = 0; i < num; i++)
+    {
+        total += (transfer[i].read != 0) ? 2 : (transfer[i].len + 1);
+    }
+    
+    /* check the command length */
+    if (total > sizeof(command))
+    {
+        return 1;
+    }
+    
+    /* set the segments */
+    n = 0;
+    offset = 0;
+    for (i = 0; i < num; i++)
+    {
+        command[offset] = transfer[i].reg;
+        if (transfer[i].read != 0)
+        {
+            command[offset + 1] = 0x00;
+            list[n].tx_buf = &command[offset];
+            list[n].rx_buf = NULL;
+            list[n].len = 2;
+            list[n].cs_change = 0;
+            list[n + 1].tx_buf = NULL;
+            list[n + 1].rx_buf = transfer[i].buf;
+            list[n + 1].len = transfer[i].len;
+            list[n + 1].cs_change = 1;
+            offset += 2;
+            n += 2;
+        }
+        else
+        {
+            memcpy(&command[offset + 1], transfer[i].buf, transfer[i].len);
+            list[n].tx_buf = &command[offset];
+            list[n].rx_buf = NULL;
+            list[n].len = transfer[i].len + 1;
+            list[n].cs_change = 1;
+            offset += transfer[i].len + 1;
+            n += 1;
+        }
+    }
+    
+    return spi_transfer(fd, list, n);
+}
+
 /**
  * @brief  interface spi bus init
  * @return status code
@@ -169,6 +277,42 @@ uint8_t bmp384_interface_spi_write(uint8_t reg, uint8_t *buf, uint16_t len)
     return spi_write(gs_spi_fd, reg, buf, len);
 }
 
+/**
+ * @brief      interface spi bus read without the dummy byte copy
+ * @param[in]  reg register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       sends reg and one dummy byte, then reads len bytes straight into buf
+ */
+uint8_t bmp384_interface_spi_read_direct(uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t command[2];
+    
+    command[0] = reg;
+    command[1] = 0x00;
+    
+    return spi_write_read(gs_spi_fd, command, 2, buf, len);
+}
+
+/**
+ * @brief     interface spi bus transfer
+ * @param[in] *transfer pointer to a transfer array
+ * @param[in] num transfer number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      runs all transfers in one bus call with one chip select each,
+ *            a read sends reg and one dummy byte, then reads len bytes straight into buf,
+ *            num is at most BMP384_TRANSFER_MAX_NUM
+ */
+uint8_t bmp384_interface_spi_transfer(bmp384_transfer_t *transfer, uint16_t num)
+{
+    return a_bmp384_interface_spi_transfer(gs_spi_fd, transfer, num);
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
@@ -232,3 +376,221 @@ void bmp384_interface_receive_callback(uint8_t type)
         }
     }
 }
+
+/**
+ * @brief     interface iic bus init with context
+ * @param[in] *ctx pointer to an interface context
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic init failed
+ * @note      none
+ */
+uint8_t bmp384_interface_iic_init_ctx(void *ctx)
+{
+    bmp384_interface_context_t *context = (bmp384_interface_context_t *)ctx;
+    
+    return iic_init(context->name, &context->fd);
+}
+
+/**
+ * @brief     interface iic bus deinit with context
+ * @param[in] *ctx pointer to an interface context
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic deinit failed
+ * @note      none
+ */
+uint8_t bmp384_interface_iic_deinit_ctx(void *ctx)
+{
+    return iic_deinit(((bmp384_interface_context_t *)ctx)->fd);
+}
+
+/**
+ * @brief      interface iic bus read with context
+ * @param[in]  *ctx pointer to an interface context
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t bmp384_interface_iic_read_ctx(void *ctx, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return iic_read(((bmp384_interface_context_t *)ctx)->fd, addr, reg, buf, len);
+}
+
+/**
+ * @brief     interface iic bus write with context
+ * @param[in] *ctx pointer to an interface context
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t bmp384_interface_iic_write_ctx(void *ctx, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return iic_write(((bmp384_interface_context_t *)ctx)->fd, addr, reg, buf, len);
+}
+
+/**
+ * @brief     interface iic bus transfer with context
+ * @param[in] *ctx pointer to an interface context
+ * @param[in] addr iic device write address
+ * @param[in] *transfer pointer to a transfer array
+ * @param[in] num transfer number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      runs all transfers in one bus transaction with repeated starts,
+ *            num is at most BMP384_TRANSFER_MAX_NUM
+ */
+uint8_t bmp384_interface_iic_transfer_ctx(void *ctx, uint8_t addr, bmp384_transfer_t *transfer, uint16_t num)
+{
+    uint16_t i;
+    iic_transfer_t list[BMP384_TRANSFER_MAX_NUM];
+    
+    /* check the transfer number */
+    if ((num == 0) || (num > BMP384_TRANSFER_MAX_NUM))
+    {
+        return 1;
+    }
+    
+    for (i = 0; i < num; i++)
+    {
+        list[i].reg = transfer[i].reg;
+        list[i].read = transfer[i].read;
+        list[i].buf = transfer[i].buf;
+        list[i].len = transfer[i].len;
+    }
+    
+    return iic_transfer(((bmp384_interface_context_t *)ctx)->fd, addr, list, num);
+}
+
+/**
+ * @brief     interface spi bus init with context
+ * @param[in] *ctx pointer to an interface context
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi init failed
+ * @note      none
+ */
+uint8_t bmp384_interface_spi_init_ctx(void *ctx)
+{
+    bmp384_interface_context_t *context = (bmp384_interface_context_t *)ctx;
+    
+    return spi_init(context->name, &context->fd, SPI_MODE_TYPE_3, 1000 * 1000);
+}
+
+/**
+ * @brief     interface spi bus deinit with context
+ * @param[in] *ctx pointer to an interface context
+ * @return    status code
+ *            - 0 success
+ *            - 1 spi deinit failed
+ * @note      none
+ */
+uint8_t bmp384_interface_spi_deinit_ctx(void *ctx)
+{
+    return spi_deinit(((bmp384_interface_context_t *)ctx)->fd);
+}
+
+/**
+ * @brief      interface spi bus read with context
+ * @param[in]  *ctx pointer to an interface context
+ * @param[in]  reg register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t bmp384_interface_spi_read_ctx(void *ctx, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return spi_read(((bmp384_interface_context_t *)ctx)->fd, reg, buf, len);
+}
+
+/**
+ * @brief     interface spi bus write with context
+ * @param[in] *ctx pointer to an interface context
+ * @param[in] reg register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t bmp384_interface_spi_write_ctx(void *ctx, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return spi_write(((bmp384_interface_context_t *)ctx)->fd, reg, buf, len);
+}
+
+/**
+ * @brief      interface spi bus read without the dummy byte copy with context
+ * @param[in]  *ctx pointer to an interface context
+ * @param[in]  reg register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       sends reg and one dummy byte, then reads len bytes straight into buf
+ */
+uint8_t bmp384_interface_spi_read_direct_ctx(void *ctx, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t command[2];
+    
+    command[0] = reg;
+    command[1] = 0x00;
+    
+    return spi_write_read(((bmp384_interface_context_t *)ctx)->fd, command, 2, buf, len);
+}
+
+/**
+ * @brief     interface spi bus transfer with context
+ * @param[in] *ctx pointer to an interface context
+ * @param[in] *transfer pointer to a transfer array
+ * @param[in] num transfer number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      runs all transfers in one bus call with one chip select each,
+ *            a read sends reg and one dummy byte, then reads len bytes straight into buf,
+ *            num is at most BMP384_TRANSFER_MAX_NUM
+ */
+uint8_t bmp384_interface_spi_transfer_ctx(void *ctx, bmp384_transfer_t *transfer, uint16_t num)
+{
+    return a_bmp384_interface_spi_transfer(((bmp384_interface_context_t *)ctx)->fd, transfer, num);
+}
+
+/**
+ * @brief     interface delay ms with context
+ * @param[in] *ctx pointer to an interface context
+ * @param[in] ms time
+ * @note      none
+ */
+void bmp384_interface_delay_ms_ctx(void *ctx, uint32_t ms)
+{
+    (void)ctx;
+    usleep(1000 * ms);
+}
+
+/**
+ * @brief     interface receive callback with context
+ * @param[in] *ctx pointer to an interface context
+ * @param[in] type interrupt type
+ * @note      none
+ */
+void bmp384_interface_receive_callback_ctx(void *ctx, uint8_t type)
+{
+    (void)ctx;
+    bmp384_interface_receive_callback(type);
+}
@@ -53,6 +53,27 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief iic transfer max message number definition
+ */
+#define IIC_TRANSFER_MAX_MSGS 42        /**< kernel I2C_RDWR_IOCTL_MAX_MSGS */
+
+/**
+ * @brief iic transfer max write length definition
+ */
+#define IIC_TRANSFER_MAX_LENGTH 256     /**< register and data bytes of all writes in one transfer */
+
+/**
+ * @brief iic transfer structure definition
+ */
+typedef struct iic_transfer_s
+{
+    uint8_t reg;          /**< register address */
+    uint8_t read;         /**< 1 read, 0 write */
+    uint8_t *buf;         /**< data buffer */
+    uint16_t len;         /**< data length */
+} iic_transfer_t;
+
 /**
  * @brief      iic bus init
  * @param[in]  *name pointer to an iic device name buffer
@@ -156,6 +177,22 @@ uint8_t iic_write(int fd, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
  */
 uint8_t iic_write_address16(int fd, uint8_t addr, uint16_t reg, uint8_t *buf, uint16_t len);
 
+/**
+ * @brief     iic bus transfer
+ * @param[in] fd iic handle
+ * @param[in] addr iic device write address
+ * @param[in] *transfer pointer to a transfer array
+ * @param[in] num transfer number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      addr = device_address_7bits << 1,
+ *            all transfers are sent in one I2C_RDWR ioctl with repeated starts,
+ *            a read takes two messages and a write takes one, up to IIC_TRANSFER_MAX_MSGS in total,
+ *            the writes take len + 1 bytes each, up to IIC_TRANSFER_MAX_LENGTH in total
+ */
+uint8_t iic_transfer(int fd, uint8_t addr, iic_transfer_t *transfer, uint16_t num);
+
 /**
  * @}
  */
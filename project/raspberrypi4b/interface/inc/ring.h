@@ -0,0 +1,127 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      ring.h
+ * @brief     ring header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef RING_H
+#define RING_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup ring ring function
+ * @brief    single producer single consumer ring function modules
+ * @{
+ */
+
+/**
+ * @brief ring structure definition
+ */
+typedef struct ring_s
+{
+    uint8_t *buf;                /**< slot buffer */
+    uint32_t size;               /**< slot size */
+    uint32_t mask;               /**< slot count - 1 */
+    uint32_t head;               /**< write index, owned by the producer */
+    uint32_t tail;               /**< read index, owned by the consumer */
+    uint32_t overflow;           /**< dropped slot count */
+    uint32_t high_water;         /**< max used slot count */
+} ring_t;
+
+/**
+ * @brief     ring init
+ * @param[in] *ring pointer to a ring structure
+ * @param[in] *buf pointer to a slot buffer
+ * @param[in] size slot size
+ * @param[in] count slot count
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      count must be a power of two,
+ *            buf must hold size * count bytes
+ */
+uint8_t ring_init(ring_t *ring, void *buf, uint32_t size, uint32_t count);
+
+/**
+ * @brief     ring write
+ * @param[in] *ring pointer to a ring structure
+ * @param[in] *data pointer to a slot data buffer
+ * @param[in] len slot data length
+ * @return    written slot count
+ * @note      producer only,
+ *            slots that do not fit are dropped and counted as overflow
+ */
+uint32_t ring_write(ring_t *ring, const void *data, uint32_t len);
+
+/**
+ * @brief      ring peek
+ * @param[in]  *ring pointer to a ring structure
+ * @param[out] **data pointer to a slot pointer buffer
+ * @return     contiguous readable slot count
+ * @note       consumer only,
+ *             the slots stay valid in place until ring_release
+ */
+uint32_t ring_peek(ring_t *ring, void **data);
+
+/**
+ * @brief     ring release
+ * @param[in] *ring pointer to a ring structure
+ * @param[in] len released slot count
+ * @note      consumer only,
+ *            len must not exceed the count returned by ring_peek
+ */
+void ring_release(ring_t *ring, uint32_t len);
+
+/**
+ * @brief      ring get the overflow counters
+ * @param[in]  *ring pointer to a ring structure
+ * @param[out] *overflow pointer to a dropped slot count buffer
+ * @param[out] *high_water pointer to a max used slot count buffer
+ * @note       safe to call from any thread
+ */
+void ring_get_overflow(ring_t *ring, uint32_t *overflow, uint32_t *high_water);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
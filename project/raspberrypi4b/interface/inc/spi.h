@@ -65,6 +65,22 @@ typedef enum
     SPI_MODE_TYPE_3 = SPI_MODE_3,        /**< mode 3 */
 } spi_mode_type_t;
 
+/**
+ * @brief spi transfer max segment number definition
+ */
+#define SPI_TRANSFER_MAX_NUM 32        /**< max spi_ioc_transfer segments of one message */
+
+/**
+ * @brief spi transfer structure definition
+ */
+typedef struct spi_transfer_s
+{
+    uint8_t *tx_buf;          /**< tx buffer, NULL sends zeros */
+    uint8_t *rx_buf;          /**< rx buffer, NULL drops the data */
+    uint32_t len;             /**< segment length */
+    uint8_t cs_change;        /**< 1 releases the chip select after this segment */
+} spi_transfer_t;
+
 /**
  * @brief      spi bus init
  * @param[in]  *name pointer to a spi device name buffer
@@ -191,6 +207,20 @@ uint8_t spi_write_read(int fd, uint8_t *in_buf, uint32_t in_len, uint8_t *out_bu
  */
 uint8_t spi_transmit(int fd, uint8_t *tx, uint8_t *rx, uint16_t len);
 
+/**
+ * @brief     spi bus transfer
+ * @param[in] fd spi handle
+ * @param[in] *transfer pointer to a transfer array
+ * @param[in] num transfer number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      all segments are sent in one SPI_IOC_MESSAGE ioctl, up to SPI_TRANSFER_MAX_NUM,
+ *            the chip select is held between segments unless cs_change is set,
+ *            the last segment always releases it and the total length must fit the spidev bufsiz
+ */
+uint8_t spi_transfer(int fd, spi_transfer_t *transfer, uint16_t num);
+
 /**
  * @}
  */
@@ -363,3 +363,101 @@ uint8_t iic_write_address16(int fd, uint8_t addr, uint16_t reg, uint8_t *buf, ui
      
     return 0;
 }
+
+/**
+ * @brief     iic bus transfer
+ * @param[in] fd iic handle
+ * @param[in] addr iic device write address
+ * @param[in] *transfer pointer to a transfer array
+ * @param[in] num transfer number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      addr = device_address_7bits << 1,
+ *            all transfers are sent in one I2C_RDWR ioctl with repeated starts,
+ *            a read takes two messages and a write takes one, up to IIC_TRANSFER_MAX_MSGS in total,
+ *            the writes take len + 1 bytes each, up to IIC_TRANSFER_MAX_LENGTH in total
+ */
+uint8_t iic_transfer(int fd, uint8_t addr, iic_transfer_t *transfer, uint16_t num)
+{
+    struct i2c_rdwr_ioctl_data i2c_rdwr_data;
+    struct i2c_msg msgs[IIC_TRANSFER_MAX_MSGS];
+    uint8_t buf_send[IIC_TRANSFER_MAX_LENGTH];
+    uint32_t n;
+    uint32_t total;
+    uint32_t offset;
+    uint16_t i;
+    
+    /* get the message number and the write length */
+    n = 0;
+    total = 0;
+    for (i = 0; i < num; i++)
+    {
+        n += (transfer[i].read != 0) ? 2 : 1;
+        total += (transfer[i].read != 0) ? 0 : (transfer[i].len + 1);
+    }
+    
+    /* check the message number */
+    if ((n == 0) || (n > IIC_TRANSFER_MAX_MSGS))
+    {
+        perror("iic: transfer number is invalid.\n");
+        
+        return 1;
+    }
+    
+    /* check the write length */
+    if (total > IIC_TRANSFER_MAX_LENGTH)
+    {
+        perror("iic: transfer length is too long.\n");
+        
+        return 1;
+    }
+    
+    /* clear ioctl data */
+    memset(&i2c_rdwr_data, 0, sizeof(struct i2c_rdwr_ioctl_data));
+    
+    /* clear msgs data */
+    memset(msgs, 0, sizeof(struct i2c_msg) * n);
+    
+    /* set the param */
+    n = 0;
+    offset = 0;
+    for (i = 0; i < num; i++)
+    {
+        if (transfer[i].read != 0)
+        {
+            msgs[n].addr = addr >> 1;
+            msgs[n].flags = 0;
+            msgs[n].buf = &transfer[i].reg;
+            msgs[n].len = 1;
+            msgs[n + 1].addr = addr >> 1;
+            msgs[n + 1].flags = I2C_M_RD;
+            msgs[n + 1].buf = transfer[i].buf;
+            msgs[n + 1].len = transfer[i].len;
+            n += 2;
+        }
+        else
+        {
+            buf_send[offset] = transfer[i].reg;
+            memcpy(&buf_send[offset + 1], transfer[i].buf, transfer[i].len);
+            msgs[n].addr = addr >> 1;
+            msgs[n].flags = 0;
+            msgs[n].buf = &buf_send[offset];
+            msgs[n].len = transfer[i].len + 1;
+            offset += transfer[i].len + 1;
+            n += 1;
+        }
+    }
+    i2c_rdwr_data.msgs = msgs;
+    i2c_rdwr_data.nmsgs = n;
+    
+    /* transmit */
+    if (ioctl(fd, I2C_RDWR, &i2c_rdwr_data) < 0)
+    {
+        perror("iic: transfer failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
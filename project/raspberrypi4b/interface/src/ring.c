@@ -0,0 +1,219 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      ring.c
+ * @brief     ring source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "ring.h"
+#include <string.h>
+
+/**
+ * @brief     ring init
+ * @param[in] *ring pointer to a ring structure
+ * @param[in] *buf pointer to a slot buffer
+ * @param[in] size slot size
+ * @param[in] count slot count
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      count must be a power of two,
+ *            buf must hold size * count bytes
+ */
+uint8_t ring_init(ring_t *ring, void *buf, uint32_t size, uint32_t count)
+{
+    /* check the args */
+    if ((ring == NULL) || (buf == NULL) || (size == 0))
+    {
+        /* return error */
+        return 1;
+    }
+    /* check the power of two */
+    if ((count == 0) || ((count & (count - 1)) != 0))
+    {
+        /* return error */
+        return 1;
+    }
+    
+    /* set the buffer */
+    ring->buf = (uint8_t *)buf;
+    /* set the slot size */
+    ring->size = size;
+    /* set the mask */
+    ring->mask = count - 1;
+    /* clear the head */
+    __atomic_store_n(&ring->head, 0, __ATOMIC_RELAXED);
+    /* clear the tail */
+    __atomic_store_n(&ring->tail, 0, __ATOMIC_RELAXED);
+    /* clear the overflow */
+    __atomic_store_n(&ring->overflow, 0, __ATOMIC_RELAXED);
+    /* clear the high water */
+    __atomic_store_n(&ring->high_water, 0, __ATOMIC_RELEASE);
+    
+    /* success return 0 */
+    return 0;
+}
+
+/**
+ * @brief     ring write
+ * @param[in] *ring pointer to a ring structure
+ * @param[in] *data pointer to a slot data buffer
+ * @param[in] len slot data length
+ * @return    written slot count
+ * @note      producer only,
+ *            slots that do not fit are dropped and counted as overflow
+ */
+uint32_t ring_write(ring_t *ring, const void *data, uint32_t len)
+{
+    uint32_t head;
+    uint32_t tail;
+    uint32_t used;
+    uint32_t n;
+    uint32_t first;
+    uint32_t offset;
+    
+    /* only the producer writes head */
+    head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    /* pairs with the consumer release */
+    tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    /* get the used slots */
+    used = head - tail;
+    /* get the free slots */
+    n = ring->mask + 1 - used;
+    /* check the length */
+    if (len < n)
+    {
+        /* write all */
+        n = len;
+    }
+    else
+    {
+        /* count the dropped slots */
+        __atomic_fetch_add(&ring->overflow, len - n, __ATOMIC_RELAXED);
+    }
+    
+    /* get the write offset */
+    offset = head & ring->mask;
+    /* get the slots before the end */
+    first = ring->mask + 1 - offset;
+    /* check the wrap */
+    if (first > n)
+    {
+        /* no wrap */
+        first = n;
+    }
+    /* copy the first part */
+    memcpy(ring->buf + offset * ring->size, data, first * ring->size);
+    
+    /* copy the wrapped part */
+    memcpy(ring->buf, (const uint8_t *)data + first * ring->size, (n - first) * ring->size);
+    
+    /* publish the slots */
+    __atomic_store_n(&ring->head, head + n, __ATOMIC_RELEASE);
+    
+    /* get the new used slots */
+    used += n;
+    /* check the high water */
+    if (used > __atomic_load_n(&ring->high_water, __ATOMIC_RELAXED))
+    {
+        /* set the high water */
+        __atomic_store_n(&ring->high_water, used, __ATOMIC_RELAXED);
+    }
+    
+    /* return the written slots */
+    return n;
+}
+
+/**
+ * @brief      ring peek
+ * @param[in]  *ring pointer to a ring structure
+ * @param[out] **data pointer to a slot pointer buffer
+ * @return     contiguous readable slot count
+ * @note       consumer only,
+ *             the slots stay valid in place until ring_release
+ */
+uint32_t ring_peek(ring_t *ring, void **data)
+{
+    uint32_t head;
+    uint32_t tail;
+    uint32_t n;
+    uint32_t offset;
+    
+    /* only the consumer writes tail */
+    tail = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+    /* pairs with the producer release */
+    head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    /* get the used slots */
+    n = head - tail;
+    /* get the read offset */
+    offset = tail & ring->mask;
+    /* check the wrap */
+    if (n > ring->mask + 1 - offset)
+    {
+        /* stop at the end */
+        n = ring->mask + 1 - offset;
+    }
+    *data = ring->buf + offset * ring->size;                                 /* set the slot pointer */
+    
+    /* return the readable slots */
+    return n;
+}
+
+/**
+ * @brief     ring release
+ * @param[in] *ring pointer to a ring structure
+ * @param[in] len released slot count
+ * @note      consumer only,
+ *            len must not exceed the count returned by ring_peek
+ */
+void ring_release(ring_t *ring, uint32_t len)
+{
+    uint32_t tail;
+    
+    /* only the consumer writes tail */
+    tail = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+    /* hand the slots back */
+    __atomic_store_n(&ring->tail, tail + len, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief      ring get the overflow counters
+ * @param[in]  *ring pointer to a ring structure
+ * @param[out] *overflow pointer to a dropped slot count buffer
+ * @param[out] *high_water pointer to a max used slot count buffer
+ * @note       safe to call from any thread
+ */
+void ring_get_overflow(ring_t *ring, uint32_t *overflow, uint32_t *high_water)
+{
+    *overflow = __atomic_load_n(&ring->overflow, __ATOMIC_RELAXED);          /* get the overflow */
+    *high_water = __atomic_load_n(&ring->high_water, __ATOMIC_RELAXED);      /* get the high water */
+}
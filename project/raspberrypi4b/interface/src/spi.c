@@ -512,3 +512,56 @@ uint8_t spi_transmit(int fd, uint8_t *tx, uint8_t *rx, uint16_t len)
     
     return 0;
 }
+
+/**
+ * @brief     spi bus transfer
+ * @param[in] fd spi handle
+ * @param[in] *transfer pointer to a transfer array
+ * @param[in] num transfer number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      all segments are sent in one SPI_IOC_MESSAGE ioctl, up to SPI_TRANSFER_MAX_NUM,
+ *            the chip select is held between segments unless cs_change is set,
+ *            the last segment always releases it and the total length must fit the spidev bufsiz
+ */
+uint8_t spi_transfer(int fd, spi_transfer_t *transfer, uint16_t num)
+{
+    struct spi_ioc_transfer k[SPI_TRANSFER_MAX_NUM];
+    uint32_t total;
+    uint16_t i;
+    int l;
+    
+    /* check the transfer number */
+    if ((num == 0) || (num > SPI_TRANSFER_MAX_NUM))
+    {
+        perror("spi: transfer number is invalid.\n");
+        
+        return 1;
+    }
+    
+    /* clear ioc transfer */
+    memset(k, 0, sizeof(struct spi_ioc_transfer) * num);
+    
+    /* set the param */
+    total = 0;
+    for (i = 0; i < num; i++)
+    {
+        k[i].tx_buf = (unsigned long)transfer[i].tx_buf;
+        k[i].rx_buf = (unsigned long)transfer[i].rx_buf;
+        k[i].len = transfer[i].len;
+        k[i].cs_change = (i == (num - 1)) ? 0 : transfer[i].cs_change;
+        total += transfer[i].len;
+    }
+    
+    /* transmit */
+    l = ioctl(fd, SPI_IOC_MESSAGE(num), k);
+    if (l != (int)total)
+    {
+        perror("spi: length check error.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
@@ -42,7 +42,9 @@
 #include "driver_bmp384_read_test.h"
 #include "driver_bmp384_interrupt_test.h"
 #include "driver_bmp384_fifo_test.h"
+#include "driver_bmp384_compensation_test.h"
 #include "gpio.h"
+#include "ring.h"
 #include <getopt.h>
 #include <stdlib.h>
 
@@ -54,8 +56,10 @@ static float gs_temperature_c;                      /**< temperature data */
 static float gs_pressure_pa;                        /**< pressure data */
 static volatile uint8_t gs_fifo_full_flag;          /**< fifo full flag */
 static volatile uint8_t gs_fifo_watermark_flag;     /**< fifo watermark flag */
-static uint8_t gs_buf[512];                         /**< buffer */
-static bmp384_frame_t gs_frame[256];                /**< frame buffer */
+static uint8_t gs_buf[516];                         /**< buffer */
+static bmp384_sample_t gs_sample[256];              /**< irq thread sample buffer */
+static bmp384_sample_t gs_ring_buf[1024];           /**< ring slot buffer */
+static ring_t gs_ring;                              /**< irq thread to main thread sample ring */
 uint8_t (*g_gpio_irq)(void) = NULL;                 /**< irq function address */
 
 /**
@@ -96,94 +100,26 @@ void bmp384_interface_interrupt_receive_callback(uint8_t type)
 }
 
 /**
- * @brief     interface fifo receive callback
+ * @brief     interface fifo receive data callback
  * @param[in] type interrupt type
- * @note      none
+ * @param[in] *sample pointer to a sample buffer
+ * @param[in] len sample length
+ * @note      runs in the gpio irq thread, the only ring producer
  */
-void bmp384_interface_fifo_receive_callback(uint8_t type)
+void bmp384_interface_fifo_receive_data_callback(uint8_t type, bmp384_sample_t *sample, uint16_t len)
 {
     switch (type)
     {
         case BMP384_INTERRUPT_STATUS_FIFO_WATERMARK :
         {
-            uint8_t res;
-            uint16_t len;
-            uint16_t i, frame_len;
-            
-            len = 512;
-            frame_len = 256;
-            res = bmp384_fifo_read(gs_buf, len, (bmp384_frame_t *)gs_frame, (uint16_t *)&frame_len);
-            if (res != 0)
-            {
-                bmp384_interface_debug_print("bmp384: fifo read failed.\n");
-                
-                return;
-            }
-            for (i = 0; i < frame_len; i++)
-            {
-                if (gs_frame[i].type == BMP384_FRAME_TYPE_TEMPERATURE)
-                {
-                    bmp384_interface_debug_print("bmp384: fifo %d/%d.\n", i + 1, frame_len);
-                    bmp384_interface_debug_print("bmp384: temperature is %0.2fC.\n", gs_frame[i].data);
-                }
-                else if (gs_frame[i].type == BMP384_FRAME_TYPE_PRESSURE)
-                {
-                    bmp384_interface_debug_print("bmp384: fifo %d/%d.\n", i + 1, frame_len);
-                    bmp384_interface_debug_print("bmp384: pressure is %0.2fPa.\n", gs_frame[i].data);
-                }
-                else if (gs_frame[i].type == BMP384_FRAME_TYPE_SENSORTIME)
-                {
-                    bmp384_interface_debug_print("bmp384: fifo %d/%d.\n", i + 1, frame_len);
-                    bmp384_interface_debug_print("bmp384: sensor time is %d.\n", gs_frame[i].raw);
-                }
-                else
-                {
-                    bmp384_interface_debug_print("bmp384: fifo %d/%d.\n", i + 1, frame_len);
-                    bmp384_interface_debug_print("bmp384: unknown type.\n");
-                }
-            }
+            (void)ring_write(&gs_ring, sample, len);
             gs_fifo_watermark_flag = 1;
             
             break;
         }
         case BMP384_INTERRUPT_STATUS_FIFO_FULL :
         {
-            uint8_t res;
-            uint16_t len;
-            uint16_t i, frame_len;
-            
-            len = 512;
-            frame_len = 256;
-            res = bmp384_fifo_read(gs_buf, len, (bmp384_frame_t *)gs_frame, (uint16_t *)&frame_len);
-            if (res != 0)
-            {
-                bmp384_interface_debug_print("bmp384: fifo read failed.\n");
-                
-                return;
-            }
-            for (i = 0; i < frame_len; i++)
-            {
-                if (gs_frame[i].type == BMP384_FRAME_TYPE_TEMPERATURE)
-                {
-                    bmp384_interface_debug_print("bmp384: fifo %d/%d.\n", i + 1, frame_len);
-                    bmp384_interface_debug_print("bmp384: temperature is %0.2fC.\n", gs_frame[i].data);
-                }
-                else if (gs_frame[i].type == BMP384_FRAME_TYPE_PRESSURE)
-                {
-                    bmp384_interface_debug_print("bmp384: fifo %d/%d.\n", i + 1, frame_len);
-                    bmp384_interface_debug_print("bmp384: pressure is %0.2fPa.\n", gs_frame[i].data);
-                }
-                else if (gs_frame[i].type == BMP384_FRAME_TYPE_SENSORTIME)
-                {
-                    bmp384_interface_debug_print("bmp384: fifo %d/%d.\n", i + 1, frame_len);
-                    bmp384_interface_debug_print("bmp384: sensor time is %d.\n", gs_frame[i].raw);
-                }
-                else
-                {
-                    bmp384_interface_debug_print("bmp384: fifo %d/%d.\n", i + 1, frame_len);
-                    bmp384_interface_debug_print("bmp384: unknown type.\n");
-                }
-            }
+            (void)ring_write(&gs_ring, sample, len);
             gs_fifo_full_flag = 1;
             
             break;
@@ -199,6 +135,18 @@ void bmp384_interface_fifo_receive_callback(uint8_t type)
     }
 }
 
+/**
+ * @brief  fifo irq handler
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   reads the interrupt status and the fifo in one pass
+ */
+static uint8_t a_fifo_irq_handler(void)
+{
+    return bmp384_fifo_irq_handler_read(gs_buf, 516, gs_sample, 256);
+}
+
 /**
  * @brief     bmp384 full function
  * @param[in] argc arg numbers
@@ -379,6 +327,21 @@ uint8_t bmp384(uint8_t argc, char **argv)
             return 0;
         }
     }
+    else if (strcmp("t_comp", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the compensation test */
+        res = bmp384_compensation_test(interface, addr);
+        if (res != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
     else if (strcmp("t_read", type) == 0)
     {
         uint8_t res;
@@ -607,11 +570,18 @@ uint8_t bmp384(uint8_t argc, char **argv)
     else if (strcmp("e_fifo", type) == 0)
     {
         uint8_t res;
-        uint32_t i;
+        uint32_t i, j;
+        uint32_t n;
         uint32_t timeout;
+        uint32_t overflow;
+        uint32_t high_water;
+        bmp384_sample_t *sample;
 
+        /* ring init */
+        (void)ring_init(&gs_ring, gs_ring_buf, sizeof(bmp384_sample_t), 1024);
+        
         /* set the gpio irq */
-        g_gpio_irq = bmp384_fifo_irq_handler;
+        g_gpio_irq = a_fifo_irq_handler;
         res = gpio_interrupt_init();
         if (res != 0)
         {
@@ -619,7 +589,7 @@ uint8_t bmp384(uint8_t argc, char **argv)
         }
         
         /* fifo init */
-        res = bmp384_fifo_init(interface, addr, bmp384_interface_fifo_receive_callback);
+        res = bmp384_fifo_init(interface, addr, NULL);
         if (res != 0)
         {
             g_gpio_irq = NULL;
@@ -628,6 +598,9 @@ uint8_t bmp384(uint8_t argc, char **argv)
             return 1;
         }
         
+        /* link the fifo receive data callback */
+        (void)bmp384_fifo_link_receive_data_callback(bmp384_interface_fifo_receive_data_callback);
+        
         /* param init */
         gs_fifo_watermark_flag = 0;
         gs_fifo_full_flag = 0;
@@ -660,11 +633,25 @@ uint8_t bmp384(uint8_t argc, char **argv)
                 }
             }
             
+            /* consume the samples in place */
+            while ((n = ring_peek(&gs_ring, (void **)&sample)) != 0)
+            {
+                for (j = 0; j < n; j++)
+                {
+                    bmp384_interface_debug_print("bmp384: sample %u temperature is %0.2fC pressure is %0.2fPa.\n",
+                                                 (unsigned int)sample[j].index, (float)sample[j].temperature / 100.0f, 
+                                                 (float)sample[j].pressure / 100.0f);
+                }
+                ring_release(&gs_ring, n);
+            }
+            
             /* param init */
             gs_fifo_watermark_flag = 0;
             gs_fifo_full_flag = 0;
             timeout = 5000;
         }
+        ring_get_overflow(&gs_ring, &overflow, &high_water);
+        bmp384_interface_debug_print("bmp384: ring overflow %d high water %d.\n", overflow, high_water);
         bmp384_interface_debug_print("bmp384: finish fifo read.\n");
         
         /* gpio deinit */
@@ -698,7 +685,7 @@ uint8_t bmp384(uint8_t argc, char **argv)
         bmp384_interface_debug_print("  -i, --information                  Show the chip information.\n");
         bmp384_interface_debug_print("      --interface=<iic | spi>        Set the chip interface.([default: iic])\n");
         bmp384_interface_debug_print("  -p, --port                         Display the pin connections of the current board.\n");
-        bmp384_interface_debug_print("  -t <reg | read | int | fifo>, --test=<reg | read | int | fifo>\n");
+        bmp384_interface_debug_print("  -t <reg | read | int | fifo | comp>, --test=<reg | read | int | fifo | comp>\n");
         bmp384_interface_debug_print("                                     Run the driver test.\n");
         bmp384_interface_debug_print("      --times=<num>                  Set the running times.([default: 3])\n");
         
@@ -719,6 +706,7 @@ uint8_t bmp384(uint8_t argc, char **argv)
         bmp384_interface_debug_print("bmp384: max current is %0.2fmA.\n", info.max_current_ma);
         bmp384_interface_debug_print("bmp384: max temperature is %0.1fC.\n", info.temperature_max);
         bmp384_interface_debug_print("bmp384: min temperature is %0.1fC.\n", info.temperature_min);
+        bmp384_interface_debug_print("bmp384: handle size is %d bytes.\n", (int)sizeof(bmp384_handle_t));
         
         return 0;
     }
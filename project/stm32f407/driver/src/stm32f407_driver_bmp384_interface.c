@@ -97,6 +97,40 @@ uint8_t bmp384_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint
     return iic_write(addr, reg, buf, len);
 }
 
+/**
+ * @brief     interface iic bus transfer
+ * @param[in] addr iic device write address
+ * @param[in] *transfer pointer to a transfer array
+ * @param[in] num transfer number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      the hal has no vectored transfer, so the transfers run one by one
+ */
+uint8_t bmp384_interface_iic_transfer(uint8_t addr, bmp384_transfer_t *transfer, uint16_t num)
+{
+    uint16_t i;
+    uint8_t res;
+    
+    for (i = 0; i < num; i++)
+    {
+        if (transfer[i].read != 0)
+        {
+            res = iic_read(addr, transfer[i].reg, transfer[i].buf, transfer[i].len);
+        }
+        else
+        {
+            res = iic_write(addr, transfer[i].reg, transfer[i].buf, transfer[i].len);
+        }
+        if (res != 0)
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
 /**
  * @brief  interface spi bus init
  * @return status code
@@ -151,6 +185,64 @@ uint8_t bmp384_interface_spi_write(uint8_t reg, uint8_t *buf, uint16_t len)
     return spi_write(reg, buf, len);
 }
 
+/**
+ * @brief      interface spi bus read without the dummy byte copy
+ * @param[in]  reg register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       sends reg and one dummy byte, then reads len bytes straight into buf
+ */
+uint8_t bmp384_interface_spi_read_direct(uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t command[2];
+    
+    command[0] = reg;
+    command[1] = 0x00;
+    
+    return spi_write_read(command, 2, buf, len);
+}
+
+/**
+ * @brief     interface spi bus transfer
+ * @param[in] *transfer pointer to a transfer array
+ * @param[in] num transfer number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      the hal has no vectored transfer, so the transfers run one by one with one chip select each,
+ *            a read sends reg and one dummy byte, then reads len bytes straight into buf,
+ *            num is at most BMP384_TRANSFER_MAX_NUM
+ */
+uint8_t bmp384_interface_spi_transfer(bmp384_transfer_t *transfer, uint16_t num)
+{
+    uint16_t i;
+    uint8_t res;
+    uint8_t command[2];
+    
+    for (i = 0; i < num; i++)
+    {
+        if (transfer[i].read != 0)
+        {
+            command[0] = transfer[i].reg;
+            command[1] = 0x00;
+            res = spi_write_read(command, 2, transfer[i].buf, transfer[i].len);
+        }
+        else
+        {
+            res = spi_write(transfer[i].reg, transfer[i].buf, transfer[i].len);
+        }
+        if (res != 0)
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
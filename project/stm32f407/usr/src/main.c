@@ -42,6 +42,7 @@
 #include "driver_bmp384_read_test.h"
 #include "driver_bmp384_interrupt_test.h"
 #include "driver_bmp384_fifo_test.h"
+#include "driver_bmp384_compensation_test.h"
 #include "clock.h"
 #include "delay.h"
 #include "uart.h"
@@ -410,6 +411,21 @@ uint8_t bmp384(uint8_t argc, char **argv)
             return 0;
         }
     }
+    else if (strcmp("t_comp", type) == 0)
+    {
+        uint8_t res;
+        
+        /* run the compensation test */
+        res = bmp384_compensation_test(interface, addr);
+        if (res != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
     else if (strcmp("t_read", type) == 0)
     {
         uint8_t res;
@@ -729,7 +745,7 @@ uint8_t bmp384(uint8_t argc, char **argv)
         bmp384_interface_debug_print("  -i, --information                  Show the chip information.\n");
         bmp384_interface_debug_print("      --interface=<iic | spi>        Set the chip interface.([default: iic])\n");
         bmp384_interface_debug_print("  -p, --port                         Display the pin connections of the current board.\n");
-        bmp384_interface_debug_print("  -t <reg | read | int | fifo>, --test=<reg | read | int | fifo>\n");
+        bmp384_interface_debug_print("  -t <reg | read | int | fifo | comp>, --test=<reg | read | int | fifo | comp>\n");
         bmp384_interface_debug_print("                                     Run the driver test.\n");
         bmp384_interface_debug_print("      --times=<num>                  Set the running times.([default: 3])\n");
         
@@ -750,6 +766,7 @@ uint8_t bmp384(uint8_t argc, char **argv)
         bmp384_interface_debug_print("bmp384: max current is %0.2fmA.\n", info.max_current_ma);
         bmp384_interface_debug_print("bmp384: max temperature is %0.1fC.\n", info.temperature_max);
         bmp384_interface_debug_print("bmp384: min temperature is %0.1fC.\n", info.temperature_min);
+        bmp384_interface_debug_print("bmp384: handle size is %d bytes.\n", (int)sizeof(bmp384_handle_t));
         
         return 0;
     }
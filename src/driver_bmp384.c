@@ -36,6 +36,14 @@
 
 #include "driver_bmp384.h"
 
+#if (BMP384_COMPENSATE_BATCH_SIMD == 1) && defined(__AVX2__)
+#include <immintrin.h>
+#elif (BMP384_COMPENSATE_BATCH_SIMD == 1) && defined(__SSE4_1__)
+#include <smmintrin.h>
+#elif (BMP384_COMPENSATE_BATCH_SIMD == 1) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 /**
  * @brief chip information definition
  */
@@ -101,6 +109,120 @@
 #define BMP384_REG_ERR_REG             0x02        /**< error register */
 #define BMP384_REG_CHIP_ID             0x00        /**< chip id register */
 
+/**
+ * @brief burst write max length definition
+ */
+#define BMP384_BURST_WRITE_MAX_LENGTH  11          /**< max register number of one burst write */
+
+/**
+ * @brief calibration data length definition
+ */
+#define BMP384_CALIBRATION_DATA_LENGTH 21          /**< NVM PAR T1 low register to NVM PAR P11 register */
+
+/**
+ * @brief calibration snapshot definition
+ */
+#define BMP384_CALIBRATION_SNAPSHOT_VERSION 0x01     /**< calibration snapshot version */
+
+/**
+ * @brief register shadow definition
+ */
+#define BMP384_SHADOW_LENGTH           11          /**< fifo watermark 0 register to configure register */
+
+/**
+ * @brief fifo sensor time period definition
+ */
+#define BMP384_FIFO_SENSORTIME_PERIOD  128         /**< sensor time ticks of one 200Hz sample */
+
+/**
+ * @brief sensor time tick definition
+ */
+#define BMP384_SENSORTIME_TICK_NS      39062.5     /**< nominal sensor time tick in ns */
+
+/**
+ * @brief register shadow reset value definition
+ */
+static const uint8_t gs_bmp384_shadow_reset[BMP384_SHADOW_LENGTH] =
+{
+    0x01, 0x00, 0x02, 0x02, 0x02, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+};
+
+/**
+ * @brief     update the register shadow
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @param[in] reg register address
+ * @param[in] data written data
+ * @note      none
+ */
+static void a_bmp384_shadow_update(bmp384_handle_t *handle, uint8_t reg, uint8_t data)
+{
+    if ((reg >= BMP384_REG_FIFO_WTM_0) && (reg <= BMP384_REG_CONFIG))                 /* check config range */
+    {
+        if (reg == BMP384_REG_PWR_CTRL)                                               /* power control register */
+        {
+            if ((((data >> 4) & 0x03) == 0x01) || (((data >> 4) & 0x03) == 0x02))    /* forced mode */
+            {
+                data &= ~(3 << 4);                                                    /* back to sleep mode */
+            }
+        }
+        handle->shadow[reg - BMP384_REG_FIFO_WTM_0] = data;                           /* save data */
+    }
+    else if ((reg == BMP384_REG_CMD) && (data == 0xB6))                               /* soft reset */
+    {
+        memcpy(handle->shadow, gs_bmp384_shadow_reset, BMP384_SHADOW_LENGTH);         /* reset shadow */
+    }
+    else
+    {
+        
+    }
+}
+
+/**
+ * @brief     update the driver state after a register write
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @param[in] reg written register address
+ * @param[in] data written data
+ * @note      none
+ */
+static void a_bmp384_register_written(bmp384_handle_t *handle, uint8_t reg, uint8_t data)
+{
+    if ((reg == BMP384_REG_PWR_CTRL) || (reg == BMP384_REG_CMD) || 
+        (reg == BMP384_REG_FIFO_CONFIG_1))                                            /* mode may be changed */
+    {
+        handle->stream_enable = 0;                                                    /* stop the stream */
+    }
+    if ((reg == BMP384_REG_ODR) || (reg == BMP384_REG_FIFO_CONFIG_2) || 
+        (reg == BMP384_REG_CMD))                                                      /* fifo period may be changed */
+    {
+        handle->fifo_period_valid = 0;                                                /* read the period again */
+    }
+    a_bmp384_shadow_update(handle, reg, data);                                        /* update the register shadow */
+}
+
+/**
+ * @brief      read from the register shadow
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[in]  reg register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data length
+ * @return     status code
+ *             - 0 success
+ *             - 1 not in the register shadow
+ * @note       none
+ */
+static uint8_t a_bmp384_shadow_read(bmp384_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    if ((handle->shadow_enable != 0) && (reg >= BMP384_REG_FIFO_WTM_0) && 
+        ((uint16_t)(reg + len) <= (BMP384_REG_CONFIG + 1)))                           /* in the register shadow */
+    {
+        memcpy(buf, &handle->shadow[reg - BMP384_REG_FIFO_WTM_0], len);               /* copy data */
+        
+        return 0;                                                                     /* success return 0 */
+    }
+    
+    return 1;                                                                         /* return error */
+}
+
 /**
  * @brief      read multiple bytes
  * @param[in]  *handle pointer to a bmp384 handle structure
@@ -110,13 +232,24 @@
  * @return     status code
  *             - 0 success
  *             - 1 iic spi read failed
- * @note       none
+ * @note       spi reads longer than the scratch or inner buffer are split into chunks with one chip select each,
+ *             the fifo data chunks keep the fifo data address
  */
 static uint8_t a_bmp384_iic_spi_read(bmp384_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
 {
+    uint16_t n;
+    uint16_t chunk;
+    uint8_t *scratch;
+    
+    if (a_bmp384_shadow_read(handle, reg, buf, len) == 0)                             /* read the register shadow */
+    {
+        return 0;                                                                     /* success return 0 */
+    }
     if (handle->iic_spi == BMP384_INTERFACE_IIC)                                      /* iic interface */
     {
-        if (handle->iic_read(handle->iic_addr, reg, buf, len) != 0)                   /* iic read */
+        if (((handle->transport != NULL) ? 
+             handle->transport->iic_read(handle->ctx, handle->iic_addr, reg, buf, len) : 
+             handle->iic_read(handle->iic_addr, reg, buf, len)) != 0)                 /* iic read */
         {
             return 1;                                                                 /* return error */
         }
@@ -128,1136 +261,1452 @@ static uint8_t a_bmp384_iic_spi_read(bmp384_handle_t *handle, uint8_t reg, uint8
     else                                                                              /* spi interface */
     {
         reg |= 1 << 7;                                                                /* set read mode */
-        if (handle->spi_read(reg, handle->buf, 
-                             len > 512 ? (512 + 1) : (len + 1)) != 0)                 /* spi read */
+        if ((handle->transport != NULL) ? (handle->transport->spi_read_direct != NULL) : 
+            (handle->spi_read_direct != NULL))                                        /* direct read is linked */
+        {
+            if (((handle->transport != NULL) ? 
+                 handle->transport->spi_read_direct(handle->ctx, reg, buf, len) : 
+                 handle->spi_read_direct(reg, buf, len)) != 0)                        /* spi read into buf */
+            {
+                return 1;                                                             /* return error */
+            }
+            
+            return 0;                                                                 /* success return 0 */
+        }
+        if ((handle->scratch != NULL) && (handle->scratch_len > 1))                   /* caller scratch buffer */
+        {
+            scratch = handle->scratch;                                                /* set scratch */
+            chunk = (uint16_t)(handle->scratch_len - 1);                              /* set chunk length */
+        }
+        else
         {
+#if (BMP384_SPI_BUFFER_LENGTH > 0)
+            scratch = handle->buf;                                                    /* set inner buffer */
+            chunk = BMP384_SPI_BUFFER_LENGTH;                                         /* set chunk length */
+#else
             return 1;                                                                 /* return error */
+#endif
         }
-        memcpy(buf, handle->buf+1, (len > 512) ? 512 : len);                          /* copy data */
-        
-        return 0;                                                                     /* success return 0 */
-    }
-}
-
-/**
- * @brief     write multiple bytes
- * @param[in] *handle pointer to a bmp384 handle structure
- * @param[in] reg register address
- * @param[in] *buf pointer to a data buffer
- * @param[in] len data length
- * @return    status code
- *            - 0 success
- *            - 1 iic spi write failed
- * @note      none
- */
-static uint8_t a_bmp384_iic_spi_write(bmp384_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
-{
-    if (handle->iic_spi == BMP384_INTERFACE_IIC)                             /* iic interface */
-    {
-        uint16_t i;
-        
-        for (i = 0; i < len; i++)                                            /* write data one byte by one byte */
+        while (len != 0)                                                              /* read all chunks */
         {
-            if (handle->iic_write(handle->iic_addr, 
-                                  (uint8_t)(reg + i), buf + i, 1) != 0)      /* iic write */
+            n = (len > chunk) ? chunk : len;                                          /* get the chunk length */
+            if (((handle->transport != NULL) ? 
+                 handle->transport->spi_read(handle->ctx, reg, scratch, n + 1) : 
+                 handle->spi_read(reg, scratch, n + 1)) != 0)                         /* spi read one chunk */
             {
-                return 1;                                                    /* return error */
+                return 1;                                                             /* return error */
             }
-        }
-        
-        return 0;                                                            /* success return 0 */
-    }
-    else
-    {
-        uint16_t i;
-        
-        reg &= ~(1 << 7);                                                    /* write mode */
-        for (i = 0; i < len; i++)                                            /* write data one byte by one byte */
-        {
-            if (handle->spi_write((uint8_t)(reg + i), buf + i, 1) != 0)      /* spi write */
+            memcpy(buf, scratch + 1, n);                                              /* copy data */
+            buf += n;                                                                 /* next buffer */
+            len -= n;                                                                 /* remaining length */
+            if ((reg & 0x7F) != BMP384_REG_FIFO_DATA)                                 /* fifo data keeps the address */
             {
-                return 1;                                                    /* return error */
+                reg = (uint8_t)(reg + n);                                             /* next register */
             }
         }
         
-        return 0;                                                            /* success return 0 */
+        return 0;                                                                     /* success return 0 */
     }
 }
 
 /**
- * @brief     get the calibration data
+ * @brief     burst write registers
  * @param[in] *handle pointer to a bmp384 handle structure
+ * @param[in] *reg pointer to a register address buffer
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len register number
  * @return    status code
  *            - 0 success
- *            - 1 get calibration data failed
- * @note      none
+ *            - 1 iic spi burst write failed
+ * @note      1 <= len <= BMP384_BURST_WRITE_MAX_LENGTH
  */
-static uint8_t a_bmp384_get_calibration_data(bmp384_handle_t *handle)
+static uint8_t a_bmp384_iic_spi_burst_write(bmp384_handle_t *handle, const uint8_t *reg, const uint8_t *buf, uint8_t len)
 {
-    uint8_t buf[2];
+    uint8_t i;
+    uint8_t data[BMP384_BURST_WRITE_MAX_LENGTH * 2 - 1];
     
-    if (a_bmp384_iic_spi_read(handle, BMP384_REG_NVM_PAR_T1_L, (uint8_t *)buf, 2) != 0)  /* read t1 */
-    {
-        handle->debug_print("bmp384: get calibration data failed.\n");                   /* get calibration data failed */
-       
-        return 1;                                                                        /* return error */
-    }
-    handle->t1 = (uint16_t)buf[1] << 8 | buf[0];                                         /* set t1 */
-    if (a_bmp384_iic_spi_read(handle, BMP384_REG_NVM_PAR_T2_L, (uint8_t *)buf, 2) != 0)  /* read t2 */
+    if ((len == 0) || (len > BMP384_BURST_WRITE_MAX_LENGTH))                  /* check length */
     {
-        handle->debug_print("bmp384: get calibration data failed.\n");                   /* get calibration data failed */
-       
-        return 1;                                                                        /* return error */
+        return 1;                                                             /* return error */
     }
-    handle->t2 = (uint16_t)buf[1] << 8 | buf[0];                                         /* set t2 */
-    if (a_bmp384_iic_spi_read(handle, BMP384_REG_NVM_PAR_T3, (uint8_t *)buf, 1) != 0)    /* read t3 */
+    data[0] = buf[0];                                                         /* set the first data */
+    for (i = 1; i < len; i++)                                                 /* interleave the address and data */
     {
-        handle->debug_print("bmp384: get calibration data failed.\n");                   /* get calibration data failed */
-       
-        return 1;                                                                        /* return error */
+        data[i * 2 - 1] = reg[i];                                             /* set address */
+        data[i * 2] = buf[i];                                                 /* set data */
     }
-    handle->t3 = (int8_t)(buf[0]);                                                       /* set t3 */
-    if (a_bmp384_iic_spi_read(handle, BMP384_REG_NVM_PAR_P1_L, (uint8_t *)buf, 2) != 0)  /* read p1 */
+    if (handle->iic_spi == BMP384_INTERFACE_IIC)                              /* iic interface */
     {
-        handle->debug_print("bmp384: get calibration data failed.\n");                   /* get calibration data failed */
-       
-        return 1;                                                                        /* return error */
+        if (((handle->transport != NULL) ? 
+             handle->transport->iic_write(handle->ctx, handle->iic_addr, reg[0], data, 
+                                          (uint16_t)(len * 2 - 1)) : 
+             handle->iic_write(handle->iic_addr, reg[0], data, 
+                               (uint16_t)(len * 2 - 1))) != 0)                /* iic write */
+        {
+            handle->shadow_enable = 0;                                        /* shadow is unknown */
+            handle->fifo_period_valid = 0;                                    /* fifo period is unknown */
+            
+            return 1;                                                         /* return error */
+        }
     }
-    handle->p1 = (int16_t)((uint16_t)buf[1] << 8 | buf[0]);                              /* set p1 */
-    if (a_bmp384_iic_spi_read(handle, BMP384_REG_NVM_PAR_P2_L, (uint8_t *)buf, 2) != 0)  /* read p2 */
+    else                                                                      /* spi interface */
     {
-        handle->debug_print("bmp384: get calibration data failed.\n");                   /* get calibration data failed */
-       
-        return 1;                                                                        /* return error */
+        for (i = 1; i < len; i++)                                             /* set all addresses */
+        {
+            data[i * 2 - 1] &= ~(1 << 7);                                     /* write mode */
+        }
+        if (((handle->transport != NULL) ? 
+             handle->transport->spi_write(handle->ctx, (uint8_t)(reg[0] & ~(1 << 7)), data, 
+                                          (uint16_t)(len * 2 - 1)) : 
+             handle->spi_write((uint8_t)(reg[0] & ~(1 << 7)), data, 
+                               (uint16_t)(len * 2 - 1))) != 0)                /* spi write */
+        {
+            handle->shadow_enable = 0;                                        /* shadow is unknown */
+            handle->fifo_period_valid = 0;                                    /* fifo period is unknown */
+            
+            return 1;                                                         /* return error */
+        }
     }
-    handle->p2 = (int16_t)((uint16_t)buf[1] << 8 | buf[0]);                              /* set p2 */
-    if (a_bmp384_iic_spi_read(handle, BMP384_REG_NVM_PAR_P3, (uint8_t *)buf, 1) != 0)    /* read p3 */
+    for (i = 0; i < len; i++)                                                 /* update all registers */
     {
-        handle->debug_print("bmp384: get calibration data failed.\n");                   /* get calibration data failed */
-       
-        return 1;                                                                        /* return error */
+        a_bmp384_register_written(handle, reg[i], buf[i]);                    /* update the written register */
     }
-    handle->p3 = (int8_t)(buf[0]);                                                       /* set p3 */
-    if (a_bmp384_iic_spi_read(handle, BMP384_REG_NVM_PAR_P4, (uint8_t *)buf, 1) != 0)    /* read p4 */
+    
+    return 0;                                                                 /* success return 0 */
+}
+
+/**
+ * @brief     delay through the linked function
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @param[in] ms delay time
+ * @note      none
+ */
+static void a_bmp384_delay_ms(bmp384_handle_t *handle, uint32_t ms)
+{
+    if (handle->transport != NULL)                                          /* context transport */
     {
-        handle->debug_print("bmp384: get calibration data failed.\n");                   /* get calibration data failed */
-       
-        return 1;                                                                        /* return error */
+        handle->transport->delay_ms(handle->ctx, ms);                       /* delay with context */
     }
-    handle->p4 = (int8_t)(buf[0]);                                                       /* set p4 */
-    if (a_bmp384_iic_spi_read(handle, BMP384_REG_NVM_PAR_P5_L, (uint8_t *)buf, 2) != 0)  /* read p5 */
+    else
     {
-        handle->debug_print("bmp384: get calibration data failed.\n");                   /* get calibration data failed */
-       
-        return 1;                                                                        /* return error */
+        handle->delay_ms(ms);                                               /* delay */
     }
-    handle->p5 = (uint16_t)buf[1] << 8 | buf[0];                                         /* set p5 */
-    if (a_bmp384_iic_spi_read(handle, BMP384_REG_NVM_PAR_P6_L, (uint8_t *)buf, 2) != 0)  /* read p6l */
+}
+
+/**
+ * @brief     run the linked receive callback
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @param[in] type interrupt type
+ * @note      a NULL callback is skipped
+ */
+static void a_bmp384_receive_callback(bmp384_handle_t *handle, uint8_t type)
+{
+    if (handle->transport != NULL)                                          /* context transport */
     {
-        handle->debug_print("bmp384: get calibration data failed.\n");                   /* get calibration data failed */
-       
-        return 1;                                                                        /* return error */
+        if (handle->transport->receive_callback != NULL)                    /* if receive callback is valid */
+        {
+            handle->transport->receive_callback(handle->ctx, type);         /* run receive callback with context */
+        }
     }
-    handle->p6 = (uint16_t)buf[1] << 8 | buf[0];                                         /* set p6 */
-    if (a_bmp384_iic_spi_read(handle, BMP384_REG_NVM_PAR_P7, (uint8_t *)buf, 1) != 0)    /* read p7 */
+    else if (handle->receive_callback != NULL)                              /* if receive callback is valid */
     {
-        handle->debug_print("bmp384: get calibration data failed.\n");                   /* get calibration data failed */
-       
-        return 1;                                                                        /* return error */
+        handle->receive_callback(type);                                     /* run receive callback */
     }
-    handle->p7 = (int8_t)(buf[0]);                                                       /* set p7 */
-    if (a_bmp384_iic_spi_read(handle, BMP384_REG_NVM_PAR_P8, (uint8_t *)buf, 1) != 0)    /* read p8 */
+    else
     {
-        handle->debug_print("bmp384: get calibration data failed.\n");                   /* get calibration data failed */
-       
-        return 1;                                                                        /* return error */
+        
     }
-    handle->p8 = (int8_t)(buf[0]);                                                       /* set p8 */
-    if (a_bmp384_iic_spi_read(handle, BMP384_REG_NVM_PAR_P9_L, (uint8_t *)buf, 2) != 0)  /* read p9l */
+}
+
+/**
+ * @brief     run the linked receive data callback
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @param[in] type interrupt type
+ * @param[in] *sample pointer to a sample buffer
+ * @param[in] len sample length
+ * @note      a NULL callback is skipped
+ */
+static void a_bmp384_receive_data_callback(bmp384_handle_t *handle, uint8_t type, bmp384_sample_t *sample, uint16_t len)
+{
+    if (handle->transport != NULL)                                                     /* context transport */
     {
-        handle->debug_print("bmp384: get calibration data failed.\n");                   /* get calibration data failed */
-       
-        return 1;                                                                        /* return error */
+        if (handle->transport->receive_data_callback != NULL)                          /* if receive data callback is valid */
+        {
+            handle->transport->receive_data_callback(handle->ctx, type, sample, len);  /* run receive data callback with context */
+        }
     }
-    handle->p9 = (int16_t)((uint16_t)buf[1] << 8 | buf[0]);                              /* set p9 */
-    if (a_bmp384_iic_spi_read(handle, BMP384_REG_NVM_PAR_P10, (uint8_t *)buf, 1) != 0)   /* read p10 */
+    else if (handle->receive_data_callback != NULL)                                    /* if receive data callback is valid */
     {
-        handle->debug_print("bmp384: get calibration data failed.\n");                   /* get calibration data failed */
-       
-        return 1;                                                                        /* return error */
+        handle->receive_data_callback(type, sample, len);                              /* run receive data callback */
     }
-    handle->p10 = (int8_t)(buf[0]);                                                      /* set p10 */
-    if (a_bmp384_iic_spi_read(handle, BMP384_REG_NVM_PAR_P11, (uint8_t *)buf, 1) != 0)   /* read p11 */
+    else
     {
-        handle->debug_print("bmp384: get calibration data failed.\n");                   /* get calibration data failed */
-       
-        return 1;                                                                        /* return error */
+        
     }
-    handle->p11 = (int8_t)(buf[0]);                                                      /* set p11 */
-
-    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief     compensate the temperature
+ * @brief     write multiple bytes
  * @param[in] *handle pointer to a bmp384 handle structure
- * @param[in] data raw temperature
- * @return    compensated temperature
+ * @param[in] reg register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic spi write failed
  * @note      none
  */
-static int64_t a_bmp384_compensate_temperature(bmp384_handle_t *handle, uint32_t data)
-{ 
-    uint64_t partial_data1;
-    uint64_t partial_data2;
-    uint64_t partial_data3;
-    int64_t partial_data4;
-    int64_t partial_data5;
-    int64_t partial_data6;
-    int64_t comp_temp;
-
-    /* calculate compensate temperature */
-    partial_data1 = (uint64_t)(data - (256 * (uint64_t)(handle->t1)));
-    partial_data2 = (uint64_t)(handle->t2 * partial_data1);
-    partial_data3 = (uint64_t)(partial_data1 * partial_data1);
-    partial_data4 = (int64_t)(((int64_t)partial_data3) * ((int64_t)handle->t3));
-    partial_data5 = ((int64_t)(((int64_t)partial_data2) * 262144) + (int64_t)partial_data4);
-    partial_data6 = (int64_t)(((int64_t)partial_data5) / 4294967296U);
-    handle->t_fine = partial_data6;
-    comp_temp = (int64_t)((partial_data6 * 25)  / 16384);
+static uint8_t a_bmp384_iic_spi_write(bmp384_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t i;
+    uint8_t n;
+    uint8_t addr[BMP384_BURST_WRITE_MAX_LENGTH];
     
-    return comp_temp;
+    while (len != 0)                                                         /* write all data */
+    {
+        n = (len > BMP384_BURST_WRITE_MAX_LENGTH) ? 
+             BMP384_BURST_WRITE_MAX_LENGTH : (uint8_t)len;                   /* get the burst length */
+        for (i = 0; i < n; i++)                                              /* set the register addresses */
+        {
+            addr[i] = (uint8_t)(reg + i);                                    /* set address */
+        }
+        if (a_bmp384_iic_spi_burst_write(handle, addr, buf, n) != 0)         /* burst write */
+        {
+            return 1;                                                        /* return error */
+        }
+        reg = (uint8_t)(reg + n);                                            /* next register */
+        buf += n;                                                            /* next data */
+        len -= n;                                                            /* update length */
+    }
+    
+    return 0;                                                                /* success return 0 */
 }
 
 /**
- * @brief     compensate the pressure
+ * @brief     run several register transfers
  * @param[in] *handle pointer to a bmp384 handle structure
- * @param[in] data raw pressure
- * @return    compensated pressure
- * @note      none
+ * @param[in] *transfer pointer to a transfer array
+ * @param[in] num transfer number
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic spi transfer failed
+ * @note      1 <= num <= BMP384_TRANSFER_MAX_NUM and each write is one register,
+ *            reads in the register shadow are served locally,
+ *            the rest go to iic_transfer or spi_transfer in one call when it is linked, or one by one otherwise
  */
-static int64_t a_bmp384_compensate_pressure(bmp384_handle_t *handle, uint32_t data)
-{
-    int64_t partial_data1;
-    int64_t partial_data2;
-    int64_t partial_data3;
-    int64_t partial_data4;
-    int64_t partial_data5;
-    int64_t partial_data6;
-    int64_t offset;
-    int64_t sensitivity;
-    uint64_t comp_press;
-
-    /* calculate compensate pressure */
-    partial_data1 = handle->t_fine * handle->t_fine;
-    partial_data2 = partial_data1 / 64;
-    partial_data3 = (partial_data2 * handle->t_fine) / 256;
-    partial_data4 = (handle->p8 * partial_data3) / 32;
-    partial_data5 = (handle->p7 * partial_data1) * 16;
-    partial_data6 = (handle->p6 * handle->t_fine) * 4194304;
-    offset = (int64_t)((int64_t)(handle->p5) * (int64_t)140737488355328U) + partial_data4 + partial_data5 + partial_data6;
-    partial_data2 = (((int64_t)handle->p4) * partial_data3) / 32;
-    partial_data4 = (handle->p3 * partial_data1) * 4;
-    partial_data5 = ((int64_t)(handle->p2) - 16384) * ((int64_t)handle->t_fine) * 2097152;
-    sensitivity = (((int64_t)(handle->p1) - 16384) * (int64_t)70368744177664U) + partial_data2 + partial_data4 + partial_data5;
-    partial_data1 = (sensitivity / 16777216) * data;
-    partial_data2 = (int64_t)(handle->p10) * (int64_t)(handle->t_fine);
-    partial_data3 = partial_data2 + (65536 * (int64_t)(handle->p9));
-    partial_data4 = (partial_data3 * data) / 8192;
-    partial_data5 = (partial_data4 * data) / 512;
-    partial_data6 = (int64_t)((uint64_t)data * (uint64_t)data);
-    partial_data2 = ((int64_t)(handle->p11) * (int64_t)(partial_data6)) / 65536;
-    partial_data3 = (partial_data2 * data) / 128;
-    partial_data4 = (offset / 4) + partial_data1 + partial_data5 + partial_data3;
-    comp_press = (((uint64_t)partial_data4 * 25) / (uint64_t)1099511627776U);
-    
-    return comp_press;
-}
-
-/**
- * @brief      get the error
- * @param[in]  *handle pointer to a bmp384 handle structure
- * @param[out] *err pointer to an error buffer
- * @return     status code
- *             - 0 success
- *             - 1 get error failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
- */
-uint8_t bmp384_get_error(bmp384_handle_t *handle, uint8_t *err)
+static uint8_t a_bmp384_iic_spi_transfer(bmp384_handle_t *handle, bmp384_transfer_t *transfer, uint8_t num)
 {
+    uint8_t i;
+    uint8_t n;
     uint8_t res;
+    uint8_t linked;
+    bmp384_transfer_t list[BMP384_TRANSFER_MAX_NUM];
     
-    if (handle == NULL)                                                               /* check handle */
+    if (handle->iic_spi == BMP384_INTERFACE_IIC)                                     /* iic interface */
     {
-        return 2;                                                                     /* return error */
+        linked = (handle->transport != NULL) ? (handle->transport->iic_transfer != NULL) : 
+                                               (handle->iic_transfer != NULL);       /* check iic transfer */
     }
-    if (handle->inited != 1)                                                          /* check handle initialization */
+    else                                                                             /* spi interface */
     {
-        return 3;                                                                     /* return error */
+        linked = (handle->transport != NULL) ? (handle->transport->spi_transfer != NULL) : 
+                                               (handle->spi_transfer != NULL);       /* check spi transfer */
     }
-    
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_ERR_REG, (uint8_t *)err, 1);       /* read config */
-    if (res != 0)                                                                     /* check result */
+    if (linked == 0)                                                                 /* no vectored transfer */
     {
-        handle->debug_print("bmp384: get error register failed.\n");                  /* get error register failed */
-       
-        return 1;                                                                     /* return error */
+        for (i = 0; i < num; i++)                                                    /* run all transfers */
+        {
+            if (transfer[i].read != 0)                                               /* read */
+            {
+                res = a_bmp384_iic_spi_read(handle, transfer[i].reg, 
+                                            transfer[i].buf, transfer[i].len);       /* read registers */
+            }
+            else
+            {
+                res = a_bmp384_iic_spi_write(handle, transfer[i].reg, 
+                                             transfer[i].buf, transfer[i].len);      /* write registers */
+            }
+            if (res != 0)                                                            /* check result */
+            {
+                return 1;                                                            /* return error */
+            }
+        }
+        
+        return 0;                                                                    /* success return 0 */
     }
-
-    return 0;                                                                         /* success return 0 */
-}
-
-/**
- * @brief      get the status
- * @param[in]  *handle pointer to a bmp384 handle structure
- * @param[out] *status pointer to a status buffer
- * @return     status code
- *             - 0 success
- *             - 1 get status failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
- */
-uint8_t bmp384_get_status(bmp384_handle_t *handle, uint8_t *status)
-{
-    uint8_t res;
     
-    if (handle == NULL)                                                                 /* check handle */
+    n = 0;                                                                           /* init 0 */
+    for (i = 0; i < num; i++)                                                        /* build the bus list */
     {
-        return 2;                                                                       /* return error */
+        if ((transfer[i].read != 0) && 
+            (a_bmp384_shadow_read(handle, transfer[i].reg, 
+                                  transfer[i].buf, transfer[i].len) == 0))           /* served by the shadow */
+        {
+            continue;                                                                /* skip */
+        }
+        list[n] = transfer[i];                                                       /* copy transfer */
+        if (handle->iic_spi == BMP384_INTERFACE_SPI)                                 /* spi interface */
+        {
+            if (list[n].read != 0)                                                   /* read */
+            {
+                list[n].reg |= 1 << 7;                                               /* set read mode */
+            }
+            else
+            {
+                list[n].reg &= ~(1 << 7);                                            /* set write mode */
+            }
+        }
+        n++;                                                                         /* next */
     }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    if (n == 0)                                                                      /* all served */
     {
-        return 3;                                                                       /* return error */
+        return 0;                                                                    /* success return 0 */
     }
-    
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_STATUS, (uint8_t *)status, 1);       /* read status */
-    if (res != 0)                                                                       /* check result */
+    if (handle->iic_spi == BMP384_INTERFACE_IIC)                                     /* iic interface */
     {
-        handle->debug_print("bmp384: get status register failed.\n");                   /* get status register failed */
-       
-        return 1;                                                                       /* return error */
+        res = (handle->transport != NULL) ? 
+               handle->transport->iic_transfer(handle->ctx, handle->iic_addr, list, n) : 
+               handle->iic_transfer(handle->iic_addr, list, n);                      /* iic transfer */
     }
-
-    return 0;                                                                           /* success return 0 */
-}
-
-/**
- * @brief      get the sensor time
- * @param[in]  *handle pointer to a bmp384 handle structure
- * @param[out] *t pointer to a timestamp buffer
- * @return     status code
- *             - 0 success
- *             - 1 get sensor time failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
- */
-uint8_t bmp384_get_sensortime(bmp384_handle_t *handle, uint32_t *t)
-{
-    uint8_t res;
-    uint8_t buf[3];
-    
-    if (handle == NULL)                                                                    /* check handle */
+    else                                                                             /* spi interface */
     {
-        return 2;                                                                          /* return error */
+        res = (handle->transport != NULL) ? 
+               handle->transport->spi_transfer(handle->ctx, list, n) : 
+               handle->spi_transfer(list, n);                                        /* spi transfer */
     }
-    if (handle->inited != 1)                                                               /* check handle initialization */
+    if (res != 0)                                                                    /* check result */
     {
-        return 3;                                                                          /* return error */
+        for (i = 0; i < n; i++)                                                      /* check all transfers */
+        {
+            if (list[i].read == 0)                                                   /* a write may be lost */
+            {
+                handle->shadow_enable = 0;                                           /* shadow is unknown */
+                handle->fifo_period_valid = 0;                                       /* fifo period is unknown */
+            }
+        }
+        
+        return 1;                                                                    /* return error */
     }
-    
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_SENSORTIME_0, (uint8_t *)buf, 3);       /* read config */
-    if (res != 0)                                                                          /* check result */
+    for (i = 0; i < n; i++)                                                          /* update all writes */
     {
-        handle->debug_print("bmp384: get sensor time register failed.\n");                 /* get sensor time register failed */
-       
-        return 1;                                                                          /* return error */
+        if (list[i].read == 0)                                                       /* write */
+        {
+            a_bmp384_register_written(handle, list[i].reg, list[i].buf[0]);          /* update the written register */
+        }
     }
-    *t = (uint32_t)buf[2] << 16 | (uint32_t)buf[1] << 8 | buf[0];                          /* get time */
     
-    return 0;                                                                              /* success return 0 */
+    return 0;                                                                        /* success return 0 */
 }
 
 /**
- * @brief      get the event
- * @param[in]  *handle pointer to a bmp384 handle structure
- * @param[out] *event pointer to an event buffer
- * @return     status code
- *             - 0 success
- *             - 1 get event failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     decode the calibration data
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @param[in] *buf pointer to a calibration data buffer
+ * @note      buf length must be BMP384_CALIBRATION_DATA_LENGTH
  */
-uint8_t bmp384_get_event(bmp384_handle_t *handle, bmp384_event_t *event)
+static void a_bmp384_decode_calibration_data(bmp384_handle_t *handle, const uint8_t *buf)
 {
-    uint8_t res;
-    uint8_t prev;
-    
-    if (handle == NULL)                                                               /* check handle */
-    {
-        return 2;                                                                     /* return error */
-    }
-    if (handle->inited != 1)                                                          /* check handle initialization */
-    {
-        return 3;                                                                     /* return error */
-    }
-    
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_EVENT, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                     /* check result */
-    {
-        handle->debug_print("bmp384: get event register failed.\n");                  /* get event register failed */
-       
-        return 1;                                                                     /* return error */
-    }
-    *event = (bmp384_event_t)(prev & (1 << 0));                                       /* get event */
-
-    return 0;                                                                         /* success return 0 */
+    handle->calibration.t1 = (uint16_t)buf[1] << 8 | buf[0];                             /* set t1 */
+    handle->calibration.t2 = (uint16_t)buf[3] << 8 | buf[2];                             /* set t2 */
+    handle->calibration.t3 = (int8_t)(buf[4]);                                           /* set t3 */
+    handle->calibration.p1 = (int16_t)((uint16_t)buf[6] << 8 | buf[5]);                  /* set p1 */
+    handle->calibration.p2 = (int16_t)((uint16_t)buf[8] << 8 | buf[7]);                  /* set p2 */
+    handle->calibration.p3 = (int8_t)(buf[9]);                                           /* set p3 */
+    handle->calibration.p4 = (int8_t)(buf[10]);                                          /* set p4 */
+    handle->calibration.p5 = (uint16_t)buf[12] << 8 | buf[11];                           /* set p5 */
+    handle->calibration.p6 = (uint16_t)buf[14] << 8 | buf[13];                           /* set p6 */
+    handle->calibration.p7 = (int8_t)(buf[15]);                                          /* set p7 */
+    handle->calibration.p8 = (int8_t)(buf[16]);                                          /* set p8 */
+    handle->calibration.p9 = (int16_t)((uint16_t)buf[18] << 8 | buf[17]);                /* set p9 */
+    handle->calibration.p10 = (int8_t)(buf[19]);                                         /* set p10 */
+    handle->calibration.p11 = (int8_t)(buf[20]);                                         /* set p11 */
+    handle->pressure_terms_valid = 0;                                                    /* invalidate the pressure terms */
 }
 
 /**
- * @brief      get the interrupt status
+ * @brief      encode the calibration data
  * @param[in]  *handle pointer to a bmp384 handle structure
- * @param[out] *status pointer to a status buffer
- * @return     status code
- *             - 0 success
- *             - 1 get interrupt status failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @param[out] *buf pointer to a calibration data buffer
+ * @note       buf length must be BMP384_CALIBRATION_DATA_LENGTH
  */
-uint8_t bmp384_get_interrupt_status(bmp384_handle_t *handle, uint8_t *status)
+static void a_bmp384_encode_calibration_data(bmp384_handle_t *handle, uint8_t *buf)
 {
-    uint8_t res;
-    
-    if (handle == NULL)                                                                     /* check handle */
-    {
-        return 2;                                                                           /* return error */
-    }
-    if (handle->inited != 1)                                                                /* check handle initialization */
-    {
-        return 3;                                                                           /* return error */
-    }
-    
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_INT_STATUS, (uint8_t *)status, 1);       /* read status */
-    if (res != 0)                                                                           /* check result */
-    {
-        handle->debug_print("bmp384: get interrupt status register failed.\n");             /* get interrupt status register failed */
-       
-        return 1;                                                                           /* return error */
-    }
-
-    return 0;                                                                               /* success return 0 */
+    buf[0] = (uint8_t)(handle->calibration.t1 & 0xFF);                                   /* set t1 low */
+    buf[1] = (uint8_t)((handle->calibration.t1 >> 8) & 0xFF);                            /* set t1 high */
+    buf[2] = (uint8_t)(handle->calibration.t2 & 0xFF);                                   /* set t2 low */
+    buf[3] = (uint8_t)((handle->calibration.t2 >> 8) & 0xFF);                            /* set t2 high */
+    buf[4] = (uint8_t)(handle->calibration.t3);                                          /* set t3 */
+    buf[5] = (uint8_t)((uint16_t)handle->calibration.p1 & 0xFF);                         /* set p1 low */
+    buf[6] = (uint8_t)(((uint16_t)handle->calibration.p1 >> 8) & 0xFF);                  /* set p1 high */
+    buf[7] = (uint8_t)((uint16_t)handle->calibration.p2 & 0xFF);                         /* set p2 low */
+    buf[8] = (uint8_t)(((uint16_t)handle->calibration.p2 >> 8) & 0xFF);                  /* set p2 high */
+    buf[9] = (uint8_t)(handle->calibration.p3);                                          /* set p3 */
+    buf[10] = (uint8_t)(handle->calibration.p4);                                         /* set p4 */
+    buf[11] = (uint8_t)(handle->calibration.p5 & 0xFF);                                  /* set p5 low */
+    buf[12] = (uint8_t)((handle->calibration.p5 >> 8) & 0xFF);                           /* set p5 high */
+    buf[13] = (uint8_t)(handle->calibration.p6 & 0xFF);                                  /* set p6 low */
+    buf[14] = (uint8_t)((handle->calibration.p6 >> 8) & 0xFF);                           /* set p6 high */
+    buf[15] = (uint8_t)(handle->calibration.p7);                                         /* set p7 */
+    buf[16] = (uint8_t)(handle->calibration.p8);                                         /* set p8 */
+    buf[17] = (uint8_t)((uint16_t)handle->calibration.p9 & 0xFF);                        /* set p9 low */
+    buf[18] = (uint8_t)(((uint16_t)handle->calibration.p9 >> 8) & 0xFF);                 /* set p9 high */
+    buf[19] = (uint8_t)(handle->calibration.p10);                                        /* set p10 */
+    buf[20] = (uint8_t)(handle->calibration.p11);                                        /* set p11 */
 }
 
 /**
- * @brief      get the fifo length
- * @param[in]  *handle pointer to a bmp384 handle structure
- * @param[out] *length pointer to a fifo length buffer
- * @return     status code
- *             - 0 success
- *             - 1 get fifo length failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     calculate the crc16
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    crc16 ccitt
+ * @note      none
  */
-uint8_t bmp384_get_fifo_length(bmp384_handle_t *handle, uint16_t *length)
+static uint16_t a_bmp384_crc16(const uint8_t *buf, uint16_t len)
 {
-    uint8_t res;
-    uint8_t buf[2];
-    
-    if (handle == NULL)                                                                     /* check handle */
-    {
-        return 2;                                                                           /* return error */
-    }
-    if (handle->inited != 1)                                                                /* check handle initialization */
-    {
-        return 3;                                                                           /* return error */
-    }
+    uint16_t i;
+    uint8_t j;
+    uint16_t crc;
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_LENGTH_0, (uint8_t *)buf, 2);       /* read config */
-    if (res != 0)                                                                           /* check result */
+    crc = 0xFFFF;                                                                        /* init crc */
+    for (i = 0; i < len; i++)                                                            /* run all data */
     {
-        handle->debug_print("bmp384: get fifo length register failed.\n");                  /* get fifo length register failed */
-       
-        return 1;                                                                           /* return error */
+        crc ^= (uint16_t)((uint16_t)buf[i] << 8);                                        /* xor data */
+        for (j = 0; j < 8; j++)                                                          /* run 8 bits */
+        {
+            if ((crc & 0x8000) != 0)                                                     /* check msb */
+            {
+                crc = (uint16_t)((crc << 1) ^ 0x1021);                                   /* xor poly */
+            }
+            else
+            {
+                crc = (uint16_t)(crc << 1);                                              /* shift left */
+            }
+        }
     }
-    *length = ((uint16_t)(buf[1] & 0x01) << 8) | buf[0];                                    /* get data */
     
-    return 0;                                                                               /* success return 0 */
+    return crc;                                                                          /* return crc */
 }
 
 /**
- * @brief      get the fifo data
- * @param[in]  *handle pointer to a bmp384 handle structure
- * @param[out] *data pointer to a data buffer
- * @param[in]  length data buffer length
- * @return     status code
- *             - 0 success
- *             - 1 get fifo data failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     load the calibration snapshot
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @param[in] *snapshot pointer to a calibration snapshot buffer
+ * @param[in] len snapshot length
+ * @return    status code
+ *            - 0 success
+ *            - 1 snapshot is invalid
+ * @note      snapshot: version, chip id, 21 calibration bytes, crc16 lsb, crc16 msb
  */
-uint8_t bmp384_get_fifo_data(bmp384_handle_t *handle, uint8_t *data, uint16_t length)
+static uint8_t a_bmp384_load_calibration_snapshot(bmp384_handle_t *handle, const uint8_t *snapshot, uint16_t len)
 {
-    uint8_t res;
+    uint16_t crc;
     
-    if (handle == NULL)                                                                       /* check handle */
+    if ((snapshot == NULL) || (len < BMP384_CALIBRATION_SNAPSHOT_LENGTH))               /* check snapshot */
     {
-        return 2;                                                                             /* return error */
+        return 1;                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
+    if (snapshot[0] != BMP384_CALIBRATION_SNAPSHOT_VERSION)                              /* check version */
     {
-        return 3;                                                                             /* return error */
+        return 1;                                                                        /* return error */
     }
-    
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_DATA, (uint8_t *)data, length);       /* read data */
-    if (res != 0)                                                                             /* check result */
+    if (snapshot[1] != 0x50)                                                             /* check chip id */
     {
-        handle->debug_print("bmp384: get fifo data register failed.\n");                      /* get fifo data register failed */
-       
-        return 1;                                                                             /* return error */
+        return 1;                                                                        /* return error */
+    }
+    crc = a_bmp384_crc16(snapshot, BMP384_CALIBRATION_SNAPSHOT_LENGTH - 2);              /* get crc */
+    if ((snapshot[BMP384_CALIBRATION_SNAPSHOT_LENGTH - 2] != (uint8_t)(crc & 0xFF)) ||
+        (snapshot[BMP384_CALIBRATION_SNAPSHOT_LENGTH - 1] != (uint8_t)((crc >> 8) & 0xFF)))  /* check crc */
+    {
+        return 1;                                                                        /* return error */
     }
+    a_bmp384_decode_calibration_data(handle, &snapshot[2]);                              /* decode the calibration data */
     
-    return 0;                                                                                 /* success return 0 */
+    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief     set the fifo watermark
+ * @brief     get the calibration data
  * @param[in] *handle pointer to a bmp384 handle structure
- * @param[in] watermark fifo watermark
  * @return    status code
  *            - 0 success
- *            - 1 set fifo watermark failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialize
+ *            - 1 get calibration data failed
  * @note      none
  */
-uint8_t bmp384_set_fifo_watermark(bmp384_handle_t *handle, uint16_t watermark)
+static uint8_t a_bmp384_get_calibration_data(bmp384_handle_t *handle)
 {
-    uint8_t res;
-    uint8_t buf[2];
-    
-    if (handle == NULL)                                                                   /* check handle */
-    {
-        return 2;                                                                         /* return error */
-    }
-    if (handle->inited != 1)                                                              /* check handle initialization */
-    {
-        return 3;                                                                         /* return error */
-    }
+    uint8_t buf[BMP384_CALIBRATION_DATA_LENGTH];
     
-    buf[0] = watermark & 0xFF;                                                            /* set low part */
-    buf[1] = (watermark >> 8) & 0x01;                                                     /* set high part */
-    res = a_bmp384_iic_spi_write(handle, BMP384_REG_FIFO_WTM_0, (uint8_t *)buf, 2);       /* write config */
-    if (res != 0)                                                                         /* check result */
+    if (a_bmp384_iic_spi_read(handle, BMP384_REG_NVM_PAR_T1_L, (uint8_t *)buf, 
+                              BMP384_CALIBRATION_DATA_LENGTH) != 0)                      /* read all calibration data */
     {
-        handle->debug_print("bmp384: set fifo watermark register failed.\n");             /* set fifo watermark register failed */
+        handle->debug_print("bmp384: get calibration data failed.\n");                   /* get calibration data failed */
        
-        return 1;                                                                         /* return error */
+        return 1;                                                                        /* return error */
     }
+    a_bmp384_decode_calibration_data(handle, (const uint8_t *)buf);                      /* decode the calibration data */
     
-    return 0;                                                                             /* success return 0 */
+    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief      get the fifo watermark
- * @param[in]  *handle pointer to a bmp384 handle structure
- * @param[out] *watermark pointer to a fifo watermark buffer
- * @return     status code
- *             - 0 success
- *             - 1 get fifo watermark failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
+ * @brief      calculate the temperature
+ * @param[in]  *calibration pointer to a bmp384 calibration structure
+ * @param[in]  data raw temperature
+ * @param[out] *t_fine pointer to a t_fine buffer
+ * @return     compensated temperature
  * @note       none
  */
-uint8_t bmp384_get_fifo_watermark(bmp384_handle_t *handle, uint16_t *watermark)
-{
-    uint8_t res;
-    uint8_t buf[2];
-    
-    if (handle == NULL)                                                                  /* check handle */
-    {
-        return 2;                                                                        /* return error */
-    }
-    if (handle->inited != 1)                                                             /* check handle initialization */
-    {
-        return 3;                                                                        /* return error */
-    }
+static int64_t a_bmp384_calculate_temperature(const bmp384_calibration_t *calibration, uint32_t data, int64_t *t_fine)
+{ 
+    uint64_t partial_data1;
+    uint64_t partial_data2;
+    uint64_t partial_data3;
+    int64_t partial_data4;
+    int64_t partial_data5;
+    int64_t partial_data6;
+    int64_t comp_temp;
+
+    /* calculate compensate temperature */
+    partial_data1 = (uint64_t)(data - (256 * (uint64_t)(calibration->t1)));
+    partial_data2 = (uint64_t)(calibration->t2 * partial_data1);
+    partial_data3 = (uint64_t)(partial_data1 * partial_data1);
+    partial_data4 = (int64_t)(((int64_t)partial_data3) * ((int64_t)calibration->t3));
+    partial_data5 = ((int64_t)(((int64_t)partial_data2) * 262144) + (int64_t)partial_data4);
+    partial_data6 = (int64_t)(((int64_t)partial_data5) / 4294967296U);
+    *t_fine = partial_data6;
+    comp_temp = (int64_t)((partial_data6 * 25)  / 16384);
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_WTM_0, (uint8_t *)buf, 2);       /* read config */
-    if (res != 0)                                                                        /* check result */
-    {
-        handle->debug_print("bmp384: get fifo watermark register failed.\n");            /* get fifo watermark register failed */
-       
-        return 1;                                                                        /* return error */
-    }
-    *watermark = ((uint16_t)(buf[1] & 0x01) << 8) | buf[0];                              /* get data */
+    return comp_temp;
+}
+
+#if (BMP384_COMPENSATE_PRESSURE_SHIFT == 1)
+/**
+ * @brief     divide by a power of two
+ * @param[in] x dividend
+ * @param[in] shift power of two
+ * @return    quotient truncated toward zero
+ * @note      same result as x / (1 << shift) without a 64-bit division,
+ *            negative values are biased before the arithmetic shift
+ */
+static int64_t a_bmp384_div_pow2(int64_t x, uint8_t shift)
+{
+    return (x + ((x >> 63) & (((int64_t)1 << shift) - 1))) >> shift;        /* add the bias when negative and shift */
+}
+
+/**
+ * @brief      calculate the temperature dependent pressure terms
+ * @param[in]  *calibration pointer to a bmp384 calibration structure
+ * @param[in]  t_fine t_fine from the temperature calculation
+ * @param[out] *terms pointer to a pressure terms structure
+ * @note       shift based kernel, bit exact with the division based kernel,
+ *             the products stay int64 since the calibration ranges leave no room for 32-bit intermediates
+ */
+static void a_bmp384_calculate_pressure_terms(const bmp384_calibration_t *calibration, int64_t t_fine, bmp384_pressure_terms_t *terms)
+{
+    int64_t partial_data1;
+    int64_t partial_data2;
+    int64_t partial_data3;
+    int64_t partial_data4;
+    int64_t partial_data5;
+    int64_t partial_data6;
+    int64_t offset;
+    int64_t sensitivity;
+
+    /* calculate the temperature dependent terms */
+    partial_data1 = t_fine * t_fine;
+    partial_data2 = a_bmp384_div_pow2(partial_data1, 6);
+    partial_data3 = a_bmp384_div_pow2(partial_data2 * t_fine, 8);
+    partial_data4 = a_bmp384_div_pow2(calibration->p8 * partial_data3, 5);
+    partial_data5 = (calibration->p7 * partial_data1) * 16;
+    partial_data6 = (calibration->p6 * t_fine) * 4194304;
+    offset = (int64_t)((int64_t)(calibration->p5) * (int64_t)140737488355328U) + partial_data4 + partial_data5 + partial_data6;
+    partial_data2 = a_bmp384_div_pow2(((int64_t)calibration->p4) * partial_data3, 5);
+    partial_data4 = (calibration->p3 * partial_data1) * 4;
+    partial_data5 = ((int64_t)(calibration->p2) - 16384) * ((int64_t)t_fine) * 2097152;
+    sensitivity = (((int64_t)(calibration->p1) - 16384) * (int64_t)70368744177664U) + partial_data2 + partial_data4 + partial_data5;
+    terms->t_fine = t_fine;
+    terms->offset = a_bmp384_div_pow2(offset, 2);
+    terms->sensitivity = a_bmp384_div_pow2(sensitivity, 24);
+    terms->linear = ((int64_t)(calibration->p10) * (int64_t)(t_fine)) + (65536 * (int64_t)(calibration->p9));
+}
+
+/**
+ * @brief     calculate the pressure from the temperature dependent terms
+ * @param[in] *calibration pointer to a bmp384 calibration structure
+ * @param[in] *terms pointer to a pressure terms structure
+ * @param[in] data raw pressure
+ * @return    compensated pressure
+ * @note      shift based kernel, bit exact with the division based kernel
+ */
+static int64_t a_bmp384_calculate_pressure_raw(const bmp384_calibration_t *calibration, const bmp384_pressure_terms_t *terms, uint32_t data)
+{
+    int64_t partial_data1;
+    int64_t partial_data2;
+    int64_t partial_data3;
+    int64_t partial_data4;
+    int64_t partial_data5;
+    int64_t partial_data6;
+    uint64_t comp_press;
+
+    /* calculate compensate pressure */
+    partial_data1 = terms->sensitivity * data;
+    partial_data4 = a_bmp384_div_pow2(terms->linear * data, 13);
+    partial_data5 = a_bmp384_div_pow2(partial_data4 * data, 9);
+    partial_data6 = (int64_t)((uint64_t)data * (uint64_t)data);
+    partial_data2 = a_bmp384_div_pow2((int64_t)(calibration->p11) * (int64_t)(partial_data6), 16);
+    partial_data3 = a_bmp384_div_pow2(partial_data2 * data, 7);
+    partial_data4 = terms->offset + partial_data1 + partial_data5 + partial_data3;
+    comp_press = (((uint64_t)partial_data4 * 25) >> 40);
     
-    return 0;                                                                            /* success return 0 */
+    return comp_press;
+}
+#else
+/**
+ * @brief      calculate the temperature dependent pressure terms
+ * @param[in]  *calibration pointer to a bmp384 calibration structure
+ * @param[in]  t_fine t_fine from the temperature calculation
+ * @param[out] *terms pointer to a pressure terms structure
+ * @note       none
+ */
+static void a_bmp384_calculate_pressure_terms(const bmp384_calibration_t *calibration, int64_t t_fine, bmp384_pressure_terms_t *terms)
+{
+    int64_t partial_data1;
+    int64_t partial_data2;
+    int64_t partial_data3;
+    int64_t partial_data4;
+    int64_t partial_data5;
+    int64_t partial_data6;
+    int64_t offset;
+    int64_t sensitivity;
+
+    /* calculate the temperature dependent terms */
+    partial_data1 = t_fine * t_fine;
+    partial_data2 = partial_data1 / 64;
+    partial_data3 = (partial_data2 * t_fine) / 256;
+    partial_data4 = (calibration->p8 * partial_data3) / 32;
+    partial_data5 = (calibration->p7 * partial_data1) * 16;
+    partial_data6 = (calibration->p6 * t_fine) * 4194304;
+    offset = (int64_t)((int64_t)(calibration->p5) * (int64_t)140737488355328U) + partial_data4 + partial_data5 + partial_data6;
+    partial_data2 = (((int64_t)calibration->p4) * partial_data3) / 32;
+    partial_data4 = (calibration->p3 * partial_data1) * 4;
+    partial_data5 = ((int64_t)(calibration->p2) - 16384) * ((int64_t)t_fine) * 2097152;
+    sensitivity = (((int64_t)(calibration->p1) - 16384) * (int64_t)70368744177664U) + partial_data2 + partial_data4 + partial_data5;
+    terms->t_fine = t_fine;
+    terms->offset = offset / 4;
+    terms->sensitivity = sensitivity / 16777216;
+    terms->linear = ((int64_t)(calibration->p10) * (int64_t)(t_fine)) + (65536 * (int64_t)(calibration->p9));
 }
 
 /**
- * @brief     enable or disable the fifo
- * @param[in] *handle pointer to a bmp384 handle structure
- * @param[in] enable bool value
- * @return    status code
- *            - 0 success
- *            - 1 set fifo failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
+ * @brief     calculate the pressure from the temperature dependent terms
+ * @param[in] *calibration pointer to a bmp384 calibration structure
+ * @param[in] *terms pointer to a pressure terms structure
+ * @param[in] data raw pressure
+ * @return    compensated pressure
  * @note      none
  */
-uint8_t bmp384_set_fifo(bmp384_handle_t *handle, bmp384_bool_t enable)
+static int64_t a_bmp384_calculate_pressure_raw(const bmp384_calibration_t *calibration, const bmp384_pressure_terms_t *terms, uint32_t data)
 {
-    uint8_t res;
-    uint8_t prev;
+    int64_t partial_data1;
+    int64_t partial_data2;
+    int64_t partial_data3;
+    int64_t partial_data4;
+    int64_t partial_data5;
+    int64_t partial_data6;
+    uint64_t comp_press;
+
+    /* calculate compensate pressure */
+    partial_data1 = terms->sensitivity * data;
+    partial_data4 = (terms->linear * data) / 8192;
+    partial_data5 = (partial_data4 * data) / 512;
+    partial_data6 = (int64_t)((uint64_t)data * (uint64_t)data);
+    partial_data2 = ((int64_t)(calibration->p11) * (int64_t)(partial_data6)) / 65536;
+    partial_data3 = (partial_data2 * data) / 128;
+    partial_data4 = terms->offset + partial_data1 + partial_data5 + partial_data3;
+    comp_press = (((uint64_t)partial_data4 * 25) / (uint64_t)1099511627776U);
     
-    if (handle == NULL)                                                                        /* check handle */
-    {
-        return 2;                                                                              /* return error */
-    }
-    if (handle->inited != 1)                                                                   /* check handle initialization */
-    {
-        return 3;                                                                              /* return error */
-    }
+    return comp_press;
+}
+#endif
+
+/**
+ * @brief     calculate the pressure
+ * @param[in] *calibration pointer to a bmp384 calibration structure
+ * @param[in] data raw pressure
+ * @param[in] t_fine t_fine from the temperature calculation
+ * @return    compensated pressure
+ * @note      none
+ */
+static int64_t a_bmp384_calculate_pressure(const bmp384_calibration_t *calibration, uint32_t data, int64_t t_fine)
+{
+    bmp384_pressure_terms_t terms;
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);        /* read config */
-    if (res != 0)                                                                              /* check result */
-    {
-        handle->debug_print("bmp384: get fifo config 1 register failed.\n");                   /* get fifo config 1 register failed */
-       
-        return 1;                                                                              /* return error */
-    }
-    prev &= ~(1 << 0);                                                                         /* clear config */
-    prev |= enable << 0;                                                                       /* set config */
-    res = a_bmp384_iic_spi_write(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);       /* write config */
-    if (res != 0)                                                                              /* check result */
-    {
-        handle->debug_print("bmp384: set fifo config 1 register failed.\n");                   /* set fifo config 1 register failed */
-       
-        return 1;                                                                              /* return error */
-    }   
+    a_bmp384_calculate_pressure_terms(calibration, t_fine, &terms);                            /* calculate the terms */
     
-    return 0;                                                                                  /* success return 0 */
+    return a_bmp384_calculate_pressure_raw(calibration, &terms, data);                         /* calculate the pressure */
 }
 
+#if (BMP384_COMPENSATE_BATCH_SIMD == 1) && defined(__AVX2__)
 /**
- * @brief      get the fifo status
- * @param[in]  *handle pointer to a bmp384 handle structure
- * @param[out] *enable pointer to a bool buffer
- * @return     status code
- *             - 0 success
- *             - 1 get fifo failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief batch kernel lanes definition
  */
-uint8_t bmp384_get_fifo(bmp384_handle_t *handle, bmp384_bool_t *enable)
+#define BMP384_BATCH_LANES 4        /**< 4 int64 lanes */
+
+/**
+ * @brief     multiply the int64 lanes by the uint32 lanes
+ * @param[in] a int64 lanes
+ * @param[in] b uint32 lanes in the low half of each int64 lane
+ * @return    low 64 bits of the products
+ * @note      two 32x32 to 64 multiplies per lane
+ */
+static __m256i a_bmp384_avx2_mul_u32(__m256i a, __m256i b)
 {
-    uint8_t res;
-    uint8_t prev;
-    
-    if (handle == NULL)                                                                       /* check handle */
-    {
-        return 2;                                                                             /* return error */
-    }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
-    {
-        return 3;                                                                             /* return error */
-    }
+    __m256i lo;
+    __m256i hi;
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                             /* check result */
-    {
-        handle->debug_print("bmp384: get fifo config 1 register failed.\n");                  /* get fifo config 1 register failed */
-       
-        return 1;                                                                             /* return error */
-    }
-    *enable = (bmp384_bool_t)(prev & 0x01);                                                   /* get config */
+    lo = _mm256_mul_epu32(a, b);                                      /* low half product */
+    hi = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), b);               /* high half product */
     
-    return 0;                                                                                 /* success return 0 */
+    return _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32));           /* sum the products */
 }
 
 /**
- * @brief     enable or disable the fifo stopping on full
- * @param[in] *handle pointer to a bmp384 handle structure
- * @param[in] enable bool value
- * @return    status code
- *            - 0 success
- *            - 1 set fifo stop on full failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief     multiply the int64 lanes
+ * @param[in] a int64 lanes
+ * @param[in] b int64 lanes
+ * @return    low 64 bits of the products
+ * @note      three 32x32 to 64 multiplies per lane
  */
-uint8_t bmp384_set_fifo_stop_on_full(bmp384_handle_t *handle, bmp384_bool_t enable)
+static __m256i a_bmp384_avx2_mul(__m256i a, __m256i b)
 {
-    uint8_t res;
-    uint8_t prev;
-    
-    if (handle == NULL)                                                                        /* check handle */
-    {
-        return 2;                                                                              /* return error */
-    }
-    if (handle->inited != 1)                                                                   /* check handle initialization */
-    {
-        return 3;                                                                              /* return error */
-    }
+    __m256i lo;
+    __m256i cross;
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);        /* read config */
-    if (res != 0)                                                                              /* check result */
-    {
-        handle->debug_print("bmp384: get fifo config 1 register failed.\n");                   /* get fifo config 1 register failed */
-       
-        return 1;                                                                              /* return error */
-    }
-    prev &= ~(1 << 1);                                                                         /* clear config */
-    prev |= enable << 1;                                                                       /* set config */
-    res = a_bmp384_iic_spi_write(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);       /* write config */
-    if (res != 0)                                                                              /* check result */
-    {
-        handle->debug_print("bmp384: set fifo config 1 register failed.\n");                   /* set fifo config 1 register failed */
-       
-        return 1;                                                                              /* return error */
-    }   
+    lo = _mm256_mul_epu32(a, b);                                      /* low half product */
+    cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+                             _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));   /* cross products */
     
-    return 0;                                                                                  /* success return 0 */
+    return _mm256_add_epi64(lo, _mm256_slli_epi64(cross, 32));        /* sum the products */
 }
 
 /**
- * @brief      get the fifo stopping on full status
- * @param[in]  *handle pointer to a bmp384 handle structure
- * @param[out] *enable pointer to a bool buffer
- * @return     status code
- *             - 0 success
- *             - 1 get fifo stop on full failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     divide the int64 lanes by a power of two
+ * @param[in] x dividend lanes
+ * @param[in] shift power of two
+ * @return    quotient lanes truncated toward zero
+ * @note      the magnitude is shifted and the sign is restored
  */
-uint8_t bmp384_get_fifo_stop_on_full(bmp384_handle_t *handle, bmp384_bool_t *enable)
+static __m256i a_bmp384_avx2_div_pow2(__m256i x, int shift)
 {
-    uint8_t res;
-    uint8_t prev;
+    __m256i m;
+    __m256i a;
     
-    if (handle == NULL)                                                                       /* check handle */
-    {
-        return 2;                                                                             /* return error */
-    }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
-    {
-        return 3;                                                                             /* return error */
-    }
+    m = _mm256_cmpgt_epi64(_mm256_setzero_si256(), x);                /* sign mask */
+    a = _mm256_sub_epi64(_mm256_xor_si256(x, m), m);                  /* magnitude */
+    a = _mm256_srli_epi64(a, shift);                                  /* shift the magnitude */
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                             /* check result */
+    return _mm256_sub_epi64(_mm256_xor_si256(a, m), m);               /* restore the sign */
+}
+
+/**
+ * @brief      calculate the pressure of the lanes
+ * @param[in]  *calibration pointer to a bmp384 calibration structure
+ * @param[in]  *terms pointer to the pressure terms of each lane
+ * @param[in]  *data pointer to the raw pressure of each lane
+ * @param[out] *pressure_pa pointer to the compensated pressure of each lane
+ * @note       avx2 kernel, bit exact with a_bmp384_calculate_pressure_raw
+ */
+static void a_bmp384_calculate_pressure_lanes(const bmp384_calibration_t *calibration, const bmp384_pressure_terms_t *terms,
+                                              const uint32_t *data, uint32_t *pressure_pa)
+{
+    __m256i d;
+    __m256i partial_data1;
+    __m256i partial_data2;
+    __m256i partial_data3;
+    __m256i partial_data4;
+    __m256i partial_data5;
+    __m256i partial_data6;
+    
+    d = _mm256_cvtepu32_epi64(_mm_loadu_si128((const __m128i *)data));                                       /* load the raw pressure */
+    partial_data1 = a_bmp384_avx2_mul_u32(_mm256_set_epi64x(terms[3].sensitivity, terms[2].sensitivity, 
+                                                            terms[1].sensitivity, terms[0].sensitivity), d);  /* sensitivity * data */
+    partial_data4 = a_bmp384_avx2_mul_u32(_mm256_set_epi64x(terms[3].linear, terms[2].linear, 
+                                                            terms[1].linear, terms[0].linear), d);            /* linear * data */
+    partial_data4 = a_bmp384_avx2_div_pow2(partial_data4, 13);                                                /* / 8192 */
+    partial_data5 = a_bmp384_avx2_div_pow2(a_bmp384_avx2_mul_u32(partial_data4, d), 9);                        /* * data / 512 */
+    partial_data6 = _mm256_mul_epu32(d, d);                                                                  /* data * data */
+    partial_data2 = a_bmp384_avx2_mul(_mm256_set1_epi64x(calibration->p11), partial_data6);                  /* p11 * data * data */
+    partial_data2 = a_bmp384_avx2_div_pow2(partial_data2, 16);                                                /* / 65536 */
+    partial_data3 = a_bmp384_avx2_div_pow2(a_bmp384_avx2_mul_u32(partial_data2, d), 7);                        /* * data / 128 */
+    partial_data4 = _mm256_add_epi64(_mm256_set_epi64x(terms[3].offset, terms[2].offset, 
+                                                       terms[1].offset, terms[0].offset), partial_data1);     /* offset + partial 1 */
+    partial_data4 = _mm256_add_epi64(partial_data4, _mm256_add_epi64(partial_data5, partial_data3));         /* + partial 5 + partial 3 */
+    partial_data4 = a_bmp384_avx2_mul_u32(partial_data4, _mm256_set1_epi64x(25));                            /* * 25 */
+    partial_data4 = _mm256_srli_epi64(partial_data4, 40);                                                    /* / 2^40 */
+    partial_data4 = _mm256_permutevar8x32_epi32(partial_data4, _mm256_set_epi32(7, 5, 3, 1, 6, 4, 2, 0));    /* pack the low halves */
+    _mm_storeu_si128((__m128i *)pressure_pa, _mm256_castsi256_si128(partial_data4));                         /* store the pressure */
+}
+#elif (BMP384_COMPENSATE_BATCH_SIMD == 1) && defined(__SSE4_1__)
+/**
+ * @brief batch kernel lanes definition
+ */
+#define BMP384_BATCH_LANES 2        /**< 2 int64 lanes */
+
+/**
+ * @brief     multiply the int64 lanes by the uint32 lanes
+ * @param[in] a int64 lanes
+ * @param[in] b uint32 lanes in the low half of each int64 lane
+ * @return    low 64 bits of the products
+ * @note      two 32x32 to 64 multiplies per lane
+ */
+static __m128i a_bmp384_sse_mul_u32(__m128i a, __m128i b)
+{
+    __m128i lo;
+    __m128i hi;
+    
+    lo = _mm_mul_epu32(a, b);                                         /* low half product */
+    hi = _mm_mul_epu32(_mm_srli_epi64(a, 32), b);                     /* high half product */
+    
+    return _mm_add_epi64(lo, _mm_slli_epi64(hi, 32));                 /* sum the products */
+}
+
+/**
+ * @brief     multiply the int64 lanes
+ * @param[in] a int64 lanes
+ * @param[in] b int64 lanes
+ * @return    low 64 bits of the products
+ * @note      three 32x32 to 64 multiplies per lane
+ */
+static __m128i a_bmp384_sse_mul(__m128i a, __m128i b)
+{
+    __m128i lo;
+    __m128i cross;
+    
+    lo = _mm_mul_epu32(a, b);                                         /* low half product */
+    cross = _mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), b),
+                          _mm_mul_epu32(a, _mm_srli_epi64(b, 32)));   /* cross products */
+    
+    return _mm_add_epi64(lo, _mm_slli_epi64(cross, 32));              /* sum the products */
+}
+
+/**
+ * @brief     divide the int64 lanes by a power of two
+ * @param[in] x dividend lanes
+ * @param[in] shift power of two
+ * @return    quotient lanes truncated toward zero
+ * @note      the magnitude is shifted and the sign is restored
+ */
+static __m128i a_bmp384_sse_div_pow2(__m128i x, int shift)
+{
+    __m128i m;
+    __m128i a;
+    
+    m = _mm_shuffle_epi32(_mm_srai_epi32(x, 31), _MM_SHUFFLE(3, 3, 1, 1));   /* sign mask */
+    a = _mm_sub_epi64(_mm_xor_si128(x, m), m);                               /* magnitude */
+    a = _mm_srli_epi64(a, shift);                                            /* shift the magnitude */
+    
+    return _mm_sub_epi64(_mm_xor_si128(a, m), m);                            /* restore the sign */
+}
+
+/**
+ * @brief      calculate the pressure of the lanes
+ * @param[in]  *calibration pointer to a bmp384 calibration structure
+ * @param[in]  *terms pointer to the pressure terms of each lane
+ * @param[in]  *data pointer to the raw pressure of each lane
+ * @param[out] *pressure_pa pointer to the compensated pressure of each lane
+ * @note       sse4.1 kernel, bit exact with a_bmp384_calculate_pressure_raw
+ */
+static void a_bmp384_calculate_pressure_lanes(const bmp384_calibration_t *calibration, const bmp384_pressure_terms_t *terms,
+                                              const uint32_t *data, uint32_t *pressure_pa)
+{
+    __m128i d;
+    __m128i partial_data1;
+    __m128i partial_data2;
+    __m128i partial_data3;
+    __m128i partial_data4;
+    __m128i partial_data5;
+    __m128i partial_data6;
+    
+    d = _mm_cvtepu32_epi64(_mm_loadl_epi64((const __m128i *)data));                                          /* load the raw pressure */
+    partial_data1 = a_bmp384_sse_mul_u32(_mm_set_epi64x(terms[1].sensitivity, terms[0].sensitivity), d);     /* sensitivity * data */
+    partial_data4 = a_bmp384_sse_mul_u32(_mm_set_epi64x(terms[1].linear, terms[0].linear), d);               /* linear * data */
+    partial_data4 = a_bmp384_sse_div_pow2(partial_data4, 13);                                                /* / 8192 */
+    partial_data5 = a_bmp384_sse_div_pow2(a_bmp384_sse_mul_u32(partial_data4, d), 9);                         /* * data / 512 */
+    partial_data6 = _mm_mul_epu32(d, d);                                                                     /* data * data */
+    partial_data2 = a_bmp384_sse_mul(_mm_set1_epi64x(calibration->p11), partial_data6);                      /* p11 * data * data */
+    partial_data2 = a_bmp384_sse_div_pow2(partial_data2, 16);                                                /* / 65536 */
+    partial_data3 = a_bmp384_sse_div_pow2(a_bmp384_sse_mul_u32(partial_data2, d), 7);                         /* * data / 128 */
+    partial_data4 = _mm_add_epi64(_mm_set_epi64x(terms[1].offset, terms[0].offset), partial_data1);          /* offset + partial 1 */
+    partial_data4 = _mm_add_epi64(partial_data4, _mm_add_epi64(partial_data5, partial_data3));               /* + partial 5 + partial 3 */
+    partial_data4 = a_bmp384_sse_mul_u32(partial_data4, _mm_set1_epi64x(25));                                /* * 25 */
+    partial_data4 = _mm_srli_epi64(partial_data4, 40);                                                       /* / 2^40 */
+    partial_data4 = _mm_shuffle_epi32(partial_data4, _MM_SHUFFLE(3, 1, 2, 0));                               /* pack the low halves */
+    _mm_storel_epi64((__m128i *)pressure_pa, partial_data4);                                                 /* store the pressure */
+}
+#elif (BMP384_COMPENSATE_BATCH_SIMD == 1) && defined(__ARM_NEON)
+/**
+ * @brief batch kernel lanes definition
+ */
+#define BMP384_BATCH_LANES 2        /**< 2 int64 lanes */
+
+/**
+ * @brief     multiply the int64 lanes by the uint32 lanes
+ * @param[in] a int64 lanes
+ * @param[in] b uint32 lanes
+ * @return    low 64 bits of the products
+ * @note      two 32x32 to 64 multiplies per lane
+ */
+static uint64x2_t a_bmp384_neon_mul_u32(uint64x2_t a, uint32x2_t b)
+{
+    uint64x2_t lo;
+    uint64x2_t hi;
+    
+    lo = vmull_u32(vmovn_u64(a), b);                                  /* low half product */
+    hi = vmull_u32(vshrn_n_u64(a, 32), b);                            /* high half product */
+    
+    return vaddq_u64(lo, vshlq_n_u64(hi, 32));                        /* sum the products */
+}
+
+/**
+ * @brief     multiply the int64 lanes
+ * @param[in] a int64 lanes
+ * @param[in] b int64 lanes
+ * @return    low 64 bits of the products
+ * @note      three 32x32 to 64 multiplies per lane
+ */
+static uint64x2_t a_bmp384_neon_mul(uint64x2_t a, uint64x2_t b)
+{
+    uint64x2_t lo;
+    uint64x2_t cross;
+    
+    lo = vmull_u32(vmovn_u64(a), vmovn_u64(b));                                  /* low half product */
+    cross = vmull_u32(vshrn_n_u64(a, 32), vmovn_u64(b));                         /* cross product */
+    cross = vmlal_u32(cross, vmovn_u64(a), vshrn_n_u64(b, 32));                  /* cross product */
+    
+    return vaddq_u64(lo, vshlq_n_u64(cross, 32));                                /* sum the products */
+}
+
+/**
+ * @brief     divide the int64 lanes by a power of two
+ * @param[in] x dividend lanes
+ * @param[in] shift power of two
+ * @return    quotient lanes truncated toward zero
+ * @note      the magnitude is shifted and the sign is restored
+ */
+static uint64x2_t a_bmp384_neon_div_pow2(uint64x2_t x, int shift)
+{
+    uint64x2_t m;
+    uint64x2_t a;
+    
+    m = vreinterpretq_u64_s64(vshrq_n_s64(vreinterpretq_s64_u64(x), 63));       /* sign mask */
+    a = vsubq_u64(veorq_u64(x, m), m);                                          /* magnitude */
+    a = vshlq_u64(a, vdupq_n_s64(-shift));                                      /* shift the magnitude */
+    
+    return vsubq_u64(veorq_u64(a, m), m);                                       /* restore the sign */
+}
+
+/**
+ * @brief      calculate the pressure of the lanes
+ * @param[in]  *calibration pointer to a bmp384 calibration structure
+ * @param[in]  *terms pointer to the pressure terms of each lane
+ * @param[in]  *data pointer to the raw pressure of each lane
+ * @param[out] *pressure_pa pointer to the compensated pressure of each lane
+ * @note       neon kernel, bit exact with a_bmp384_calculate_pressure_raw
+ */
+static void a_bmp384_calculate_pressure_lanes(const bmp384_calibration_t *calibration, const bmp384_pressure_terms_t *terms,
+                                              const uint32_t *data, uint32_t *pressure_pa)
+{
+    uint32x2_t d;
+    uint64x2_t partial_data1;
+    uint64x2_t partial_data2;
+    uint64x2_t partial_data3;
+    uint64x2_t partial_data4;
+    uint64x2_t partial_data5;
+    uint64x2_t partial_data6;
+    uint64x2_t lane;
+    
+    d = vld1_u32(data);                                                                                      /* load the raw pressure */
+    lane = vcombine_u64(vcreate_u64((uint64_t)terms[0].sensitivity), vcreate_u64((uint64_t)terms[1].sensitivity));
+    partial_data1 = a_bmp384_neon_mul_u32(lane, d);                                                          /* sensitivity * data */
+    lane = vcombine_u64(vcreate_u64((uint64_t)terms[0].linear), vcreate_u64((uint64_t)terms[1].linear));
+    partial_data4 = a_bmp384_neon_div_pow2(a_bmp384_neon_mul_u32(lane, d), 13);                              /* linear * data / 8192 */
+    partial_data5 = a_bmp384_neon_div_pow2(a_bmp384_neon_mul_u32(partial_data4, d), 9);                      /* * data / 512 */
+    partial_data6 = vmull_u32(d, d);                                                                         /* data * data */
+    partial_data2 = a_bmp384_neon_mul(vdupq_n_u64((uint64_t)(int64_t)calibration->p11), partial_data6);      /* p11 * data * data */
+    partial_data2 = a_bmp384_neon_div_pow2(partial_data2, 16);                                               /* / 65536 */
+    partial_data3 = a_bmp384_neon_div_pow2(a_bmp384_neon_mul_u32(partial_data2, d), 7);                      /* * data / 128 */
+    lane = vcombine_u64(vcreate_u64((uint64_t)terms[0].offset), vcreate_u64((uint64_t)terms[1].offset));
+    partial_data4 = vaddq_u64(lane, partial_data1);                                                          /* offset + partial 1 */
+    partial_data4 = vaddq_u64(partial_data4, vaddq_u64(partial_data5, partial_data3));                       /* + partial 5 + partial 3 */
+    partial_data4 = a_bmp384_neon_mul_u32(partial_data4, vdup_n_u32(25));                                   /* * 25 */
+    partial_data4 = vshrq_n_u64(partial_data4, 40);                                                          /* / 2^40 */
+    vst1_u32(pressure_pa, vmovn_u64(partial_data4));                                                         /* store the pressure */
+}
+#endif
+
+/**
+ * @brief     compensate the temperature
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @param[in] data raw temperature
+ * @return    compensated temperature
+ * @note      the t_fine of the handle is updated for the next pressure compensation
+ */
+static int64_t a_bmp384_compensate_temperature(bmp384_handle_t *handle, uint32_t data)
+{
+    return a_bmp384_calculate_temperature(&handle->calibration, data, &handle->t_fine);        /* calculate the temperature */
+}
+
+/**
+ * @brief     compensate the pressure
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @param[in] data raw pressure
+ * @return    compensated pressure
+ * @note      uses the t_fine of the last temperature compensation,
+ *            the temperature dependent terms are cached until t_fine changes
+ */
+static int64_t a_bmp384_compensate_pressure(bmp384_handle_t *handle, uint32_t data)
+{
+    if ((handle->pressure_terms_valid == 0) ||
+        (handle->pressure_terms.t_fine != handle->t_fine))                                        /* check the cache */
     {
-        handle->debug_print("bmp384: get fifo config 1 register failed.\n");                  /* get fifo config 1 register failed */
-        
-        return 1;                                                                             /* return error */
+        a_bmp384_calculate_pressure_terms(&handle->calibration, handle->t_fine, 
+                                          &handle->pressure_terms);                               /* calculate the terms */
+        handle->pressure_terms_valid = 1;                                                         /* set valid */
     }
-    *enable = (bmp384_bool_t)((prev >> 1) & 0x01);                                            /* get config */
     
-    return 0;                                                                                 /* success return 0 */
+    return a_bmp384_calculate_pressure_raw(&handle->calibration, &handle->pressure_terms, data);  /* calculate the pressure */
 }
 
 /**
- * @brief     enable or disable the fifo sensor time on
- * @param[in] *handle pointer to a bmp384 handle structure
- * @param[in] enable bool value
- * @return    status code
- *            - 0 success
- *            - 1 set fifo sensor time on failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
+ * @brief     saturate the temperature of a sample
+ * @param[in] c compensated temperature in 0.01C
+ * @return    temperature in 0.01C
  * @note      none
  */
-uint8_t bmp384_set_fifo_sensortime_on(bmp384_handle_t *handle, bmp384_bool_t enable)
+static int16_t a_bmp384_sample_temperature(int64_t c)
 {
-    uint8_t res;
-    uint8_t prev;
-    
-    if (handle == NULL)                                                                        /* check handle */
+    if (c > INT16_MAX)                                          /* check max */
     {
-        return 2;                                                                              /* return error */
+        return INT16_MAX;                                       /* return max */
     }
-    if (handle->inited != 1)                                                                   /* check handle initialization */
+    else if (c < INT16_MIN)                                     /* check min */
     {
-        return 3;                                                                              /* return error */
+        return INT16_MIN;                                       /* return min */
     }
-    
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);        /* read config */
-    if (res != 0)                                                                              /* check result */
+    else
     {
-        handle->debug_print("bmp384: get fifo config 1 register failed.\n");                   /* get fifo config 1 register failed */
-       
-        return 1;                                                                              /* return error */
+        return (int16_t)c;                                      /* return temperature */
     }
-    prev &= ~(1 << 2);                                                                         /* clear config */
-    prev |= enable << 2;                                                                       /* set config */
-    res = a_bmp384_iic_spi_write(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);       /* write config */
-    if (res != 0)                                                                              /* check result */
+}
+
+/**
+ * @brief     get the fifo frame length
+ * @param[in] header frame header
+ * @return    frame length, 0 means the header is invalid
+ * @note      none
+ */
+static uint8_t a_bmp384_fifo_frame_length(uint8_t header)
+{
+    switch (header)
     {
-        handle->debug_print("bmp384: set fifo config 1 register failed.\n");                   /* set fifo config 1 register failed */
-       
-        return 1;                                                                              /* return error */
-    }   
-    
-    return 0;                                                                                  /* success return 0 */
+        case 0x94 :                       /* temperature and pressure */
+        {
+            return 7;                     /* return 7 */
+        }
+        case 0x90 :                       /* temperature */
+        case 0xA0 :                       /* sensor time */
+        {
+            return 4;                     /* return 4 */
+        }
+        case 0x80 :                       /* fifo empty */
+        case 0x48 :                       /* fifo input config */
+        case 0x44 :                       /* config error */
+        {
+            return 2;                     /* return 2 */
+        }
+        default :
+        {
+            return 0;                     /* return 0 */
+        }
+    }
 }
 
 /**
- * @brief      get the fifo sensor time on status
+ * @brief      get the error
  * @param[in]  *handle pointer to a bmp384 handle structure
- * @param[out] *enable pointer to a bool buffer
+ * @param[out] *err pointer to an error buffer
  * @return     status code
  *             - 0 success
- *             - 1 get fifo sensor time on failed
+ *             - 1 get error failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t bmp384_get_fifo_sensortime_on(bmp384_handle_t *handle, bmp384_bool_t *enable)
+uint8_t bmp384_get_error(bmp384_handle_t *handle, uint8_t *err)
 {
     uint8_t res;
-    uint8_t prev;
     
-    if (handle == NULL)                                                                       /* check handle */
+    if (handle == NULL)                                                               /* check handle */
     {
-        return 2;                                                                             /* return error */
+        return 2;                                                                     /* return error */
     }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
+    if (handle->inited != 1)                                                          /* check handle initialization */
     {
-        return 3;                                                                             /* return error */
+        return 3;                                                                     /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                             /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_ERR_REG, (uint8_t *)err, 1);       /* read config */
+    if (res != 0)                                                                     /* check result */
     {
-        handle->debug_print("bmp384: get fifo config 1 register failed.\n");                  /* get fifo config 1 register failed */
+        handle->debug_print("bmp384: get error register failed.\n");                  /* get error register failed */
        
-        return 1;                                                                             /* return error */
+        return 1;                                                                     /* return error */
     }
-    *enable = (bmp384_bool_t)((prev >> 2) & 0x01);                                            /* get config */
-    
-    return 0;                                                                                 /* success return 0 */
+
+    return 0;                                                                         /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the fifo pressure on
- * @param[in] *handle pointer to a bmp384 handle structure
- * @param[in] enable bool value
- * @return    status code
- *            - 0 success
- *            - 1 set fifo pressure on failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      get the status
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *status pointer to a status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get status failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
  */
-uint8_t bmp384_set_fifo_pressure_on(bmp384_handle_t *handle, bmp384_bool_t enable)
+uint8_t bmp384_get_status(bmp384_handle_t *handle, uint8_t *status)
 {
     uint8_t res;
-    uint8_t prev;
     
-    if (handle == NULL)                                                                        /* check handle */
+    if (handle == NULL)                                                                 /* check handle */
     {
-        return 2;                                                                              /* return error */
+        return 2;                                                                       /* return error */
     }
-    if (handle->inited != 1)                                                                   /* check handle initialization */
+    if (handle->inited != 1)                                                            /* check handle initialization */
     {
-        return 3;                                                                              /* return error */
+        return 3;                                                                       /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);        /* read config */
-    if (res != 0)                                                                              /* check result */
-    {
-        handle->debug_print("bmp384: get fifo config 1 register failed.\n");                   /* get fifo config 1 register failed */
-       
-        return 1;                                                                              /* return error */
-    }
-    prev &= ~(1 << 3);                                                                         /* clear config */
-    prev |= enable << 3;                                                                       /* set config */
-    res = a_bmp384_iic_spi_write(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);       /* write config */
-    if (res != 0)                                                                              /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_STATUS, (uint8_t *)status, 1);       /* read status */
+    if (res != 0)                                                                       /* check result */
     {
-        handle->debug_print("bmp384: set fifo config 1 register failed.\n");                   /* set fifo config 1 register failed */
+        handle->debug_print("bmp384: get status register failed.\n");                   /* get status register failed */
        
-        return 1;                                                                              /* return error */
+        return 1;                                                                       /* return error */
     }
-    
-    return 0;                                                                                  /* success return 0 */
+
+    return 0;                                                                           /* success return 0 */
 }
 
 /**
- * @brief      get the fifo pressure on status
+ * @brief      get the sensor time
  * @param[in]  *handle pointer to a bmp384 handle structure
- * @param[out] *enable pointer to a bool buffer
+ * @param[out] *t pointer to a timestamp buffer
  * @return     status code
  *             - 0 success
- *             - 1 get fifo pressure on failed
+ *             - 1 get sensor time failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t bmp384_get_fifo_pressure_on(bmp384_handle_t *handle, bmp384_bool_t *enable)
+uint8_t bmp384_get_sensortime(bmp384_handle_t *handle, uint32_t *t)
 {
     uint8_t res;
-    uint8_t prev;
+    uint8_t buf[3];
     
-    if (handle == NULL)                                                                       /* check handle */
+    if (handle == NULL)                                                                    /* check handle */
     {
-        return 2;                                                                             /* return error */
+        return 2;                                                                          /* return error */
     }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
+    if (handle->inited != 1)                                                               /* check handle initialization */
     {
-        return 3;                                                                             /* return error */
+        return 3;                                                                          /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                             /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_SENSORTIME_0, (uint8_t *)buf, 3);       /* read config */
+    if (res != 0)                                                                          /* check result */
     {
-        handle->debug_print("bmp384: get fifo config 1 register failed.\n");                  /* get fifo config 1 register failed */
+        handle->debug_print("bmp384: get sensor time register failed.\n");                 /* get sensor time register failed */
        
-        return 1;                                                                             /* return error */
+        return 1;                                                                          /* return error */
     }
-    *enable = (bmp384_bool_t)((prev >> 3) & 0x01);                                            /* get config */
+    *t = (uint32_t)buf[2] << 16 | (uint32_t)buf[1] << 8 | buf[0];                          /* get time */
     
-    return 0;                                                                                 /* success return 0 */
+    return 0;                                                                              /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the fifo temperature on
- * @param[in] *handle pointer to a bmp384 handle structure
- * @param[in] enable bool value
+ * @brief     get the clock sync slope
+ * @param[in] *sync pointer to a clock sync structure
+ * @return    host ns per sensor time tick
+ * @note      none
+ */
+static double a_bmp384_clock_sync_slope(const bmp384_clock_sync_t *sync)
+{
+    if ((sync->count < 2) || (sync->cxx <= 0.0))                                           /* check the fit */
+    {
+        return BMP384_SENSORTIME_TICK_NS;                                                  /* use the nominal tick */
+    }
+    
+    return sync->cxy / sync->cxx;                                                          /* least squares slope */
+}
+
+/**
+ * @brief     reset the clock sync
+ * @param[in] *sync pointer to a clock sync structure
  * @return    status code
  *            - 0 success
- *            - 1 set fifo temperature on failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
+ *            - 1 sync is NULL
  * @note      none
  */
-uint8_t bmp384_set_fifo_temperature_on(bmp384_handle_t *handle, bmp384_bool_t enable)
+uint8_t bmp384_clock_sync_reset(bmp384_clock_sync_t *sync)
 {
-    uint8_t res;
-    uint8_t prev;
-    
-    if (handle == NULL)                                                                        /* check handle */
+    if (sync == NULL)                                                                      /* check sync */
     {
-        return 2;                                                                              /* return error */
+        return 1;                                                                          /* return error */
     }
-    if (handle->inited != 1)                                                                   /* check handle initialization */
+    
+    memset(sync, 0, sizeof(bmp384_clock_sync_t));                                          /* clear all */
+    
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief     add a sensor time and host time pair to the clock sync
+ * @param[in] *sync pointer to a clock sync structure
+ * @param[in] sensortime raw sensor time
+ * @param[in] host_ns host monotonic time in ns
+ * @return    status code
+ *            - 0 success
+ *            - 1 sync is NULL
+ * @note      the 24-bit sensor time wraps every 655s, pairs must be added more often than that,
+ *            the fit follows the last BMP384_CLOCK_SYNC_WINDOW pairs with a forgetting factor
+ */
+uint8_t bmp384_clock_sync_update(bmp384_clock_sync_t *sync, uint32_t sensortime, uint64_t host_ns)
+{
+    double x;
+    double y;
+    double dx;
+    double lambda;
+    
+    if (sync == NULL)                                                                      /* check sync */
     {
-        return 3;                                                                              /* return error */
+        return 1;                                                                          /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);        /* read config */
-    if (res != 0)                                                                              /* check result */
+    lambda = 1.0 - 1.0 / (double)BMP384_CLOCK_SYNC_WINDOW;                                 /* forgetting factor */
+    sensortime &= 0xFFFFFF;                                                                /* 24 bits */
+    if (sync->count == 0)                                                                  /* first pair */
     {
-        handle->debug_print("bmp384: get fifo config 1 register failed.\n");                   /* get fifo config 1 register failed */
-       
-        return 1;                                                                              /* return error */
+        sync->ticks = 0;                                                                   /* start from 0 */
+        sync->host_ns0 = host_ns;                                                          /* save host time */
     }
-    prev &= ~(1 << 4);                                                                         /* clear config */
-    prev |= enable << 4;                                                                       /* set config */
-    res = a_bmp384_iic_spi_write(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);       /* write config */
-    if (res != 0)                                                                              /* check result */
+    else
     {
-        handle->debug_print("bmp384: set fifo config 1 register failed.\n");                   /* set fifo config 1 register failed */
-       
-        return 1;                                                                              /* return error */
-    }   
+        sync->ticks += (int64_t)((sensortime - sync->last_raw) & 0xFFFFFF);                /* unwrap the sensor time */
+    }
+    sync->last_raw = sensortime;                                                           /* save raw */
+    x = (double)sync->ticks;                                                               /* set x */
+    y = (double)(int64_t)(host_ns - sync->host_ns0);                                       /* set y */
+    sync->count++;                                                                         /* count++ */
+    sync->weight = sync->weight * lambda + 1.0;                                            /* fade the old pairs */
+    dx = x - sync->mean_x;                                                                 /* x deviation from the old mean */
+    sync->mean_x += dx / sync->weight;                                                     /* update x mean */
+    sync->mean_y += (y - sync->mean_y) / sync->weight;                                     /* update y mean */
+    sync->cxx = sync->cxx * lambda + dx * (x - sync->mean_x);                              /* update x variance */
+    sync->cxy = sync->cxy * lambda + dx * (y - sync->mean_y);                              /* update covariance */
     
-    return 0;                                                                                  /* success return 0 */
+    return 0;                                                                              /* success return 0 */
 }
 
 /**
- * @brief      get the fifo temperature on status
- * @param[in]  *handle pointer to a bmp384 handle structure
- * @param[out] *enable pointer to a bool buffer
+ * @brief      convert a sensor time to the host time
+ * @param[in]  *sync pointer to a clock sync structure
+ * @param[in]  sensortime raw sensor time
+ * @param[out] *host_ns pointer to a host time buffer
  * @return     status code
  *             - 0 success
- *             - 1 get fifo temperature on failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ *             - 1 sync is NULL
+ *             - 4 no pair
+ * @note       sensortime must be within 327s of the last pair,
+ *             the nominal 39.0625us tick is used until two pairs are added
  */
-uint8_t bmp384_get_fifo_temperature_on(bmp384_handle_t *handle, bmp384_bool_t *enable)
+uint8_t bmp384_clock_sync_convert(const bmp384_clock_sync_t *sync, uint32_t sensortime, uint64_t *host_ns)
 {
-    uint8_t res;
-    uint8_t prev;
+    int32_t delta;
+    double x;
+    double y;
     
-    if (handle == NULL)                                                                       /* check handle */
+    if ((sync == NULL) || (host_ns == NULL))                                               /* check sync */
     {
-        return 2;                                                                             /* return error */
+        return 1;                                                                          /* return error */
     }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
+    if (sync->count == 0)                                                                  /* check pair */
     {
-        return 3;                                                                             /* return error */
+        return 4;                                                                          /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                             /* check result */
+    delta = (int32_t)(((sensortime - sync->last_raw) + 0x800000) & 0xFFFFFF) - 0x800000;   /* signed distance to the last pair */
+    x = (double)(sync->ticks + delta);                                                     /* unwrapped sensor time */
+    y = sync->mean_y + a_bmp384_clock_sync_slope(sync) * (x - sync->mean_x);               /* fitted host time */
+    *host_ns = sync->host_ns0 + (uint64_t)(int64_t)(y + ((y < 0.0) ? -0.5 : 0.5));         /* round to ns */
+    
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief      get the clock drift
+ * @param[in]  *sync pointer to a clock sync structure
+ * @param[out] *ppm pointer to a drift buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 sync is NULL
+ *             - 4 not enough pairs
+ * @note       positive ppm means the sensor clock runs slower than the host clock
+ */
+uint8_t bmp384_clock_sync_get_drift(const bmp384_clock_sync_t *sync, double *ppm)
+{
+    if ((sync == NULL) || (ppm == NULL))                                                     /* check sync */
     {
-        handle->debug_print("bmp384: get fifo config 1 register failed.\n");                  /* get fifo config 1 register failed */
-       
-        return 1;                                                                             /* return error */
+        return 1;                                                                            /* return error */
+    }
+    if ((sync->count < 2) || (sync->cxx <= 0.0))                                             /* check pairs */
+    {
+        return 4;                                                                            /* return error */
     }
-    *enable = (bmp384_bool_t)((prev >> 4) & 0x01);                                            /* get config */
     
-    return 0;                                                                                 /* success return 0 */
+    *ppm = (a_bmp384_clock_sync_slope(sync) / BMP384_SENSORTIME_TICK_NS - 1.0) * 1000000.0;  /* get drift */
+    
+    return 0;                                                                                /* success return 0 */
 }
 
 /**
- * @brief     set the fifo subsampling
- * @param[in] *handle pointer to a bmp384 handle structure
- * @param[in] subsample fifo subsample
- * @return    status code
- *            - 0 success
- *            - 1 set fifo subsampling failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      subsample <= 7
+ * @brief      get the event
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *event pointer to an event buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get event failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
  */
-uint8_t bmp384_set_fifo_subsampling(bmp384_handle_t *handle, uint8_t subsample)
+uint8_t bmp384_get_event(bmp384_handle_t *handle, bmp384_event_t *event)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                        /* check handle */
+    if (handle == NULL)                                                               /* check handle */
     {
-        return 2;                                                                              /* return error */
+        return 2;                                                                     /* return error */
     }
-    if (handle->inited != 1)                                                                   /* check handle initialization */
+    if (handle->inited != 1)                                                          /* check handle initialization */
     {
-        return 3;                                                                              /* return error */
+        return 3;                                                                     /* return error */
     }
     
-    if (subsample > 7)                                                                         /* check subsample */
-    {
-        handle->debug_print("bmp384: subsample is invalid.\n");                                /* subsample is invalid */
-       
-        return 4;                                                                              /* return error */
-    }
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_2, (uint8_t *)&prev, 1);        /* read config */
-    if (res != 0)                                                                              /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_EVENT, (uint8_t *)&prev, 1);       /* read config */
+    if (res != 0)                                                                     /* check result */
     {
-        handle->debug_print("bmp384: get fifo config 2 register failed.\n");                   /* get fifo config 2 register failed */
+        handle->debug_print("bmp384: get event register failed.\n");                  /* get event register failed */
        
-        return 1;                                                                              /* return error */
+        return 1;                                                                     /* return error */
     }
-    prev &= ~(7 << 0);                                                                         /* clear config */
-    prev |= subsample << 0;                                                                    /* set config */
-    res = a_bmp384_iic_spi_write(handle, BMP384_REG_FIFO_CONFIG_2, (uint8_t *)&prev, 1);       /* write config */
-    if (res != 0)                                                                              /* check result */
-    {
-        handle->debug_print("bmp384: set fifo config 2 register failed.\n");                   /* set fifo config 2 register failed */
-       
-        return 1;                                                                              /* return error */
-    }   
-    
-    return 0;                                                                                  /* success return 0 */
+    *event = (bmp384_event_t)(prev & (1 << 0));                                       /* get event */
+
+    return 0;                                                                         /* success return 0 */
 }
 
 /**
- * @brief      get the fifo subsampling
+ * @brief      get the interrupt status
  * @param[in]  *handle pointer to a bmp384 handle structure
- * @param[out] *subsample pointer to subsample buffer
+ * @param[out] *status pointer to a status buffer
  * @return     status code
  *             - 0 success
- *             - 1 get fifo subsampling failed
+ *             - 1 get interrupt status failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t bmp384_get_fifo_subsampling(bmp384_handle_t *handle, uint8_t *subsample)
+uint8_t bmp384_get_interrupt_status(bmp384_handle_t *handle, uint8_t *status)
 {
     uint8_t res;
-    uint8_t prev;
     
-    if (handle == NULL)                                                                       /* check handle */
+    if (handle == NULL)                                                                     /* check handle */
     {
-        return 2;                                                                             /* return error */
+        return 2;                                                                           /* return error */
     }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
+    if (handle->inited != 1)                                                                /* check handle initialization */
     {
-        return 3;                                                                             /* return error */
+        return 3;                                                                           /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_2, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                             /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_INT_STATUS, (uint8_t *)status, 1);       /* read status */
+    if (res != 0)                                                                           /* check result */
     {
-        handle->debug_print("bmp384: get fifo config 2 register failed.\n");                  /* get fifo config 2 register failed */
+        handle->debug_print("bmp384: get interrupt status register failed.\n");             /* get interrupt status register failed */
        
-        return 1;                                                                             /* return error */
+        return 1;                                                                           /* return error */
     }
-    *subsample = (bmp384_bool_t)((prev >> 0) & 0x07);                                         /* get config */
-    
-    return 0;                                                                                 /* success return 0 */
+
+    return 0;                                                                               /* success return 0 */
 }
 
 /**
- * @brief     set the fifo data source
- * @param[in] *handle pointer to a bmp384 handle structure
- * @param[in] source fifo data source
- * @return    status code
- *            - 0 success
- *            - 1 set fifo data source failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      get the fifo length
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *length pointer to a fifo length buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get fifo length failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
  */
-uint8_t bmp384_set_fifo_data_source(bmp384_handle_t *handle, bmp384_fifo_data_source_t source)
+uint8_t bmp384_get_fifo_length(bmp384_handle_t *handle, uint16_t *length)
 {
     uint8_t res;
-    uint8_t prev;
+    uint8_t buf[2];
     
-    if (handle == NULL)                                                                        /* check handle */
+    if (handle == NULL)                                                                     /* check handle */
     {
-        return 2;                                                                              /* return error */
+        return 2;                                                                           /* return error */
     }
-    if (handle->inited != 1)                                                                   /* check handle initialization */
+    if (handle->inited != 1)                                                                /* check handle initialization */
     {
-        return 3;                                                                              /* return error */
+        return 3;                                                                           /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_2, (uint8_t *)&prev, 1);        /* read config */
-    if (res != 0)                                                                              /* check result */
-    {
-        handle->debug_print("bmp384: get fifo config 2 register failed.\n");                   /* get fifo config 2 register failed */
-       
-        return 1;                                                                              /* return error */
-    }   
-    prev &= ~(3 << 3);                                                                         /* clear config */
-    prev |= source << 3;                                                                       /* set config */
-    res = a_bmp384_iic_spi_write(handle, BMP384_REG_FIFO_CONFIG_2, (uint8_t *)&prev, 1);       /* write config */
-    if (res != 0)                                                                              /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_LENGTH_0, (uint8_t *)buf, 2);       /* read config */
+    if (res != 0)                                                                           /* check result */
     {
-        handle->debug_print("bmp384: set fifo config 2 register failed.\n");                   /* set fifo config 2 register failed */
+        handle->debug_print("bmp384: get fifo length register failed.\n");                  /* get fifo length register failed */
        
-        return 1;                                                                              /* return error */
-    }   
+        return 1;                                                                           /* return error */
+    }
+    *length = ((uint16_t)(buf[1] & 0x01) << 8) | buf[0];                                    /* get data */
     
-    return 0;                                                                                  /* success return 0 */
+    return 0;                                                                               /* success return 0 */
 }
 
 /**
- * @brief      get the fifo data source
+ * @brief      get the fifo data
  * @param[in]  *handle pointer to a bmp384 handle structure
- * @param[out] *source pointer to fifo data source buffer
+ * @param[out] *data pointer to a data buffer
+ * @param[in]  length data buffer length
  * @return     status code
  *             - 0 success
- *             - 1 get fifo data source failed
+ *             - 1 get fifo data failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t bmp384_get_fifo_data_source(bmp384_handle_t *handle, bmp384_fifo_data_source_t *source)
+uint8_t bmp384_get_fifo_data(bmp384_handle_t *handle, uint8_t *data, uint16_t length)
 {
     uint8_t res;
-    uint8_t prev;
     
     if (handle == NULL)                                                                       /* check handle */
     {
@@ -1268,33 +1717,32 @@ uint8_t bmp384_get_fifo_data_source(bmp384_handle_t *handle, bmp384_fifo_data_so
         return 3;                                                                             /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_2, (uint8_t *)&prev, 1);       /* read config */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_DATA, (uint8_t *)data, length);       /* read data */
     if (res != 0)                                                                             /* check result */
     {
-        handle->debug_print("bmp384: get fifo config 2 register failed.\n");                  /* get fifo config 2 register failed */
+        handle->debug_print("bmp384: get fifo data register failed.\n");                      /* get fifo data register failed */
        
         return 1;                                                                             /* return error */
     }
-    *source = (bmp384_fifo_data_source_t)((prev >> 3) & 0x01);                                /* get config */
-
+    
     return 0;                                                                                 /* success return 0 */
 }
 
 /**
- * @brief     set the interrupt pin type
+ * @brief     set the fifo watermark
  * @param[in] *handle pointer to a bmp384 handle structure
- * @param[in] pin_type interrupt pin type
+ * @param[in] watermark fifo watermark
  * @return    status code
  *            - 0 success
- *            - 1 set interrupt pin type failed
+ *            - 1 set fifo watermark failed
  *            - 2 handle is NULL
- *            - 3 handle is not initialized
+ *            - 3 handle is not initialize
  * @note      none
  */
-uint8_t bmp384_set_interrupt_pin_type(bmp384_handle_t *handle, bmp384_interrupt_pin_type_t pin_type)
+uint8_t bmp384_set_fifo_watermark(bmp384_handle_t *handle, uint16_t watermark)
 {
     uint8_t res;
-    uint8_t prev;
+    uint8_t buf[2];
     
     if (handle == NULL)                                                                   /* check handle */
     {
@@ -1305,41 +1753,34 @@ uint8_t bmp384_set_interrupt_pin_type(bmp384_handle_t *handle, bmp384_interrupt_
         return 3;                                                                         /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);        /* read config */
-    if (res != 0)                                                                         /* check result */
-    {
-        handle->debug_print("bmp384: get int ctrl register failed.\n");                   /* get int ctrl register failed */
-       
-        return 1;                                                                         /* return error */
-    }   
-    prev &= ~(1 << 0);                                                                    /* clear config */
-    prev |= pin_type << 0;                                                                /* set config */
-    res = a_bmp384_iic_spi_write(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);       /* write config */
+    buf[0] = watermark & 0xFF;                                                            /* set low part */
+    buf[1] = (watermark >> 8) & 0x01;                                                     /* set high part */
+    res = a_bmp384_iic_spi_write(handle, BMP384_REG_FIFO_WTM_0, (uint8_t *)buf, 2);       /* write config */
     if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("bmp384: set int ctrl register failed.\n");                   /* set int ctrl register failed */
+        handle->debug_print("bmp384: set fifo watermark register failed.\n");             /* set fifo watermark register failed */
        
         return 1;                                                                         /* return error */
-    }   
+    }
     
     return 0;                                                                             /* success return 0 */
 }
 
 /**
- * @brief      get the interrupt pin type
+ * @brief      get the fifo watermark
  * @param[in]  *handle pointer to a bmp384 handle structure
- * @param[out] *pin_type pointer to an interrupt pin type buffer
+ * @param[out] *watermark pointer to a fifo watermark buffer
  * @return     status code
  *             - 0 success
- *             - 1 get interrupt pin type failed
+ *             - 1 get fifo watermark failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t bmp384_get_interrupt_pin_type(bmp384_handle_t *handle, bmp384_interrupt_pin_type_t *pin_type)
+uint8_t bmp384_get_fifo_watermark(bmp384_handle_t *handle, uint16_t *watermark)
 {
     uint8_t res;
-    uint8_t prev;
+    uint8_t buf[2];
     
     if (handle == NULL)                                                                  /* check handle */
     {
@@ -1350,686 +1791,692 @@ uint8_t bmp384_get_interrupt_pin_type(bmp384_handle_t *handle, bmp384_interrupt_
         return 3;                                                                        /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);       /* read config */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_WTM_0, (uint8_t *)buf, 2);       /* read config */
     if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("bmp384: get int ctrl register failed.\n");                  /* get int ctrl register failed */
+        handle->debug_print("bmp384: get fifo watermark register failed.\n");            /* get fifo watermark register failed */
        
         return 1;                                                                        /* return error */
     }
-    *pin_type = (bmp384_interrupt_pin_type_t)(prev & 0x01);                              /* get interrupt pin type */
+    *watermark = ((uint16_t)(buf[1] & 0x01) << 8) | buf[0];                              /* get data */
     
     return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief     set the interrupt active level
+ * @brief     enable or disable the fifo
  * @param[in] *handle pointer to a bmp384 handle structure
- * @param[in] level interrupt active level
+ * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set interrupt active level failed
+ *            - 1 set fifo failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t bmp384_set_interrupt_active_level(bmp384_handle_t *handle, bmp384_interrupt_active_level_t level)
+uint8_t bmp384_set_fifo(bmp384_handle_t *handle, bmp384_bool_t enable)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                   /* check handle */
+    if (handle == NULL)                                                                        /* check handle */
     {
-        return 2;                                                                         /* return error */
+        return 2;                                                                              /* return error */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if (handle->inited != 1)                                                                   /* check handle initialization */
     {
-        return 3;                                                                         /* return error */
+        return 3;                                                                              /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);        /* read config */
-    if (res != 0)                                                                         /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);        /* read config */
+    if (res != 0)                                                                              /* check result */
     {
-        handle->debug_print("bmp384: get int ctrl register failed.\n");                   /* get int ctrl register failed */
+        handle->debug_print("bmp384: get fifo config 1 register failed.\n");                   /* get fifo config 1 register failed */
        
-        return 1;                                                                         /* return error */
-    }   
-    prev &= ~(1 << 1);                                                                    /* clear config */
-    prev |= level << 1;                                                                   /* set config */
-    res = a_bmp384_iic_spi_write(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);       /* write config */
-    if (res != 0)                                                                         /* check result */
+        return 1;                                                                              /* return error */
+    }
+    prev &= ~(1 << 0);                                                                         /* clear config */
+    prev |= enable << 0;                                                                       /* set config */
+    res = a_bmp384_iic_spi_write(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);       /* write config */
+    if (res != 0)                                                                              /* check result */
     {
-        handle->debug_print("bmp384: set int ctrl register failed.\n");                   /* set int ctrl register failed */
+        handle->debug_print("bmp384: set fifo config 1 register failed.\n");                   /* set fifo config 1 register failed */
        
-        return 1;                                                                         /* return error */
+        return 1;                                                                              /* return error */
     }   
     
-    return 0;                                                                             /* success return 0 */
+    return 0;                                                                                  /* success return 0 */
 }
 
 /**
- * @brief      get the interrupt active level
+ * @brief      get the fifo status
  * @param[in]  *handle pointer to a bmp384 handle structure
- * @param[out] *level pointer to an interrupt active level buffer
+ * @param[out] *enable pointer to a bool buffer
  * @return     status code
  *             - 0 success
- *             - 1 get interrupt active level failed
+ *             - 1 get fifo failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t bmp384_get_interrupt_active_level(bmp384_handle_t *handle, bmp384_interrupt_active_level_t *level)
+uint8_t bmp384_get_fifo(bmp384_handle_t *handle, bmp384_bool_t *enable)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                  /* check handle */
+    if (handle == NULL)                                                                       /* check handle */
     {
-        return 2;                                                                        /* return error */
+        return 2;                                                                             /* return error */
     }
-    if (handle->inited != 1)                                                             /* check handle initialization */
+    if (handle->inited != 1)                                                                  /* check handle initialization */
     {
-        return 3;                                                                        /* return error */
+        return 3;                                                                             /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                        /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);       /* read config */
+    if (res != 0)                                                                             /* check result */
     {
-        handle->debug_print("bmp384: get int ctrl register failed.\n");                  /* get int ctrl register failed */
+        handle->debug_print("bmp384: get fifo config 1 register failed.\n");                  /* get fifo config 1 register failed */
        
-        return 1;                                                                        /* return error */
+        return 1;                                                                             /* return error */
     }
-    *level = (bmp384_interrupt_active_level_t)((prev >> 1) & 0x01);                      /* get config */
+    *enable = (bmp384_bool_t)(prev & 0x01);                                                   /* get config */
     
-    return 0;                                                                            /* success return 0 */
+    return 0;                                                                                 /* success return 0 */
 }
 
 /**
- * @brief     enable or disable latching interrupt pin and interrupt status
+ * @brief     enable or disable the fifo stopping on full
  * @param[in] *handle pointer to a bmp384 handle structure
  * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set latch interrupt pin and interrupt status failed
+ *            - 1 set fifo stop on full failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t bmp384_set_latch_interrupt_pin_and_interrupt_status(bmp384_handle_t *handle, bmp384_bool_t enable)
+uint8_t bmp384_set_fifo_stop_on_full(bmp384_handle_t *handle, bmp384_bool_t enable)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                   /* check handle */
+    if (handle == NULL)                                                                        /* check handle */
     {
-        return 2;                                                                         /* return error */
+        return 2;                                                                              /* return error */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if (handle->inited != 1)                                                                   /* check handle initialization */
     {
-        return 3;                                                                         /* return error */
+        return 3;                                                                              /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);        /* read config */
-    if (res != 0)                                                                         /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);        /* read config */
+    if (res != 0)                                                                              /* check result */
     {
-        handle->debug_print("bmp384: get int ctrl register failed.\n");                   /* get int ctrl register failed */
+        handle->debug_print("bmp384: get fifo config 1 register failed.\n");                   /* get fifo config 1 register failed */
        
-        return 1;                                                                         /* return error */
-    }   
-    prev &= ~(1 << 2);                                                                    /* clear config */
-    prev |= enable << 2;                                                                  /* set config */
-    res = a_bmp384_iic_spi_write(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);       /* write config */
-    if (res != 0)                                                                         /* check result */
+        return 1;                                                                              /* return error */
+    }
+    prev &= ~(1 << 1);                                                                         /* clear config */
+    prev |= enable << 1;                                                                       /* set config */
+    res = a_bmp384_iic_spi_write(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);       /* write config */
+    if (res != 0)                                                                              /* check result */
     {
-        handle->debug_print("bmp384: set int ctrl register failed.\n");                   /* set int ctrl register failed */
+        handle->debug_print("bmp384: set fifo config 1 register failed.\n");                   /* set fifo config 1 register failed */
        
-        return 1;                                                                         /* return error */
+        return 1;                                                                              /* return error */
     }   
     
-    return 0;                                                                             /* success return 0 */
+    return 0;                                                                                  /* success return 0 */
 }
 
 /**
- * @brief      get latching interrupt pin and interrupt status
+ * @brief      get the fifo stopping on full status
  * @param[in]  *handle pointer to a bmp384 handle structure
  * @param[out] *enable pointer to a bool buffer
  * @return     status code
  *             - 0 success
- *             - 1 get latch interrupt pin and interrupt status failed
+ *             - 1 get fifo stop on full failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t bmp384_get_latch_interrupt_pin_and_interrupt_status(bmp384_handle_t *handle, bmp384_bool_t *enable)
+uint8_t bmp384_get_fifo_stop_on_full(bmp384_handle_t *handle, bmp384_bool_t *enable)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                  /* check handle */
+    if (handle == NULL)                                                                       /* check handle */
     {
-        return 2;                                                                        /* return error */
+        return 2;                                                                             /* return error */
     }
-    if (handle->inited != 1)                                                             /* check handle initialization */
+    if (handle->inited != 1)                                                                  /* check handle initialization */
     {
-        return 3;                                                                        /* return error */
+        return 3;                                                                             /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                        /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);       /* read config */
+    if (res != 0)                                                                             /* check result */
     {
-        handle->debug_print("bmp384: get int ctrl register failed.\n");                  /* get int ctrl register failed */
-       
-        return 1;                                                                        /* return error */
-    }   
-    *enable = (bmp384_bool_t)((prev >> 2) & 0x01);                                       /* get config */
+        handle->debug_print("bmp384: get fifo config 1 register failed.\n");                  /* get fifo config 1 register failed */
+        
+        return 1;                                                                             /* return error */
+    }
+    *enable = (bmp384_bool_t)((prev >> 1) & 0x01);                                            /* get config */
     
-    return 0;                                                                            /* success return 0 */
+    return 0;                                                                                 /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the fifo watermark interrupt
+ * @brief     enable or disable the fifo sensor time on
  * @param[in] *handle pointer to a bmp384 handle structure
  * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set interrupt fifo watermark failed
+ *            - 1 set fifo sensor time on failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t bmp384_set_interrupt_fifo_watermark(bmp384_handle_t *handle, bmp384_bool_t enable)
+uint8_t bmp384_set_fifo_sensortime_on(bmp384_handle_t *handle, bmp384_bool_t enable)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                   /* check handle */
+    if (handle == NULL)                                                                        /* check handle */
     {
-        return 2;                                                                         /* return error */
+        return 2;                                                                              /* return error */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if (handle->inited != 1)                                                                   /* check handle initialization */
     {
-        return 3;                                                                         /* return error */
+        return 3;                                                                              /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);        /* read config */
-    if (res != 0)                                                                         /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);        /* read config */
+    if (res != 0)                                                                              /* check result */
     {
-        handle->debug_print("bmp384: get int ctrl register failed.\n");                   /* get int ctrl register failed */
+        handle->debug_print("bmp384: get fifo config 1 register failed.\n");                   /* get fifo config 1 register failed */
        
-        return 1;                                                                         /* return error */
-    }   
-    prev &= ~(1 << 3);                                                                    /* clear config */
-    prev |= enable << 3;                                                                  /* set config */
-    res = a_bmp384_iic_spi_write(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);       /* write config */
-    if (res != 0)                                                                         /* check result */
+        return 1;                                                                              /* return error */
+    }
+    prev &= ~(1 << 2);                                                                         /* clear config */
+    prev |= enable << 2;                                                                       /* set config */
+    res = a_bmp384_iic_spi_write(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);       /* write config */
+    if (res != 0)                                                                              /* check result */
     {
-        handle->debug_print("bmp384: set int ctrl register failed.\n");                   /* set int ctrl register failed */
+        handle->debug_print("bmp384: set fifo config 1 register failed.\n");                   /* set fifo config 1 register failed */
        
-        return 1;                                                                         /* return error */
+        return 1;                                                                              /* return error */
     }   
     
-    return 0;                                                                             /* success return 0 */
+    return 0;                                                                                  /* success return 0 */
 }
 
 /**
- * @brief      get the interrupt fifo watermark
+ * @brief      get the fifo sensor time on status
  * @param[in]  *handle pointer to a bmp384 handle structure
  * @param[out] *enable pointer to a bool buffer
  * @return     status code
  *             - 0 success
- *             - 1 get interrupt fifo watermark failed
+ *             - 1 get fifo sensor time on failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t bmp384_get_interrupt_fifo_watermark(bmp384_handle_t *handle, bmp384_bool_t *enable)
+uint8_t bmp384_get_fifo_sensortime_on(bmp384_handle_t *handle, bmp384_bool_t *enable)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                  /* check handle */
+    if (handle == NULL)                                                                       /* check handle */
     {
-        return 2;                                                                        /* return error */
+        return 2;                                                                             /* return error */
     }
-    if (handle->inited != 1)                                                             /* check handle initialization */
+    if (handle->inited != 1)                                                                  /* check handle initialization */
     {
-        return 3;                                                                        /* return error */
+        return 3;                                                                             /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                        /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);       /* read config */
+    if (res != 0)                                                                             /* check result */
     {
-        handle->debug_print("bmp384: get int ctrl register failed.\n");                  /* get int ctrl register failed */
+        handle->debug_print("bmp384: get fifo config 1 register failed.\n");                  /* get fifo config 1 register failed */
        
-        return 1;                                                                        /* return error */
-    }   
-    *enable = (bmp384_bool_t)((prev >> 3) & 0x01);                                       /* get config */
+        return 1;                                                                             /* return error */
+    }
+    *enable = (bmp384_bool_t)((prev >> 2) & 0x01);                                            /* get config */
     
-    return 0;                                                                            /* success return 0 */
+    return 0;                                                                                 /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the fifo full interrupt
+ * @brief     enable or disable the fifo pressure on
  * @param[in] *handle pointer to a bmp384 handle structure
  * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set interrupt fifo full failed
+ *            - 1 set fifo pressure on failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t bmp384_set_interrupt_fifo_full(bmp384_handle_t *handle, bmp384_bool_t enable)
+uint8_t bmp384_set_fifo_pressure_on(bmp384_handle_t *handle, bmp384_bool_t enable)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                   /* check handle */
+    if (handle == NULL)                                                                        /* check handle */
     {
-        return 2;                                                                         /* return error */
+        return 2;                                                                              /* return error */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if (handle->inited != 1)                                                                   /* check handle initialization */
     {
-        return 3;                                                                         /* return error */
+        return 3;                                                                              /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);        /* read config */
-    if (res != 0)                                                                         /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);        /* read config */
+    if (res != 0)                                                                              /* check result */
     {
-        handle->debug_print("bmp384: get int ctrl register failed.\n");                   /* get int ctrl register failed */
+        handle->debug_print("bmp384: get fifo config 1 register failed.\n");                   /* get fifo config 1 register failed */
        
-        return 1;                                                                         /* return error */
-    }   
-    prev &= ~(1 << 4);                                                                    /* clear config */
-    prev |= enable << 4;                                                                  /* set config */
-    res = a_bmp384_iic_spi_write(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);       /* write config */
-    if (res != 0)                                                                         /* check result */
+        return 1;                                                                              /* return error */
+    }
+    prev &= ~(1 << 3);                                                                         /* clear config */
+    prev |= enable << 3;                                                                       /* set config */
+    res = a_bmp384_iic_spi_write(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);       /* write config */
+    if (res != 0)                                                                              /* check result */
     {
-        handle->debug_print("bmp384: set int ctrl register failed.\n");                   /* set int ctrl register failed */
+        handle->debug_print("bmp384: set fifo config 1 register failed.\n");                   /* set fifo config 1 register failed */
        
-        return 1;                                                                         /* return error */
-    }   
+        return 1;                                                                              /* return error */
+    }
     
-    return 0;                                                                             /* success return 0 */
+    return 0;                                                                                  /* success return 0 */
 }
 
 /**
- * @brief      get the interrupt fifo full
+ * @brief      get the fifo pressure on status
  * @param[in]  *handle pointer to a bmp384 handle structure
  * @param[out] *enable pointer to a bool buffer
  * @return     status code
  *             - 0 success
- *             - 1 get interrupt fifo full failed
+ *             - 1 get fifo pressure on failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t bmp384_get_interrupt_fifo_full(bmp384_handle_t *handle, bmp384_bool_t *enable)
+uint8_t bmp384_get_fifo_pressure_on(bmp384_handle_t *handle, bmp384_bool_t *enable)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                  /* check handle */
+    if (handle == NULL)                                                                       /* check handle */
     {
-        return 2;                                                                        /* return error */
+        return 2;                                                                             /* return error */
     }
-    if (handle->inited != 1)                                                             /* check handle initialization */
+    if (handle->inited != 1)                                                                  /* check handle initialization */
     {
-        return 3;                                                                        /* return error */
+        return 3;                                                                             /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                        /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);       /* read config */
+    if (res != 0)                                                                             /* check result */
     {
-        handle->debug_print("bmp384: get int ctrl register failed.\n");                  /* get int ctrl register failed */
+        handle->debug_print("bmp384: get fifo config 1 register failed.\n");                  /* get fifo config 1 register failed */
        
-        return 1;                                                                        /* return error */
-    }   
-    *enable = (bmp384_bool_t)((prev >> 4) & 0x01);                                       /* get config */
+        return 1;                                                                             /* return error */
+    }
+    *enable = (bmp384_bool_t)((prev >> 3) & 0x01);                                            /* get config */
     
-    return 0;                                                                            /* success return 0 */
+    return 0;                                                                                 /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the data ready interrupt
+ * @brief     enable or disable the fifo temperature on
  * @param[in] *handle pointer to a bmp384 handle structure
  * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set interrupt data ready failed
+ *            - 1 set fifo temperature on failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t bmp384_set_interrupt_data_ready(bmp384_handle_t *handle, bmp384_bool_t enable)
+uint8_t bmp384_set_fifo_temperature_on(bmp384_handle_t *handle, bmp384_bool_t enable)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                   /* check handle */
+    if (handle == NULL)                                                                        /* check handle */
     {
-        return 2;                                                                         /* return error */
+        return 2;                                                                              /* return error */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if (handle->inited != 1)                                                                   /* check handle initialization */
     {
-        return 3;                                                                         /* return error */
+        return 3;                                                                              /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);        /* read config */
-    if (res != 0)                                                                         /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);        /* read config */
+    if (res != 0)                                                                              /* check result */
     {
-        handle->debug_print("bmp384: get int ctrl register failed.\n");                   /* get int ctrl register failed */
+        handle->debug_print("bmp384: get fifo config 1 register failed.\n");                   /* get fifo config 1 register failed */
        
-        return 1;                                                                         /* return error */
-    }   
-    prev &= ~(1 << 6);                                                                    /* clear config */
-    prev |= enable << 6;                                                                  /* set config */
-    res = a_bmp384_iic_spi_write(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);       /* write config */
-    if (res != 0)                                                                         /* check result */
+        return 1;                                                                              /* return error */
+    }
+    prev &= ~(1 << 4);                                                                         /* clear config */
+    prev |= enable << 4;                                                                       /* set config */
+    res = a_bmp384_iic_spi_write(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);       /* write config */
+    if (res != 0)                                                                              /* check result */
     {
-        handle->debug_print("bmp384: set int ctrl register failed.\n");                   /* set int ctrl register failed */
+        handle->debug_print("bmp384: set fifo config 1 register failed.\n");                   /* set fifo config 1 register failed */
        
-        return 1;                                                                         /* return error */
-    }
+        return 1;                                                                              /* return error */
+    }   
     
-    return 0;                                                                             /* success return 0 */
+    return 0;                                                                                  /* success return 0 */
 }
 
 /**
- * @brief      get the interrupt data ready status
+ * @brief      get the fifo temperature on status
  * @param[in]  *handle pointer to a bmp384 handle structure
  * @param[out] *enable pointer to a bool buffer
  * @return     status code
  *             - 0 success
- *             - 1 get interrupt data ready failed
+ *             - 1 get fifo temperature on failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t bmp384_get_interrupt_data_ready(bmp384_handle_t *handle, bmp384_bool_t *enable)
+uint8_t bmp384_get_fifo_temperature_on(bmp384_handle_t *handle, bmp384_bool_t *enable)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                  /* check handle */
+    if (handle == NULL)                                                                       /* check handle */
     {
-        return 2;                                                                        /* return error */
+        return 2;                                                                             /* return error */
     }
-    if (handle->inited != 1)                                                             /* check handle initialization */
+    if (handle->inited != 1)                                                                  /* check handle initialization */
     {
-        return 3;                                                                        /* return error */
+        return 3;                                                                             /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                        /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);       /* read config */
+    if (res != 0)                                                                             /* check result */
     {
-        handle->debug_print("bmp384: get int ctrl register failed.\n");                  /* get int ctrl register failed */
+        handle->debug_print("bmp384: get fifo config 1 register failed.\n");                  /* get fifo config 1 register failed */
        
-        return 1;                                                                        /* return error */
+        return 1;                                                                             /* return error */
     }
-    *enable = (bmp384_bool_t)((prev >> 6) & 0x01);                                       /* get config */
+    *enable = (bmp384_bool_t)((prev >> 4) & 0x01);                                            /* get config */
     
-    return 0;                                                                            /* success return 0 */
+    return 0;                                                                                 /* success return 0 */
 }
 
 /**
- * @brief     set the spi wire
+ * @brief     set the fifo subsampling
  * @param[in] *handle pointer to a bmp384 handle structure
- * @param[in] wire spi wire
+ * @param[in] subsample fifo subsample
  * @return    status code
  *            - 0 success
- *            - 1 set spi wire failed
+ *            - 1 set fifo subsampling failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      subsample <= 7
  */
-uint8_t bmp384_set_spi_wire(bmp384_handle_t *handle, bmp384_spi_wire_t wire)
+uint8_t bmp384_set_fifo_subsampling(bmp384_handle_t *handle, uint8_t subsample)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                  /* check handle */
+    if (handle == NULL)                                                                        /* check handle */
     {
-        return 2;                                                                        /* return error */
+        return 2;                                                                              /* return error */
     }
-    if (handle->inited != 1)                                                             /* check handle initialization */
+    if (handle->inited != 1)                                                                   /* check handle initialization */
     {
-        return 3;                                                                        /* return error */
+        return 3;                                                                              /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_IF_CONF, (uint8_t *)&prev, 1);        /* read config */
-    if (res != 0)                                                                        /* check result */
+    if (subsample > 7)                                                                         /* check subsample */
     {
-        handle->debug_print("bmp384: get if conf register failed.\n");                   /* get if conf register failed */
+        handle->debug_print("bmp384: subsample is invalid.\n");                                /* subsample is invalid */
        
-        return 1;                                                                        /* return error */
+        return 4;                                                                              /* return error */
     }
-    prev &= ~(1 << 0);                                                                   /* clear config */
-    prev |= wire << 0;                                                                   /* set config */
-    res = a_bmp384_iic_spi_write(handle, BMP384_REG_IF_CONF, (uint8_t *)&prev, 1);       /* write config */
-    if (res != 0)                                                                        /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_2, (uint8_t *)&prev, 1);        /* read config */
+    if (res != 0)                                                                              /* check result */
     {
-        handle->debug_print("bmp384: set if conf register failed.\n");                   /* set if conf register failed */
+        handle->debug_print("bmp384: get fifo config 2 register failed.\n");                   /* get fifo config 2 register failed */
        
-        return 1;                                                                        /* return error */
+        return 1;                                                                              /* return error */
     }
+    prev &= ~(7 << 0);                                                                         /* clear config */
+    prev |= subsample << 0;                                                                    /* set config */
+    res = a_bmp384_iic_spi_write(handle, BMP384_REG_FIFO_CONFIG_2, (uint8_t *)&prev, 1);       /* write config */
+    if (res != 0)                                                                              /* check result */
+    {
+        handle->debug_print("bmp384: set fifo config 2 register failed.\n");                   /* set fifo config 2 register failed */
+       
+        return 1;                                                                              /* return error */
+    }   
     
-    return 0;                                                                            /* success return 0 */
+    return 0;                                                                                  /* success return 0 */
 }
 
 /**
- * @brief      get the spi wire
+ * @brief      get the fifo subsampling
  * @param[in]  *handle pointer to a bmp384 handle structure
- * @param[out] *wire pointer to a spi wire buffer
+ * @param[out] *subsample pointer to subsample buffer
  * @return     status code
  *             - 0 success
- *             - 1 get spi wire failed
+ *             - 1 get fifo subsampling failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t bmp384_get_spi_wire(bmp384_handle_t *handle, bmp384_spi_wire_t *wire)
+uint8_t bmp384_get_fifo_subsampling(bmp384_handle_t *handle, uint8_t *subsample)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                 /* check handle */
+    if (handle == NULL)                                                                       /* check handle */
     {
-        return 2;                                                                       /* return error */
+        return 2;                                                                             /* return error */
     }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    if (handle->inited != 1)                                                                  /* check handle initialization */
     {
-        return 3;                                                                       /* return error */
+        return 3;                                                                             /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_IF_CONF, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                       /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_2, (uint8_t *)&prev, 1);       /* read config */
+    if (res != 0)                                                                             /* check result */
     {
-        handle->debug_print("bmp384: get if conf register failed.\n");                  /* get if conf register failed */
+        handle->debug_print("bmp384: get fifo config 2 register failed.\n");                  /* get fifo config 2 register failed */
        
-        return 1;                                                                       /* return error */
-    } 
-    *wire = (bmp384_spi_wire_t)(prev & 0x01);                                           /* get config */
+        return 1;                                                                             /* return error */
+    }
+    *subsample = (bmp384_bool_t)((prev >> 0) & 0x07);                                         /* get config */
     
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                                                 /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the iic watchdog timer
+ * @brief     set the fifo data source
  * @param[in] *handle pointer to a bmp384 handle structure
- * @param[in] enable bool value
+ * @param[in] source fifo data source
  * @return    status code
  *            - 0 success
- *            - 1 set iic watchdog timer failed
+ *            - 1 set fifo data source failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t bmp384_set_iic_watchdog_timer(bmp384_handle_t *handle, bmp384_bool_t enable)
+uint8_t bmp384_set_fifo_data_source(bmp384_handle_t *handle, bmp384_fifo_data_source_t source)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                  /* check handle */
+    if (handle == NULL)                                                                        /* check handle */
     {
-        return 2;                                                                        /* return error */
+        return 2;                                                                              /* return error */
     }
-    if (handle->inited != 1)                                                             /* check handle initialization */
+    if (handle->inited != 1)                                                                   /* check handle initialization */
     {
-        return 3;                                                                        /* return error */
+        return 3;                                                                              /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_IF_CONF, (uint8_t *)&prev, 1);        /* read config */
-    if (res != 0)                                                                        /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_2, (uint8_t *)&prev, 1);        /* read config */
+    if (res != 0)                                                                              /* check result */
     {
-        handle->debug_print("bmp384: get if conf register failed.\n");                   /* get if conf register failed */
+        handle->debug_print("bmp384: get fifo config 2 register failed.\n");                   /* get fifo config 2 register failed */
        
-        return 1;                                                                        /* return error */
-    }
-    prev &= ~(1 << 1);                                                                   /* clear config */
-    prev |= enable << 1;                                                                 /* set config */
-    res = a_bmp384_iic_spi_write(handle, BMP384_REG_IF_CONF, (uint8_t *)&prev, 1);       /* write config */
-    if (res != 0)                                                                        /* check result */
+        return 1;                                                                              /* return error */
+    }   
+    prev &= ~(3 << 3);                                                                         /* clear config */
+    prev |= source << 3;                                                                       /* set config */
+    res = a_bmp384_iic_spi_write(handle, BMP384_REG_FIFO_CONFIG_2, (uint8_t *)&prev, 1);       /* write config */
+    if (res != 0)                                                                              /* check result */
     {
-        handle->debug_print("bmp384: set if conf register failed.\n");                   /* set if conf register failed */
+        handle->debug_print("bmp384: set fifo config 2 register failed.\n");                   /* set fifo config 2 register failed */
        
-        return 1;                                                                        /* return error */
-    }
+        return 1;                                                                              /* return error */
+    }   
     
-    return 0;                                                                            /* success return 0 */
+    return 0;                                                                                  /* success return 0 */
 }
 
 /**
- * @brief      get the iic watchdog timer status
+ * @brief      get the fifo data source
  * @param[in]  *handle pointer to a bmp384 handle structure
- * @param[out] *enable pointer to a bool buffer
+ * @param[out] *source pointer to fifo data source buffer
  * @return     status code
  *             - 0 success
- *             - 1 get iic watchdog timer failed
+ *             - 1 get fifo data source failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t bmp384_get_iic_watchdog_timer(bmp384_handle_t *handle, bmp384_bool_t *enable)
+uint8_t bmp384_get_fifo_data_source(bmp384_handle_t *handle, bmp384_fifo_data_source_t *source)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                 /* check handle */
+    if (handle == NULL)                                                                       /* check handle */
     {
-        return 2;                                                                       /* return error */
+        return 2;                                                                             /* return error */
     }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    if (handle->inited != 1)                                                                  /* check handle initialization */
     {
-        return 3;                                                                       /* return error */
+        return 3;                                                                             /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_IF_CONF, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                       /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_2, (uint8_t *)&prev, 1);       /* read config */
+    if (res != 0)                                                                             /* check result */
     {
-        handle->debug_print("bmp384: get if conf register failed.\n");                  /* get if conf register failed */
+        handle->debug_print("bmp384: get fifo config 2 register failed.\n");                  /* get fifo config 2 register failed */
        
-        return 1;                                                                       /* return error */
-    } 
-    *enable = (bmp384_bool_t)((prev >> 1) & 0x01);                                      /* get config */
-    
-    return 0;                                                                           /* success return 0 */
+        return 1;                                                                             /* return error */
+    }
+    *source = (bmp384_fifo_data_source_t)((prev >> 3) & 0x01);                                /* get config */
+
+    return 0;                                                                                 /* success return 0 */
 }
 
 /**
- * @brief     set the iic watchdog period
+ * @brief     set the interrupt pin type
  * @param[in] *handle pointer to a bmp384 handle structure
- * @param[in] period iic watchdog period
+ * @param[in] pin_type interrupt pin type
  * @return    status code
  *            - 0 success
- *            - 1 set iic watchdog period failed
+ *            - 1 set interrupt pin type failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t bmp384_set_iic_watchdog_period(bmp384_handle_t *handle, bmp384_iic_watchdog_period_t period)
+uint8_t bmp384_set_interrupt_pin_type(bmp384_handle_t *handle, bmp384_interrupt_pin_type_t pin_type)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                  /* check handle */
+    if (handle == NULL)                                                                   /* check handle */
     {
-        return 2;                                                                        /* return error */
+        return 2;                                                                         /* return error */
     }
-    if (handle->inited != 1)                                                             /* check handle initialization */
+    if (handle->inited != 1)                                                              /* check handle initialization */
     {
-        return 3;                                                                        /* return error */
+        return 3;                                                                         /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_IF_CONF, (uint8_t *)&prev, 1);        /* read config */
-    if (res != 0)                                                                        /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);        /* read config */
+    if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("bmp384: get if conf register failed.\n");                   /* get if conf register failed */
+        handle->debug_print("bmp384: get int ctrl register failed.\n");                   /* get int ctrl register failed */
        
-        return 1;                                                                        /* return error */
-    }
-    prev &= ~(1 << 2);                                                                   /* clear config */
-    prev |= period << 2;                                                                 /* set config */
-    res = a_bmp384_iic_spi_write(handle, BMP384_REG_IF_CONF, (uint8_t *)&prev, 1);       /* write config */
-    if (res != 0)                                                                        /* check result */
+        return 1;                                                                         /* return error */
+    }   
+    prev &= ~(1 << 0);                                                                    /* clear config */
+    prev |= pin_type << 0;                                                                /* set config */
+    res = a_bmp384_iic_spi_write(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);       /* write config */
+    if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("bmp384: set if conf register failed.\n");                   /* set if conf register failed */
+        handle->debug_print("bmp384: set int ctrl register failed.\n");                   /* set int ctrl register failed */
        
-        return 1;                                                                        /* return error */
-    }
+        return 1;                                                                         /* return error */
+    }   
     
-    return 0;                                                                            /* success return 0 */
+    return 0;                                                                             /* success return 0 */
 }
 
 /**
- * @brief      get the iic watchdog period
+ * @brief      get the interrupt pin type
  * @param[in]  *handle pointer to a bmp384 handle structure
- * @param[out] *period pointer to an iic watchdog period buffer
+ * @param[out] *pin_type pointer to an interrupt pin type buffer
  * @return     status code
  *             - 0 success
- *             - 1 get iic watchdog period failed
+ *             - 1 get interrupt pin type failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t bmp384_get_iic_watchdog_period(bmp384_handle_t *handle, bmp384_iic_watchdog_period_t *period)
+uint8_t bmp384_get_interrupt_pin_type(bmp384_handle_t *handle, bmp384_interrupt_pin_type_t *pin_type)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                 /* check handle */
+    if (handle == NULL)                                                                  /* check handle */
     {
-        return 2;                                                                       /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    if (handle->inited != 1)                                                             /* check handle initialization */
     {
-        return 3;                                                                       /* return error */
+        return 3;                                                                        /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_IF_CONF, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                       /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);       /* read config */
+    if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("bmp384: get if conf register failed.\n");                  /* get if conf register failed */
+        handle->debug_print("bmp384: get int ctrl register failed.\n");                  /* get int ctrl register failed */
        
-        return 1;                                                                       /* return error */
-    } 
-    *period = (bmp384_iic_watchdog_period_t)((prev >> 2) & 0x01);                       /* get config */
+        return 1;                                                                        /* return error */
+    }
+    *pin_type = (bmp384_interrupt_pin_type_t)(prev & 0x01);                              /* get interrupt pin type */
     
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the pressure
+ * @brief     set the interrupt active level
  * @param[in] *handle pointer to a bmp384 handle structure
- * @param[in] enable bool value
+ * @param[in] level interrupt active level
  * @return    status code
  *            - 0 success
- *            - 1 set pressure failed
+ *            - 1 set interrupt active level failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t bmp384_set_pressure(bmp384_handle_t *handle, bmp384_bool_t enable)
+uint8_t bmp384_set_interrupt_active_level(bmp384_handle_t *handle, bmp384_interrupt_active_level_t level)
 {
     uint8_t res;
     uint8_t prev;
@@ -2043,38 +2490,38 @@ uint8_t bmp384_set_pressure(bmp384_handle_t *handle, bmp384_bool_t enable)
         return 3;                                                                         /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);        /* read config */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);        /* read config */
     if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("bmp384: get pwr ctrl register failed.\n");                   /* get pwr ctrl register failed */
+        handle->debug_print("bmp384: get int ctrl register failed.\n");                   /* get int ctrl register failed */
        
         return 1;                                                                         /* return error */
-    }
-    prev &= ~(1 << 0);                                                                    /* clear config */
-    prev |= enable << 0;                                                                  /* set config */
-    res = a_bmp384_iic_spi_write(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);       /* write config */
+    }   
+    prev &= ~(1 << 1);                                                                    /* clear config */
+    prev |= level << 1;                                                                   /* set config */
+    res = a_bmp384_iic_spi_write(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);       /* write config */
     if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("bmp384: set pwr ctrl register failed.\n");                   /* set pwr ctrl register failed */
+        handle->debug_print("bmp384: set int ctrl register failed.\n");                   /* set int ctrl register failed */
        
         return 1;                                                                         /* return error */
-    }
+    }   
     
     return 0;                                                                             /* success return 0 */
 }
 
 /**
- * @brief      get the pressure status
+ * @brief      get the interrupt active level
  * @param[in]  *handle pointer to a bmp384 handle structure
- * @param[out] *enable pointer to a bool buffer
+ * @param[out] *level pointer to an interrupt active level buffer
  * @return     status code
  *             - 0 success
- *             - 1 get pressure failed
+ *             - 1 get interrupt active level failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t bmp384_get_pressure(bmp384_handle_t *handle, bmp384_bool_t *enable)
+uint8_t bmp384_get_interrupt_active_level(bmp384_handle_t *handle, bmp384_interrupt_active_level_t *level)
 {
     uint8_t res;
     uint8_t prev;
@@ -2088,30 +2535,30 @@ uint8_t bmp384_get_pressure(bmp384_handle_t *handle, bmp384_bool_t *enable)
         return 3;                                                                        /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);       /* read config */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);       /* read config */
     if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("bmp384: get pwr ctrl register failed.\n");                  /* get pwr ctrl register failed */
+        handle->debug_print("bmp384: get int ctrl register failed.\n");                  /* get int ctrl register failed */
        
         return 1;                                                                        /* return error */
-    }  
-    *enable = (bmp384_bool_t)((prev >> 0) & 0x01);                                       /* get config */
+    }
+    *level = (bmp384_interrupt_active_level_t)((prev >> 1) & 0x01);                      /* get config */
     
     return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the temperature
+ * @brief     enable or disable latching interrupt pin and interrupt status
  * @param[in] *handle pointer to a bmp384 handle structure
  * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set temperature failed
+ *            - 1 set latch interrupt pin and interrupt status failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t bmp384_set_temperature(bmp384_handle_t *handle, bmp384_bool_t enable)
+uint8_t bmp384_set_latch_interrupt_pin_and_interrupt_status(bmp384_handle_t *handle, bmp384_bool_t enable)
 {
     uint8_t res;
     uint8_t prev;
@@ -2125,38 +2572,38 @@ uint8_t bmp384_set_temperature(bmp384_handle_t *handle, bmp384_bool_t enable)
         return 3;                                                                         /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);        /* read config */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);        /* read config */
     if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("bmp384: get pwr ctrl register failed.\n");                   /* get pwr ctrl register failed */
+        handle->debug_print("bmp384: get int ctrl register failed.\n");                   /* get int ctrl register failed */
        
         return 1;                                                                         /* return error */
-    }
-    prev &= ~(1 << 1);                                                                    /* clear config */
-    prev |= enable << 1;                                                                  /* set config */
-    res = a_bmp384_iic_spi_write(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);       /* write config */
+    }   
+    prev &= ~(1 << 2);                                                                    /* clear config */
+    prev |= enable << 2;                                                                  /* set config */
+    res = a_bmp384_iic_spi_write(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);       /* write config */
     if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("bmp384: set pwr ctrl register failed.\n");                   /* set pwr ctrl register failed */
+        handle->debug_print("bmp384: set int ctrl register failed.\n");                   /* set int ctrl register failed */
        
         return 1;                                                                         /* return error */
-    }
+    }   
     
     return 0;                                                                             /* success return 0 */
 }
 
 /**
- * @brief      get the temperature status
+ * @brief      get latching interrupt pin and interrupt status
  * @param[in]  *handle pointer to a bmp384 handle structure
  * @param[out] *enable pointer to a bool buffer
  * @return     status code
  *             - 0 success
- *             - 1 get temperature failed
+ *             - 1 get latch interrupt pin and interrupt status failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t bmp384_get_temperature(bmp384_handle_t *handle, bmp384_bool_t *enable)
+uint8_t bmp384_get_latch_interrupt_pin_and_interrupt_status(bmp384_handle_t *handle, bmp384_bool_t *enable)
 {
     uint8_t res;
     uint8_t prev;
@@ -2170,30 +2617,30 @@ uint8_t bmp384_get_temperature(bmp384_handle_t *handle, bmp384_bool_t *enable)
         return 3;                                                                        /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);       /* read config */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);       /* read config */
     if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("bmp384: get pwr ctrl register failed.\n");                  /* get pwr ctrl register failed */
+        handle->debug_print("bmp384: get int ctrl register failed.\n");                  /* get int ctrl register failed */
        
         return 1;                                                                        /* return error */
-    }  
-    *enable = (bmp384_bool_t)((prev >> 1) & 0x01);                                       /* get config */
+    }   
+    *enable = (bmp384_bool_t)((prev >> 2) & 0x01);                                       /* get config */
     
     return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief     set the chip mode
+ * @brief     enable or disable the fifo watermark interrupt
  * @param[in] *handle pointer to a bmp384 handle structure
- * @param[in] mode chip mode
+ * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set mode failed
+ *            - 1 set interrupt fifo watermark failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t bmp384_set_mode(bmp384_handle_t *handle, bmp384_mode_t mode)
+uint8_t bmp384_set_interrupt_fifo_watermark(bmp384_handle_t *handle, bmp384_bool_t enable)
 {
     uint8_t res;
     uint8_t prev;
@@ -2207,38 +2654,38 @@ uint8_t bmp384_set_mode(bmp384_handle_t *handle, bmp384_mode_t mode)
         return 3;                                                                         /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);        /* read config */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);        /* read config */
     if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("bmp384: get pwr ctrl register failed.\n");                   /* get pwr ctrl register failed */
+        handle->debug_print("bmp384: get int ctrl register failed.\n");                   /* get int ctrl register failed */
        
         return 1;                                                                         /* return error */
-    }
-    prev &= ~(3 << 4);                                                                    /* clear config */
-    prev |= mode << 4;                                                                    /* set config */
-    res = a_bmp384_iic_spi_write(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);       /* write config */
+    }   
+    prev &= ~(1 << 3);                                                                    /* clear config */
+    prev |= enable << 3;                                                                  /* set config */
+    res = a_bmp384_iic_spi_write(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);       /* write config */
     if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("bmp384: set pwr ctrl register failed.\n");                   /* set pwr ctrl register failed */
+        handle->debug_print("bmp384: set int ctrl register failed.\n");                   /* set int ctrl register failed */
        
         return 1;                                                                         /* return error */
-    }
+    }   
     
     return 0;                                                                             /* success return 0 */
 }
 
 /**
- * @brief      get the chip mode
+ * @brief      get the interrupt fifo watermark
  * @param[in]  *handle pointer to a bmp384 handle structure
- * @param[out] *mode pointer to a mode buffer
+ * @param[out] *enable pointer to a bool buffer
  * @return     status code
  *             - 0 success
- *             - 1 get mode failed
+ *             - 1 get interrupt fifo watermark failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t bmp384_get_mode(bmp384_handle_t *handle, bmp384_mode_t *mode)
+uint8_t bmp384_get_interrupt_fifo_watermark(bmp384_handle_t *handle, bmp384_bool_t *enable)
 {
     uint8_t res;
     uint8_t prev;
@@ -2252,1435 +2699,3759 @@ uint8_t bmp384_get_mode(bmp384_handle_t *handle, bmp384_mode_t *mode)
         return 3;                                                                        /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);       /* read config */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);       /* read config */
     if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("bmp384: get pwr ctrl register failed.\n");                  /* get pwr ctrl register failed */
+        handle->debug_print("bmp384: get int ctrl register failed.\n");                  /* get int ctrl register failed */
        
         return 1;                                                                        /* return error */
-    }
-    *mode = (bmp384_mode_t)((prev >> 4) & 0x03);                                         /* get config */
+    }   
+    *enable = (bmp384_bool_t)((prev >> 3) & 0x01);                                       /* get config */
     
     return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief     set the pressure oversampling
+ * @brief     enable or disable the fifo full interrupt
  * @param[in] *handle pointer to a bmp384 handle structure
- * @param[in] oversampling pressure oversampling
+ * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set pressure oversampling failed
+ *            - 1 set interrupt fifo full failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t bmp384_set_pressure_oversampling(bmp384_handle_t *handle, bmp384_oversampling_t oversampling)
+uint8_t bmp384_set_interrupt_fifo_full(bmp384_handle_t *handle, bmp384_bool_t enable)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                              /* check handle */
+    if (handle == NULL)                                                                   /* check handle */
     {
-        return 2;                                                                    /* return error */
+        return 2;                                                                         /* return error */
     }
-    if (handle->inited != 1)                                                         /* check handle initialization */
+    if (handle->inited != 1)                                                              /* check handle initialization */
     {
-        return 3;                                                                    /* return error */
+        return 3;                                                                         /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_OSR, (uint8_t *)&prev, 1);        /* read config */
-    if (res != 0)                                                                    /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);        /* read config */
+    if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("bmp384: get osr register failed.\n");                   /* get osr register failed */
+        handle->debug_print("bmp384: get int ctrl register failed.\n");                   /* get int ctrl register failed */
        
-        return 1;                                                                    /* return error */
-    }
-    prev &= ~(7 << 0);                                                               /* clear config */
-    prev |= oversampling << 0;                                                       /* set config */
-    res = a_bmp384_iic_spi_write(handle, BMP384_REG_OSR, (uint8_t *)&prev, 1);       /* write config */
-    if (res != 0)                                                                    /* check result */
+        return 1;                                                                         /* return error */
+    }   
+    prev &= ~(1 << 4);                                                                    /* clear config */
+    prev |= enable << 4;                                                                  /* set config */
+    res = a_bmp384_iic_spi_write(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);       /* write config */
+    if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("bmp384: set osr register failed.\n");                   /* set osr register failed */
+        handle->debug_print("bmp384: set int ctrl register failed.\n");                   /* set int ctrl register failed */
        
-        return 1;                                                                    /* return error */
-    }
+        return 1;                                                                         /* return error */
+    }   
     
-    return 0;                                                                        /* success return 0 */
+    return 0;                                                                             /* success return 0 */
 }
 
 /**
- * @brief      get the pressure oversampling
+ * @brief      get the interrupt fifo full
  * @param[in]  *handle pointer to a bmp384 handle structure
- * @param[out] *oversampling pointer to an oversampling buffer
+ * @param[out] *enable pointer to a bool buffer
  * @return     status code
  *             - 0 success
- *             - 1 get pressure oversampling failed
+ *             - 1 get interrupt fifo full failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t bmp384_get_pressure_oversampling(bmp384_handle_t *handle, bmp384_oversampling_t *oversampling)
+uint8_t bmp384_get_interrupt_fifo_full(bmp384_handle_t *handle, bmp384_bool_t *enable)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                             /* check handle */
+    if (handle == NULL)                                                                  /* check handle */
     {
-        return 2;                                                                   /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                        /* check handle initialization */
+    if (handle->inited != 1)                                                             /* check handle initialization */
     {
-        return 3;                                                                   /* return error */
+        return 3;                                                                        /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_OSR, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                   /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);       /* read config */
+    if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("bmp384: get osr register failed.\n");                  /* get osr register failed */
+        handle->debug_print("bmp384: get int ctrl register failed.\n");                  /* get int ctrl register failed */
        
-        return 1;                                                                   /* return error */
-    }
-    *oversampling = (bmp384_oversampling_t)((prev >> 0) & 0x07);                    /* get config */
+        return 1;                                                                        /* return error */
+    }   
+    *enable = (bmp384_bool_t)((prev >> 4) & 0x01);                                       /* get config */
     
-    return 0;                                                                       /* success return 0 */
+    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief     set the temperature oversampling
+ * @brief     enable or disable the data ready interrupt
  * @param[in] *handle pointer to a bmp384 handle structure
- * @param[in] oversampling temperature oversampling
+ * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set temperature oversampling failed
+ *            - 1 set interrupt data ready failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t bmp384_set_temperature_oversampling(bmp384_handle_t *handle, bmp384_oversampling_t oversampling)
+uint8_t bmp384_set_interrupt_data_ready(bmp384_handle_t *handle, bmp384_bool_t enable)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                              /* check handle */
+    if (handle == NULL)                                                                   /* check handle */
     {
-        return 2;                                                                    /* return error */
+        return 2;                                                                         /* return error */
     }
-    if (handle->inited != 1)                                                         /* check handle initialization */
+    if (handle->inited != 1)                                                              /* check handle initialization */
     {
-        return 3;                                                                    /* return error */
+        return 3;                                                                         /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_OSR, (uint8_t *)&prev, 1);        /* read config */
-    if (res != 0)                                                                    /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);        /* read config */
+    if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("bmp384: get osr register failed.\n");                   /* get osr register failed */
+        handle->debug_print("bmp384: get int ctrl register failed.\n");                   /* get int ctrl register failed */
        
-        return 1;                                                                    /* return error */
-    }
-    prev &= ~(7 << 3);                                                               /* clear config */
-    prev |= oversampling << 3;                                                       /* set config */
-    res = a_bmp384_iic_spi_write(handle, BMP384_REG_OSR, (uint8_t *)&prev, 1);       /* write config */
-    if (res != 0)                                                                    /* check result */
+        return 1;                                                                         /* return error */
+    }   
+    prev &= ~(1 << 6);                                                                    /* clear config */
+    prev |= enable << 6;                                                                  /* set config */
+    res = a_bmp384_iic_spi_write(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);       /* write config */
+    if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("bmp384: set osr register failed.\n");                   /* set osr register failed */
+        handle->debug_print("bmp384: set int ctrl register failed.\n");                   /* set int ctrl register failed */
        
-        return 1;                                                                    /* return error */
+        return 1;                                                                         /* return error */
     }
     
-    return 0;                                                                        /* success return 0 */
+    return 0;                                                                             /* success return 0 */
 }
 
 /**
- * @brief      get the temperature oversampling
+ * @brief      get the interrupt data ready status
  * @param[in]  *handle pointer to a bmp384 handle structure
- * @param[out] *oversampling pointer to an oversampling buffer
+ * @param[out] *enable pointer to a bool buffer
  * @return     status code
  *             - 0 success
- *             - 1 get temperature oversampling failed
+ *             - 1 get interrupt data ready failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t bmp384_get_temperature_oversampling(bmp384_handle_t *handle, bmp384_oversampling_t *oversampling)
+uint8_t bmp384_get_interrupt_data_ready(bmp384_handle_t *handle, bmp384_bool_t *enable)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                             /* check handle */
+    if (handle == NULL)                                                                  /* check handle */
     {
-        return 2;                                                                   /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                        /* check handle initialization */
+    if (handle->inited != 1)                                                             /* check handle initialization */
     {
-        return 3;                                                                   /* return error */
+        return 3;                                                                        /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_OSR, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                   /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_INT_CTRL, (uint8_t *)&prev, 1);       /* read config */
+    if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("bmp384: get osr register failed.\n");                  /* get osr register failed */
+        handle->debug_print("bmp384: get int ctrl register failed.\n");                  /* get int ctrl register failed */
        
-        return 1;                                                                   /* return error */
+        return 1;                                                                        /* return error */
     }
-    *oversampling = (bmp384_oversampling_t)((prev >> 3) & 0x07);                    /* get config */
+    *enable = (bmp384_bool_t)((prev >> 6) & 0x01);                                       /* get config */
     
-    return 0;                                                                       /* success return 0 */
+    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief     set the output data rate
+ * @brief     set the spi wire
  * @param[in] *handle pointer to a bmp384 handle structure
- * @param[in] odr output data rate
+ * @param[in] wire spi wire
  * @return    status code
  *            - 0 success
- *            - 1 set odr failed
+ *            - 1 set spi wire failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t bmp384_set_odr(bmp384_handle_t *handle, bmp384_odr_t odr)
+uint8_t bmp384_set_spi_wire(bmp384_handle_t *handle, bmp384_spi_wire_t wire)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                              /* check handle */
+    if (handle == NULL)                                                                  /* check handle */
     {
-        return 2;                                                                    /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                         /* check handle initialization */
+    if (handle->inited != 1)                                                             /* check handle initialization */
     {
-        return 3;                                                                    /* return error */
+        return 3;                                                                        /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_ODR, (uint8_t *)&prev, 1);        /* read config */
-    if (res != 0)                                                                    /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_IF_CONF, (uint8_t *)&prev, 1);        /* read config */
+    if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("bmp384: get odr register failed.\n");                   /* get odr register failed */
+        handle->debug_print("bmp384: get if conf register failed.\n");                   /* get if conf register failed */
        
-        return 1;                                                                    /* return error */
+        return 1;                                                                        /* return error */
     }
-    
-    prev &= ~(31 << 0);                                                              /* clear config */
-    prev |= odr << 0;                                                                /* set config */
-    res = a_bmp384_iic_spi_write(handle, BMP384_REG_ODR, (uint8_t *)&prev, 1);       /* write config */
-    if (res != 0)                                                                    /* check result */
+    prev &= ~(1 << 0);                                                                   /* clear config */
+    prev |= wire << 0;                                                                   /* set config */
+    res = a_bmp384_iic_spi_write(handle, BMP384_REG_IF_CONF, (uint8_t *)&prev, 1);       /* write config */
+    if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("bmp384: set odr register failed.\n");                   /* set odr register failed */
+        handle->debug_print("bmp384: set if conf register failed.\n");                   /* set if conf register failed */
        
-        return 1;                                                                    /* return error */
+        return 1;                                                                        /* return error */
     }
     
-    return 0;                                                                        /* success return 0 */
+    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief      get the output data rate
+ * @brief      get the spi wire
  * @param[in]  *handle pointer to a bmp384 handle structure
- * @param[out] *odr pointer to an output data rate buffer
+ * @param[out] *wire pointer to a spi wire buffer
  * @return     status code
  *             - 0 success
- *             - 1 get odr failed
+ *             - 1 get spi wire failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t bmp384_get_odr(bmp384_handle_t *handle, bmp384_odr_t *odr)
+uint8_t bmp384_get_spi_wire(bmp384_handle_t *handle, bmp384_spi_wire_t *wire)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                             /* check handle */
+    if (handle == NULL)                                                                 /* check handle */
     {
-        return 2;                                                                   /* return error */
+        return 2;                                                                       /* return error */
     }
-    if (handle->inited != 1)                                                        /* check handle initialization */
+    if (handle->inited != 1)                                                            /* check handle initialization */
     {
-        return 3;                                                                   /* return error */
+        return 3;                                                                       /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_ODR, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                   /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_IF_CONF, (uint8_t *)&prev, 1);       /* read config */
+    if (res != 0)                                                                       /* check result */
     {
-        handle->debug_print("bmp384: get odr register failed.\n");                  /* get odr register failed */
+        handle->debug_print("bmp384: get if conf register failed.\n");                  /* get if conf register failed */
        
-        return 1;                                                                   /* return error */
-    }
-    *odr = (bmp384_odr_t)((prev >> 0) & 31);                                        /* get config */
+        return 1;                                                                       /* return error */
+    } 
+    *wire = (bmp384_spi_wire_t)(prev & 0x01);                                           /* get config */
     
-    return 0;                                                                       /* success return 0 */
+    return 0;                                                                           /* success return 0 */
 }
 
 /**
- * @brief     set the filter coefficient
+ * @brief     enable or disable the iic watchdog timer
  * @param[in] *handle pointer to a bmp384 handle structure
- * @param[in] coefficient filter coefficient
+ * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set filter coefficient failed
+ *            - 1 set iic watchdog timer failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t bmp384_set_filter_coefficient(bmp384_handle_t *handle, bmp384_filter_coefficient_t coefficient)
+uint8_t bmp384_set_iic_watchdog_timer(bmp384_handle_t *handle, bmp384_bool_t enable)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                 /* check handle */
+    if (handle == NULL)                                                                  /* check handle */
     {
-        return 2;                                                                       /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    if (handle->inited != 1)                                                             /* check handle initialization */
     {
-        return 3;                                                                       /* return error */
+        return 3;                                                                        /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_CONFIG, (uint8_t *)&prev, 1);        /* read config */
-    if (res != 0)                                                                       /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_IF_CONF, (uint8_t *)&prev, 1);        /* read config */
+    if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("bmp384: get config register failed.\n");                   /* get config register failed */
+        handle->debug_print("bmp384: get if conf register failed.\n");                   /* get if conf register failed */
        
-        return 1;                                                                       /* return error */
+        return 1;                                                                        /* return error */
     }
-    
-    prev &= ~(0x7 << 1);                                                                /* clear config */
-    prev |= coefficient << 1;                                                           /* set config */
-    res = a_bmp384_iic_spi_write(handle, BMP384_REG_CONFIG, (uint8_t *)&prev, 1);       /* write config */
-    if (res != 0)                                                                       /* check result */
+    prev &= ~(1 << 1);                                                                   /* clear config */
+    prev |= enable << 1;                                                                 /* set config */
+    res = a_bmp384_iic_spi_write(handle, BMP384_REG_IF_CONF, (uint8_t *)&prev, 1);       /* write config */
+    if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("bmp384: set config register failed.\n");                   /* set config register failed */
+        handle->debug_print("bmp384: set if conf register failed.\n");                   /* set if conf register failed */
        
-        return 1;                                                                       /* return error */
+        return 1;                                                                        /* return error */
     }
     
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief      get the filter coefficient
+ * @brief      get the iic watchdog timer status
  * @param[in]  *handle pointer to a bmp384 handle structure
- * @param[out] *coefficient pointer to a filter coefficient buffer
+ * @param[out] *enable pointer to a bool buffer
  * @return     status code
  *             - 0 success
- *             - 1 get filter coefficient failed
+ *             - 1 get iic watchdog timer failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t bmp384_get_filter_coefficient(bmp384_handle_t *handle, bmp384_filter_coefficient_t *coefficient)
+uint8_t bmp384_get_iic_watchdog_timer(bmp384_handle_t *handle, bmp384_bool_t *enable)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                /* check handle */
+    if (handle == NULL)                                                                 /* check handle */
     {
-        return 2;                                                                      /* return error */
+        return 2;                                                                       /* return error */
     }
-    if (handle->inited != 1)                                                           /* check handle initialization */
+    if (handle->inited != 1)                                                            /* check handle initialization */
     {
-        return 3;                                                                      /* return error */
+        return 3;                                                                       /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_CONFIG, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                      /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_IF_CONF, (uint8_t *)&prev, 1);       /* read config */
+    if (res != 0)                                                                       /* check result */
     {
-        handle->debug_print("bmp384: get config register failed.\n");                  /* return error */
+        handle->debug_print("bmp384: get if conf register failed.\n");                  /* get if conf register failed */
        
-        return 1;                                                                      /* return error */
-    }
-    *coefficient = (bmp384_filter_coefficient_t)((prev >> 1) & 0x07);                  /* get coefficient */
+        return 1;                                                                       /* return error */
+    } 
+    *enable = (bmp384_bool_t)((prev >> 1) & 0x01);                                      /* get config */
     
-    return 0;                                                                          /* success return 0 */
+    return 0;                                                                           /* success return 0 */
 }
 
 /**
- * @brief     flush the fifo
+ * @brief     set the iic watchdog period
  * @param[in] *handle pointer to a bmp384 handle structure
+ * @param[in] period iic watchdog period
  * @return    status code
  *            - 0 success
- *            - 1 flush fifo failed
+ *            - 1 set iic watchdog period failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t bmp384_flush_fifo(bmp384_handle_t *handle)
+uint8_t bmp384_set_iic_watchdog_period(bmp384_handle_t *handle, bmp384_iic_watchdog_period_t period)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                              /* check handle */
+    if (handle == NULL)                                                                  /* check handle */
     {
-        return 2;                                                                    /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->inited != 1)                                                         /* check handle initialization */
+    if (handle->inited != 1)                                                             /* check handle initialization */
     {
-        return 3;                                                                    /* return error */
+        return 3;                                                                        /* return error */
     }
     
-    prev = 0xB0;                                                                     /* command */
-    res = a_bmp384_iic_spi_write(handle, BMP384_REG_CMD, (uint8_t *)&prev, 1);       /* write config */
-    if (res != 0)                                                                    /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_IF_CONF, (uint8_t *)&prev, 1);        /* read config */
+    if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("bmp384: set cmd register failed.\n");                   /* set cmd register failed */
+        handle->debug_print("bmp384: get if conf register failed.\n");                   /* get if conf register failed */
        
-        return 1;                                                                    /* return error */
+        return 1;                                                                        /* return error */
     }
-    
-    return 0;                                                                        /* success return 0 */
-}
-
-/**
- * @brief     soft reset
- * @param[in] *handle pointer to a bmp384 handle structure
- * @return    status code
- *            - 0 success
- *            - 1 soft reset failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+    prev &= ~(1 << 2);                                                                   /* clear config */
+    prev |= period << 2;                                                                 /* set config */
+    res = a_bmp384_iic_spi_write(handle, BMP384_REG_IF_CONF, (uint8_t *)&prev, 1);       /* write config */
+    if (res != 0)                                                                        /* check result */
+    {
+        handle->debug_print("bmp384: set if conf register failed.\n");                   /* set if conf register failed */
+       
+        return 1;                                                                        /* return error */
+    }
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief      get the iic watchdog period
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *period pointer to an iic watchdog period buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get iic watchdog period failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
  */
-uint8_t bmp384_softreset(bmp384_handle_t *handle)
+uint8_t bmp384_get_iic_watchdog_period(bmp384_handle_t *handle, bmp384_iic_watchdog_period_t *period)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                              /* check handle */
+    if (handle == NULL)                                                                 /* check handle */
     {
-        return 2;                                                                    /* return error */
+        return 2;                                                                       /* return error */
     }
-    if (handle->inited != 1)                                                         /* check handle initialization */
+    if (handle->inited != 1)                                                            /* check handle initialization */
     {
-        return 3;                                                                    /* return error */
+        return 3;                                                                       /* return error */
     }
     
-    prev = 0xB6;                                                                     /* command */
-    res = a_bmp384_iic_spi_write(handle, BMP384_REG_CMD, (uint8_t *)&prev, 1);       /* write config */
-    if (res != 0)                                                                    /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_IF_CONF, (uint8_t *)&prev, 1);       /* read config */
+    if (res != 0)                                                                       /* check result */
     {
-        handle->debug_print("bmp384: set cmd register failed.\n");                   /* set cmd register failed */
+        handle->debug_print("bmp384: get if conf register failed.\n");                  /* get if conf register failed */
        
-        return 1;                                                                    /* return error */
-    }
+        return 1;                                                                       /* return error */
+    } 
+    *period = (bmp384_iic_watchdog_period_t)((prev >> 2) & 0x01);                       /* get config */
     
-    return 0;                                                                        /* success return 0 */
+    return 0;                                                                           /* success return 0 */
 }
 
 /**
- * @brief     extmode enable middle
+ * @brief     enable or disable the pressure
  * @param[in] *handle pointer to a bmp384 handle structure
+ * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 extmode enable middle failed
+ *            - 1 set pressure failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t bmp384_extmode_en_middle(bmp384_handle_t *handle)
+uint8_t bmp384_set_pressure(bmp384_handle_t *handle, bmp384_bool_t enable)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                              /* check handle */
+    if (handle == NULL)                                                                   /* check handle */
     {
-        return 2;                                                                    /* return error */
+        return 2;                                                                         /* return error */
     }
-    if (handle->inited != 1)                                                         /* check handle initialization */
+    if (handle->inited != 1)                                                              /* check handle initialization */
     {
-        return 3;                                                                    /* return error */
+        return 3;                                                                         /* return error */
     }
     
-    prev = 0x34;                                                                     /* command */
-    res = a_bmp384_iic_spi_write(handle, BMP384_REG_CMD, (uint8_t *)&prev, 1);       /* write config */
-    if (res != 0)                                                                    /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);        /* read config */
+    if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("bmp384: set cmd register failed.\n");                   /* set cmd register failed */
+        handle->debug_print("bmp384: get pwr ctrl register failed.\n");                   /* get pwr ctrl register failed */
        
-        return 1;                                                                    /* return error */
+        return 1;                                                                         /* return error */
+    }
+    prev &= ~(1 << 0);                                                                    /* clear config */
+    prev |= enable << 0;                                                                  /* set config */
+    res = a_bmp384_iic_spi_write(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);       /* write config */
+    if (res != 0)                                                                         /* check result */
+    {
+        handle->debug_print("bmp384: set pwr ctrl register failed.\n");                   /* set pwr ctrl register failed */
+       
+        return 1;                                                                         /* return error */
     }
     
-    return 0;                                                                        /* success return 0 */
+    return 0;                                                                             /* success return 0 */
 }
 
 /**
- * @brief     close the chip
- * @param[in] *handle pointer to a bmp384 handle structure
- * @return    status code
- *            - 0 success
- *            - 1 close failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      get the pressure status
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *enable pointer to a bool buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get pressure failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
  */
-static uint8_t a_bmp384_close(bmp384_handle_t *handle)
+uint8_t bmp384_get_pressure(bmp384_handle_t *handle, bmp384_bool_t *enable)
 {
-    if (handle->iic_spi == BMP384_INTERFACE_IIC)                        /* if iic interface */
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                                  /* check handle */
     {
-        if (handle->iic_deinit() != 0)                                  /* close iic */
-        {
-            handle->debug_print("bmp384: iic deinit failed.\n");        /* iic deinit failed */
-       
-            return 1;                                                   /* return error */
-        }
-        else
-        {
-            return 0;                                                   /* success return 0 */
-        }
+        return 2;                                                                        /* return error */
     }
-    else
+    if (handle->inited != 1)                                                             /* check handle initialization */
     {
-        if (handle->spi_deinit() != 0)                                  /* close spi */
-        {
-            handle->debug_print("bmp384: spi deinit failed.\n");        /* spi deinit failed */
-       
-            return 1;                                                   /* return error */
-        }
-        else
-        {
-            return 0;                                                   /* success return 0 */
-        }
+        return 3;                                                                        /* return error */
     }
+    
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);       /* read config */
+    if (res != 0)                                                                        /* check result */
+    {
+        handle->debug_print("bmp384: get pwr ctrl register failed.\n");                  /* get pwr ctrl register failed */
+       
+        return 1;                                                                        /* return error */
+    }  
+    *enable = (bmp384_bool_t)((prev >> 0) & 0x01);                                       /* get config */
+    
+    return 0;                                                                            /* success return 0 */
 }
 
 /**
- * @brief     initialize the chip
+ * @brief     enable or disable the temperature
  * @param[in] *handle pointer to a bmp384 handle structure
+ * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 iic or spi initialization failed
+ *            - 1 set temperature failed
  *            - 2 handle is NULL
- *            - 3 linked functions is NULL
- *            - 4 id is invalid
- *            - 5 reset failed
- *            - 6 get calibration failed
+ *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t bmp384_init(bmp384_handle_t *handle)
+uint8_t bmp384_set_temperature(bmp384_handle_t *handle, bmp384_bool_t enable)
 {
-    uint8_t id;
-    uint8_t reg;
-  
-    if (handle == NULL)                                                              /* check handle */
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                                   /* check handle */
     {
-        return 2;                                                                    /* return error */
+        return 2;                                                                         /* return error */
     }
-    if (handle->debug_print == NULL)                                                 /* check debug_print */
+    if (handle->inited != 1)                                                              /* check handle initialization */
     {
-        return 3;                                                                    /* return error */
+        return 3;                                                                         /* return error */
     }
-    if (handle->iic_init == NULL)                                                    /* check iic_init */
+    
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);        /* read config */
+    if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("bmp384: iic_init is null.\n");                          /* iic_init is null */
+        handle->debug_print("bmp384: get pwr ctrl register failed.\n");                   /* get pwr ctrl register failed */
        
-        return 3;                                                                    /* return error */
+        return 1;                                                                         /* return error */
     }
-    if (handle->iic_deinit == NULL)                                                  /* check iic_init */
+    prev &= ~(1 << 1);                                                                    /* clear config */
+    prev |= enable << 1;                                                                  /* set config */
+    res = a_bmp384_iic_spi_write(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);       /* write config */
+    if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("bmp384: iic_deinit is null.\n");                        /* iic_deinit is null */
+        handle->debug_print("bmp384: set pwr ctrl register failed.\n");                   /* set pwr ctrl register failed */
        
-        return 3;                                                                    /* return error */
+        return 1;                                                                         /* return error */
     }
-    if (handle->iic_read == NULL)                                                    /* check iic_read */
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief      get the temperature status
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *enable pointer to a bool buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get temperature failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t bmp384_get_temperature(bmp384_handle_t *handle, bmp384_bool_t *enable)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                                  /* check handle */
     {
-        handle->debug_print("bmp384: iic_read is null.\n");                          /* iic_read is null */
-       
-        return 3;                                                                    /* return error */
+        return 2;                                                                        /* return error */
     }
-    if (handle->iic_write == NULL)                                                   /* check iic_write */
+    if (handle->inited != 1)                                                             /* check handle initialization */
     {
-        handle->debug_print("bmp384: iic_write is null.\n");                         /* iic_write is null */
-       
-        return 3;                                                                    /* return error */
+        return 3;                                                                        /* return error */
     }
-    if (handle->spi_init == NULL)                                                    /* check spi_init */
+    
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);       /* read config */
+    if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("bmp384: spi_init is null.\n");                          /* spi_init is null */
+        handle->debug_print("bmp384: get pwr ctrl register failed.\n");                  /* get pwr ctrl register failed */
        
-        return 3;                                                                    /* return error */
-    }
-    if (handle->spi_deinit == NULL)                                                  /* check spi_deinit */
+        return 1;                                                                        /* return error */
+    }  
+    *enable = (bmp384_bool_t)((prev >> 1) & 0x01);                                       /* get config */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     set the chip mode
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @param[in] mode chip mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 set mode failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t bmp384_set_mode(bmp384_handle_t *handle, bmp384_mode_t mode)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                                   /* check handle */
     {
-        handle->debug_print("bmp384: spi_deinit is null.\n");                        /* spi_deinit is null */
-       
-        return 3;                                                                    /* return error */
+        return 2;                                                                         /* return error */
     }
-    if (handle->spi_read == NULL)                                                    /* check spi_read */
+    if (handle->inited != 1)                                                              /* check handle initialization */
     {
-        handle->debug_print("bmp384: spi_read is null.\n");                          /* spi_read is null */
-       
-        return 3;                                                                    /* return error */
+        return 3;                                                                         /* return error */
     }
-    if (handle->spi_write == NULL)                                                   /* check spi_write */
+    
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);        /* read config */
+    if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("bmp384: spi_write is null.\n");                         /* spi_write is null */
+        handle->debug_print("bmp384: get pwr ctrl register failed.\n");                   /* get pwr ctrl register failed */
        
-        return 3;                                                                    /* return error */
+        return 1;                                                                         /* return error */
     }
-    if (handle->delay_ms == NULL)                                                    /* check delay_ms */
+    prev &= ~(3 << 4);                                                                    /* clear config */
+    prev |= mode << 4;                                                                    /* set config */
+    res = a_bmp384_iic_spi_write(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);       /* write config */
+    if (res != 0)                                                                         /* check result */
     {
-        handle->debug_print("bmp384: delay_ms is null.\n");                          /* delay_ms is null */
+        handle->debug_print("bmp384: set pwr ctrl register failed.\n");                   /* set pwr ctrl register failed */
        
-        return 3;                                                                    /* return error */
+        return 1;                                                                         /* return error */
     }
     
-    if (handle->iic_spi == BMP384_INTERFACE_IIC)                                     /* if iic interface */
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief      get the chip mode
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *mode pointer to a mode buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get mode failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t bmp384_get_mode(bmp384_handle_t *handle, bmp384_mode_t *mode)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                                  /* check handle */
     {
-        if (handle->iic_init() != 0)                                                 /* initialize iic bus */
-        {
-            handle->debug_print("bmp384: iic init failed.\n");                       /* iic init failed */
-            
-            return 1;                                                                /* return error */
-        }
+        return 2;                                                                        /* return error */
     }
-    else
+    if (handle->inited != 1)                                                             /* check handle initialization */
     {
-        if (handle->spi_init() != 0)                                                 /* initialize spi bus */
-        {
-            handle->debug_print("bmp384: spi init failed.\n");                       /* spi init failed */
-           
-            return 1;                                                                /* return error */
-        }
+        return 3;                                                                        /* return error */
     }
-    if (a_bmp384_iic_spi_read(handle, BMP384_REG_CHIP_ID, (uint8_t *)&id, 1) != 0)   /* read chip id */
+    
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);       /* read config */
+    if (res != 0)                                                                        /* check result */
     {
-        handle->debug_print("bmp384: read chip id failed.\n");                       /* read chip id failed */
-        (void)a_bmp384_close(handle);                                                /* close bmp384 */
-        
-        return 4;                                                                    /* return error */
+        handle->debug_print("bmp384: get pwr ctrl register failed.\n");                  /* get pwr ctrl register failed */
+       
+        return 1;                                                                        /* return error */
     }
-    if (id != 0x50)                                                                  /* check chip id */
-    {
-        handle->debug_print("bmp384: id is invalid.\n");                             /* id is invalid */
-        (void)a_bmp384_close(handle);                                                /* close bmp384 */
-        
-        return 4;         
-    }                                                                                /* return error */
-    reg = 0xB6;                                                                      /* set command */
-    if (a_bmp384_iic_spi_write(handle, BMP384_REG_CMD, (uint8_t *)&reg, 1) != 0)     /* write command */
+    *mode = (bmp384_mode_t)((prev >> 4) & 0x03);                                         /* get config */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     set the pressure oversampling
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @param[in] oversampling pressure oversampling
+ * @return    status code
+ *            - 0 success
+ *            - 1 set pressure oversampling failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t bmp384_set_pressure_oversampling(bmp384_handle_t *handle, bmp384_oversampling_t oversampling)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                              /* check handle */
     {
-        handle->debug_print("bmp384: soft rest failed.\n");                          /* soft rest failed */
-        (void)a_bmp384_close(handle);                                                /* close bmp384 */
-        
-        return 5;                                                                    /* return error */
+        return 2;                                                                    /* return error */
     }
-    handle->delay_ms(10);                                                            /* delay 10 ms */
-    if (a_bmp384_iic_spi_read(handle, BMP384_REG_ERR_REG, (uint8_t *)&reg, 1) != 0)  /* read reg */
+    if (handle->inited != 1)                                                         /* check handle initialization */
     {
-        handle->debug_print("bmp384: get err reg failed.\n");                        /* return error */
-        (void)a_bmp384_close(handle);                                                /* close bmp384 */
-        
-        return 5;                                                                    /* return error */
+        return 3;                                                                    /* return error */
     }
-    if ((reg & 0x07) != 0)                                                           /* check running status */
+    
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_OSR, (uint8_t *)&prev, 1);        /* read config */
+    if (res != 0)                                                                    /* check result */
     {
-        handle->debug_print("bmp384: find running error.\n");                        /* find running error */
-        (void)a_bmp384_close(handle);                                                /* close bmp384 */
-        
-        return 5;                                                                    /* return error */
+        handle->debug_print("bmp384: get osr register failed.\n");                   /* get osr register failed */
+       
+        return 1;                                                                    /* return error */
     }
-    if (a_bmp384_get_calibration_data(handle) != 0)                                  /* get calibration data */
+    prev &= ~(7 << 0);                                                               /* clear config */
+    prev |= oversampling << 0;                                                       /* set config */
+    res = a_bmp384_iic_spi_write(handle, BMP384_REG_OSR, (uint8_t *)&prev, 1);       /* write config */
+    if (res != 0)                                                                    /* check result */
     {
-        handle->debug_print("bmp384: get calibration data error.\n");                /* get calibration data error */
-        (void)a_bmp384_close(handle);                                                /* close bmp384 */
-        
-        return 6;                                                                    /* return error */
+        handle->debug_print("bmp384: set osr register failed.\n");                   /* set osr register failed */
+       
+        return 1;                                                                    /* return error */
     }
-    handle->inited = 1;                                                              /* flag finish initialization */
-     
+    
     return 0;                                                                        /* success return 0 */
 }
 
 /**
- * @brief     close the chip
+ * @brief      get the pressure oversampling
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *oversampling pointer to an oversampling buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get pressure oversampling failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t bmp384_get_pressure_oversampling(bmp384_handle_t *handle, bmp384_oversampling_t *oversampling)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                             /* check handle */
+    {
+        return 2;                                                                   /* return error */
+    }
+    if (handle->inited != 1)                                                        /* check handle initialization */
+    {
+        return 3;                                                                   /* return error */
+    }
+    
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_OSR, (uint8_t *)&prev, 1);       /* read config */
+    if (res != 0)                                                                   /* check result */
+    {
+        handle->debug_print("bmp384: get osr register failed.\n");                  /* get osr register failed */
+       
+        return 1;                                                                   /* return error */
+    }
+    *oversampling = (bmp384_oversampling_t)((prev >> 0) & 0x07);                    /* get config */
+    
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief     set the temperature oversampling
  * @param[in] *handle pointer to a bmp384 handle structure
+ * @param[in] oversampling temperature oversampling
  * @return    status code
  *            - 0 success
- *            - 1 iic or spi deinit failed
+ *            - 1 set temperature oversampling failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- *            - 4 power down failed
  * @note      none
  */
-uint8_t bmp384_deinit(bmp384_handle_t *handle)
+uint8_t bmp384_set_temperature_oversampling(bmp384_handle_t *handle, bmp384_oversampling_t oversampling)
 {
     uint8_t res;
     uint8_t prev;
     
-    if (handle == NULL)                                                                   /* check handle */
+    if (handle == NULL)                                                              /* check handle */
     {
-        return 2;                                                                         /* return error */
+        return 2;                                                                    /* return error */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if (handle->inited != 1)                                                         /* check handle initialization */
     {
-        return 3;                                                                         /* return error */
+        return 3;                                                                    /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);        /* read config */
-    if (res != 0)                                                                         /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_OSR, (uint8_t *)&prev, 1);        /* read config */
+    if (res != 0)                                                                    /* check result */
     {
-        handle->debug_print("bmp384: get pwr ctrl register failed.\n");                   /* get pwr ctrl register failed */
+        handle->debug_print("bmp384: get osr register failed.\n");                   /* get osr register failed */
        
-        return 4;                                                                         /* return error */
+        return 1;                                                                    /* return error */
     }
-    prev &= ~(3 << 0);                                                                    /* clear config */
-    prev &= ~(3 << 4);                                                                    /* set config */
-    res = a_bmp384_iic_spi_write(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);       /* write config */
-    if (res != 0)                                                                         /* check result */
+    prev &= ~(7 << 3);                                                               /* clear config */
+    prev |= oversampling << 3;                                                       /* set config */
+    res = a_bmp384_iic_spi_write(handle, BMP384_REG_OSR, (uint8_t *)&prev, 1);       /* write config */
+    if (res != 0)                                                                    /* check result */
     {
-        handle->debug_print("bmp384: set pwr ctrl register failed.\n");                   /* set pwr ctrl register failed */
+        handle->debug_print("bmp384: set osr register failed.\n");                   /* set osr register failed */
        
-        return 4;                                                                         /* return error */
-    }
-    if (a_bmp384_close(handle) != 0)                                                      /* close bmp384 */
-    {
-        return 1;                                                                         /* return error */
+        return 1;                                                                    /* return error */
     }
-    else
-    {
-        handle->inited = 0;                                                               /* flag close */
     
-        return 0;                                                                         /* success return 0 */
-    }
+    return 0;                                                                        /* success return 0 */
 }
 
 /**
- * @brief      read the temperature
+ * @brief      get the temperature oversampling
  * @param[in]  *handle pointer to a bmp384 handle structure
- * @param[out] *raw pointer to a raw temperature buffer
- * @param[out] *c pointer to a converted temperature buffer
+ * @param[out] *oversampling pointer to an oversampling buffer
  * @return     status code
  *             - 0 success
- *             - 1 read temperature failed
+ *             - 1 get temperature oversampling failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t bmp384_read_temperature(bmp384_handle_t *handle, uint32_t *raw, float *c)
+uint8_t bmp384_get_temperature_oversampling(bmp384_handle_t *handle, bmp384_oversampling_t *oversampling)
 {
     uint8_t res;
     uint8_t prev;
-    uint8_t buf[3];
     
-    if (handle == NULL)                                                                       /* check handle */
+    if (handle == NULL)                                                             /* check handle */
     {
-        return 2;                                                                             /* return error */
+        return 2;                                                                   /* return error */
     }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
+    if (handle->inited != 1)                                                        /* check handle initialization */
     {
-        return 3;                                                                             /* return error */
+        return 3;                                                                   /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                             /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_OSR, (uint8_t *)&prev, 1);       /* read config */
+    if (res != 0)                                                                   /* check result */
     {
-        handle->debug_print("bmp384: get fifo config 1 register failed.\n");                  /* get fifo config 1 register failed */
+        handle->debug_print("bmp384: get osr register failed.\n");                  /* get osr register failed */
        
-        return 1;                                                                             /* return error */
+        return 1;                                                                   /* return error */
     }
-    if ((prev & 0x01) != 0)                                                                   /* check mode */
+    *oversampling = (bmp384_oversampling_t)((prev >> 3) & 0x07);                    /* get config */
+    
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief     set the output data rate
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @param[in] odr output data rate
+ * @return    status code
+ *            - 0 success
+ *            - 1 set odr failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t bmp384_set_odr(bmp384_handle_t *handle, bmp384_odr_t odr)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                              /* check handle */
     {
-        handle->debug_print("bmp384: fifo mode can't use this function.\n");                  /* fifo mode can't use this function */
-       
-        return 1;                                                                             /* return error */
+        return 2;                                                                    /* return error */
     }
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);            /* read pwr ctrl */
-    if (res != 0)                                                                             /* check result */
-    {
-        handle->debug_print("bmp384: get pwr ctrl register failed.\n");                       /* get pwr ctrl register failed */
-       
-        return 1;                                                                             /* return error */
-    } 
-    if (((prev >> 4) & 0x03) == 0x03)                                                         /* normal mode */
+    if (handle->inited != 1)                                                         /* check handle initialization */
     {
-        res = a_bmp384_iic_spi_read(handle, BMP384_REG_STATUS, (uint8_t *)&prev, 1);          /* read config */
-        if (res != 0)                                                                         /* check result */
-        {
-            handle->debug_print("bmp384: get status register failed.\n");                     /* get status register failed */
-           
-            return 1;                                                                         /* return error */
-        }
-        if ((prev & (1 << 6)) != 0)                                                           /* data is ready */
-        {
-            int64_t output;
-            
-            res = a_bmp384_iic_spi_read(handle, BMP384_REG_DATA_3, (uint8_t *)buf, 3);        /* read raw data */
-            if (res != 0)                                                                     /* check result */
-            {
-                handle->debug_print("bmp384: get data register failed.\n");                   /* get data register failed */
-               
-                return 1;                                                                     /* return error */
-            }
-            *raw = (uint32_t)buf[2] << 16 | (uint32_t)buf[1] << 8 | buf[0];                   /* get data */
-            output = a_bmp384_compensate_temperature(handle, *raw);                           /* compensate temperature */
-            *c = (float)((double)output / 100.0);                                             /* get converted temperature */
-            
-            return 0;                                                                         /* success return 0 */
-            
-        }
-        else
-        {
-            handle->debug_print("bmp384: temperature data is not ready.\n");                  /* temperature data is not ready */
-           
-            return 1;                                                                         /* return error */
-        }            
+        return 3;                                                                    /* return error */
     }
-    else if (((prev >> 4) & 0x03) == 0x00)                                                    /* force mode */
+    
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_ODR, (uint8_t *)&prev, 1);        /* read config */
+    if (res != 0)                                                                    /* check result */
     {
-        uint16_t cnt = 5000;
-        
-        res = a_bmp384_iic_spi_read(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);        /* read config */
-        if (res != 0)                                                                         /* check result */
-        {
-            handle->debug_print("bmp384: get pwr ctrl register failed.\n");                   /* get pwr ctrl register failed */
-           
-            return 1;                                                                         /* return error */
-        }
-        prev &= ~(0x03 << 4);                                                                 /* clear 4-5 bits */
-        prev |= 0x01 << 4;                                                                    /* set bit 4 */
-        res = a_bmp384_iic_spi_write(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);       /* read config */
-        if (res != 0)                                                                         /* check result */
-        {
-            handle->debug_print("bmp384: set pwr ctrl register failed.\n");                   /* set pwr ctrl register failed */
-           
-            return 1;                                                                         /* return error */
-        }
-        
-        while (1)                                                                             /* loop */
-        {
-            res = a_bmp384_iic_spi_read(handle, BMP384_REG_STATUS, (uint8_t *)&prev, 1);      /* read status */
-            if (res != 0)                                                                     /* check result */
-            {
-                handle->debug_print("bmp384: get status register failed.\n");                 /* get status register failed */
-               
-                return 1;                                                                     /* return error */
-            }
-            if ((prev & (1 << 6)) != 0)                                                       /* data is ready */
-            {
-                int64_t output;
-                
-                res = a_bmp384_iic_spi_read(handle, BMP384_REG_DATA_3, (uint8_t *)buf, 3);    /* read raw data */
-                if (res != 0)                                                                 /* check result */
-                {
-                    handle->debug_print("bmp384: get data register failed.\n");               /* get data register failed */
-                   
-                    return 1;                                                                 /* return error */
-                }
-                *raw = (uint32_t)buf[2] << 16 | (uint32_t)buf[1] << 8 | buf[0];               /* get data */
-                output = a_bmp384_compensate_temperature(handle, *raw);                       /* compensate temperature */
-                *c = (float)((double)output / 100.0);                                         /* get converted temperature */
-                
-                return 0;                                                                     /* success return 0 */
-                
-            }
-            else
-            {
-                if (cnt != 0)                                                                 /* check cnt */
-                {
-                    cnt--;                                                                    /* cnt-- */
-                    handle->delay_ms(1);                                                      /* delay 1 ms */
-                    
-                    continue;                                                                 /* continue */
-                }
-                handle->debug_print("bmp384: temperature data is not ready.\n");              /* temperature data is not ready */
-               
-                return 1;                                                                     /* return error */
-            }
-        }
+        handle->debug_print("bmp384: get odr register failed.\n");                   /* get odr register failed */
+       
+        return 1;                                                                    /* return error */
     }
-    else
+    
+    prev &= ~(31 << 0);                                                              /* clear config */
+    prev |= odr << 0;                                                                /* set config */
+    res = a_bmp384_iic_spi_write(handle, BMP384_REG_ODR, (uint8_t *)&prev, 1);       /* write config */
+    if (res != 0)                                                                    /* check result */
     {
-        handle->debug_print("bmp384: mode is invalid.\n");                                    /* mode is invalid */
-           
-        return 1;                                                                             /* return error */
+        handle->debug_print("bmp384: set odr register failed.\n");                   /* set odr register failed */
+       
+        return 1;                                                                    /* return error */
     }
+    
+    return 0;                                                                        /* success return 0 */
 }
 
 /**
- * @brief      read the pressure
+ * @brief      get the output data rate
  * @param[in]  *handle pointer to a bmp384 handle structure
- * @param[out] *raw pointer to a raw pressure buffer
- * @param[out] *pa pointer to a converted pressure buffer
+ * @param[out] *odr pointer to an output data rate buffer
  * @return     status code
  *             - 0 success
- *             - 1 read pressure failed
+ *             - 1 get odr failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t bmp384_read_pressure(bmp384_handle_t *handle, uint32_t *raw, float *pa)
+uint8_t bmp384_get_odr(bmp384_handle_t *handle, bmp384_odr_t *odr)
 {
     uint8_t res;
     uint8_t prev;
-    uint8_t buf[3];
-    uint32_t temperature_raw;
     
-    if (handle == NULL)                                                                       /* check handle */
+    if (handle == NULL)                                                             /* check handle */
     {
-        return 2;                                                                             /* return error */
+        return 2;                                                                   /* return error */
     }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
+    if (handle->inited != 1)                                                        /* check handle initialization */
     {
-        return 3;                                                                             /* return error */
+        return 3;                                                                   /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                             /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_ODR, (uint8_t *)&prev, 1);       /* read config */
+    if (res != 0)                                                                   /* check result */
     {
-        handle->debug_print("bmp384: get fifo config 1 register failed.\n");                  /* get fifo config 1 register failed */
+        handle->debug_print("bmp384: get odr register failed.\n");                  /* get odr register failed */
        
-        return 1;                                                                             /* return error */
+        return 1;                                                                   /* return error */
     }
-    if ((prev & 0x01) != 0)                                                                   /* check mode */
+    *odr = (bmp384_odr_t)((prev >> 0) & 31);                                        /* get config */
+    
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief     set the filter coefficient
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @param[in] coefficient filter coefficient
+ * @return    status code
+ *            - 0 success
+ *            - 1 set filter coefficient failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t bmp384_set_filter_coefficient(bmp384_handle_t *handle, bmp384_filter_coefficient_t coefficient)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                                 /* check handle */
     {
-        handle->debug_print("bmp384: fifo mode can't use this function.\n");                  /* fifo mode can't use this function */
-       
-        return 1;                                                                             /* return error */
+        return 2;                                                                       /* return error */
     }
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);            /* read config */
-    if (res != 0)                                                                             /* check result */
+    if (handle->inited != 1)                                                            /* check handle initialization */
     {
-        handle->debug_print("bmp384: get pwr ctrl register failed.\n");                       /* get pwr ctrl register failed */
-       
-        return 1;                                                                             /* return error */
+        return 3;                                                                       /* return error */
     }
-    if (((prev >> 4) & 0x03) == 0x03)                                                         /* normal mode */
+    
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_CONFIG, (uint8_t *)&prev, 1);        /* read config */
+    if (res != 0)                                                                       /* check result */
     {
-        res = a_bmp384_iic_spi_read(handle, BMP384_REG_STATUS, (uint8_t *)&prev, 1);          /* read status */
-        if (res != 0)                                                                         /* check result */
-        {
-            handle->debug_print("bmp384: get status register failed.\n");                     /* get status register failed */
-           
-            return 1;                                                                         /* return error */
-        }
-        if ((prev & (1 << 6)) != 0)                                                           /* data is ready */
-        {
-            res = a_bmp384_iic_spi_read(handle, BMP384_REG_DATA_3, (uint8_t *)buf, 3);        /* read config */
-            if (res != 0)                                                                     /* check result */
-            {
-                handle->debug_print("bmp384: get data register failed.\n");                   /* get data register failed */
-               
-                return 1;                                                                     /* return error */
-            }
-            temperature_raw= (uint32_t)buf[2] << 16 | (uint32_t)buf[1] << 8 | buf[0];         /* get data */
-            (void)a_bmp384_compensate_temperature(handle, temperature_raw);                   /* compensate temperature */
-        }
-        else
-        {
-            handle->debug_print("bmp384: temperature data is not ready.\n");                  /* temperature data is not ready */
-           
-            return 1;                                                                         /* return error */
-        }
-        if ((prev & (1 << 5)) != 0)                                                           /* data is ready */
-        {
-            int64_t output;
-            
-            res = a_bmp384_iic_spi_read(handle, BMP384_REG_DATA_0, (uint8_t *)buf, 3);        /* read config */
-            if (res != 0)                                                                     /* check result */
-            {
-                handle->debug_print("bmp384: get data register failed.\n");                   /* get data register failed */
-               
-                return 1;                                                                     /* return error */
-            }
-            *raw = (uint32_t)buf[2] << 16 | (uint32_t)buf[1] << 8 | buf[0];                   /* get data */
-            output = a_bmp384_compensate_pressure(handle, *raw);                              /* compensate pressure */
-            *pa = (float)((double)output / 100.0);                                            /* get converted pressure */
-            
-            return 0;                                                                         /* success return 0 */
-        }
-        else
-        {
-            handle->debug_print("bmp384: pressure data is not ready.\n");                     /* pressure data is not ready */
-           
-            return 1;                                                                         /* return error */
-        }
+        handle->debug_print("bmp384: get config register failed.\n");                   /* get config register failed */
+       
+        return 1;                                                                       /* return error */
     }
-    else if (((prev >> 4) & 0x03) == 0x00)                                                    /* force mode */
+    
+    prev &= ~(0x7 << 1);                                                                /* clear config */
+    prev |= coefficient << 1;                                                           /* set config */
+    res = a_bmp384_iic_spi_write(handle, BMP384_REG_CONFIG, (uint8_t *)&prev, 1);       /* write config */
+    if (res != 0)                                                                       /* check result */
     {
-        uint16_t cnt = 5000;
-        
-        res = a_bmp384_iic_spi_read(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);        /* read config */
-        if (res != 0)                                                                         /* check result */
-        {
-            handle->debug_print("bmp384: get pwr ctrl register failed.\n");                   /* get pwr ctrl register failed */
-           
-            return 1;                                                                         /* return error */
-        }
-        prev &= ~(0x03 << 4);                                                                 /* clear 4-5 bits */
-        prev |= 0x01 << 4;                                                                    /* set 4 bit */
-        res = a_bmp384_iic_spi_write(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);       /* read config */
-        if (res != 0)                                                                         /* check result */
-        {
-            handle->debug_print("bmp384: set pwr ctrl register failed.\n");                   /* set pwr ctrl register failed */
-           
-            return 1;                                                                         /* return error */
-        }
-        
-        while (1)                                                                             /* loop */
-        {
-            res = a_bmp384_iic_spi_read(handle, BMP384_REG_STATUS, (uint8_t *)&prev, 1);      /* read config */
-            if (res != 0)                                                                     /* check result */
-            {
-                handle->debug_print("bmp384: get status register failed.\n");                 /* get status register failed */
-               
-                return 1;                                                                     /* return error */
-            }
-            if ((prev & (1 << 6)) != 0)                                                       /* data is ready */
-            {
-                res = a_bmp384_iic_spi_read(handle, BMP384_REG_DATA_3, (uint8_t *)buf, 3);    /* read raw data */
-                if (res != 0)                                                                 /* check result */
-                {
-                    handle->debug_print("bmp384: get data register failed.\n");               /* get data register failed */
-                   
-                    return 1;                                                                 /* return error */
-                }
-                temperature_raw = (uint32_t)buf[2] << 16 | (uint32_t)buf[1] << 8 | buf[0];    /* get data */
-                (void)a_bmp384_compensate_temperature(handle, temperature_raw);               /* compensate temperature */
-                
-                goto press;                                                                   /* goto press */
-            }
-            else
-            {
-                if (cnt != 0)                                                                 /* check cnt */
-                {
-                    cnt--;                                                                    /* cnt-- */
-                    handle->delay_ms(1);                                                      /* delay 1 ms */
-                    
-                    continue;                                                                 /* continue */
-                }
-                handle->debug_print("bmp384: temperature data is not ready.\n");              /* temperature data is not ready */
-               
-                return 1;                                                                     /* return error */
-            }
-        
-            press:
-            
-            cnt = 5000;                                                                       /* set cnt 5000 */
-            while (cnt != 0)
-            {
-                res = a_bmp384_iic_spi_read(handle, BMP384_REG_STATUS, 
-                                           (uint8_t *)&prev, 1);                              /* read config */
-                if (res != 0)                                                                 /* check result */
-                {
-                    handle->debug_print("bmp384: get status register failed.\n");             /* get status register failed */
-                   
-                    return 1;                                                                 /* return error */
-                }
-                if ((prev & (1 << 5)) != 0)                                                   /* data is ready */
-                {
-                    int64_t output;
-                    
-                    res = a_bmp384_iic_spi_read(handle, BMP384_REG_DATA_0, 
-                                               (uint8_t *)buf, 3);                            /* read config */
-                    if (res != 0)                                                             /* check result */
-                    {
-                        handle->debug_print("bmp384: get data register failed.\n");           /* get data register failed */
-                       
-                        return 1;                                                             /* return error */
-                    }
-                    *raw = (uint32_t)buf[2] << 16 | (uint32_t)buf[1] << 8 | buf[0];           /* get data */
-                    output = a_bmp384_compensate_pressure(handle, *raw);                      /* compensate pressure */
-                    *pa = (float)((double)output / 100.0);                                    /* get converted pressure */
-                    
-                    return 0;                                                                 /* success return 0 */
-                }
-                else
-                {
-                    if (cnt != 0)                                                             /* check cnt */
-                    {
-                        cnt--;                                                                /* cnt-- */
-                        handle->delay_ms(1);                                                  /* delay 1 ms */
-                        
-                        continue;                                                             /* continue */
-                    }
-                    handle->debug_print("bmp384: pressure data is not ready.\n");             /* pressure data is not ready */
-                   
-                    return 1;                                                                 /* return error */
-                }
-            }
-        }
-    }
-    else
-    {
-        handle->debug_print("bmp384: mode is invalid.\n");                                    /* mode is invalid */
-        
-        return 1;                                                                             /* return error */
+        handle->debug_print("bmp384: set config register failed.\n");                   /* set config register failed */
+       
+        return 1;                                                                       /* return error */
     }
+    
+    return 0;                                                                           /* success return 0 */
 }
 
 /**
- * @brief      read the temperature and pressure
+ * @brief      get the filter coefficient
  * @param[in]  *handle pointer to a bmp384 handle structure
- * @param[out] *temperature_raw pointer to a raw temperature buffer
- * @param[out] *temperature_c pointer to a converted temperature buffer
- * @param[out] *pressure_raw pointer to a raw pressure buffer
- * @param[out] *pressure_pa pointer to a converted pressure buffer
+ * @param[out] *coefficient pointer to a filter coefficient buffer
  * @return     status code
  *             - 0 success
- *             - 1 read temperature pressure failed
+ *             - 1 get filter coefficient failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t bmp384_read_temperature_pressure(bmp384_handle_t *handle, uint32_t *temperature_raw, float *temperature_c, 
-                                         uint32_t *pressure_raw, float *pressure_pa)
+uint8_t bmp384_get_filter_coefficient(bmp384_handle_t *handle, bmp384_filter_coefficient_t *coefficient)
 {
     uint8_t res;
     uint8_t prev;
-    uint8_t buf[3];
     
-    if (handle == NULL)                                                                       /* check handle */
+    if (handle == NULL)                                                                /* check handle */
     {
-        return 2;                                                                             /* return error */
+        return 2;                                                                      /* return error */
     }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
+    if (handle->inited != 1)                                                           /* check handle initialization */
     {
-        return 3;                                                                             /* return error */
+        return 3;                                                                      /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);       /* read config */
-    if (res != 0)                                                                             /* check result */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_CONFIG, (uint8_t *)&prev, 1);       /* read config */
+    if (res != 0)                                                                      /* check result */
     {
-        handle->debug_print("bmp384: get fifo config 1 register failed.\n");                  /* get fifo config 1 register failed */
+        handle->debug_print("bmp384: get config register failed.\n");                  /* return error */
        
-        return 1;                                                                             /* return error */
+        return 1;                                                                      /* return error */
     }
-    if ((prev & 0x01) != 0)                                                                   /* check fifo mode */
+    *coefficient = (bmp384_filter_coefficient_t)((prev >> 1) & 0x07);                  /* get coefficient */
+    
+    return 0;                                                                          /* success return 0 */
+}
+
+/**
+ * @brief     flush the fifo
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 flush fifo failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t bmp384_flush_fifo(bmp384_handle_t *handle)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                              /* check handle */
     {
-        handle->debug_print("bmp384: fifo mode can't use this function.\n");                  /* fifo mode can't use this function */
-       
-        return 1;                                                                             /* return error */
+        return 2;                                                                    /* return error */
     }
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);            /* read config */
-    if (res != 0)                                                                             /* check result */
+    if (handle->inited != 1)                                                         /* check handle initialization */
     {
-        handle->debug_print("bmp384: get pwr ctrl register failed.\n");                       /* get pwr ctrl register failed */
+        return 3;                                                                    /* return error */
+    }
+    
+    prev = 0xB0;                                                                     /* command */
+    res = a_bmp384_iic_spi_write(handle, BMP384_REG_CMD, (uint8_t *)&prev, 1);       /* write config */
+    if (res != 0)                                                                    /* check result */
+    {
+        handle->debug_print("bmp384: set cmd register failed.\n");                   /* set cmd register failed */
        
-        return 1;                                                                             /* return error */
+        return 1;                                                                    /* return error */
     }
-    if (((prev >> 4) & 0x03) == 0x03)                                                         /* normal mode */
+    handle->fifo_sample_index = 0;                                                   /* clear sample index */
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     soft reset
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 soft reset failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t bmp384_softreset(bmp384_handle_t *handle)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                              /* check handle */
     {
-        res = a_bmp384_iic_spi_read(handle, BMP384_REG_STATUS, (uint8_t *)&prev, 1);          /* read config */
-        if (res != 0)                                                                         /* check result */
-        {
-            handle->debug_print("bmp384: get status register failed.\n");                     /* get status register failed */
-           
-            return 1;                                                                         /* return error */
-        }
-        if ((prev & (1 << 6)) != 0)                                                           /* data is ready */
-        {
-            int64_t output;
-            
-            res = a_bmp384_iic_spi_read(handle, BMP384_REG_DATA_3, (uint8_t *)buf, 3);        /* read raw data */
-            if (res != 0)                                                                     /* check result */
-            {
-                handle->debug_print("bmp384: get data register failed.\n");                   /* get data register failed */
-               
-                return 1;                                                                     /* return error */
-            }
-            *temperature_raw= (uint32_t)buf[2] << 16 | (uint32_t)buf[1] << 8 | buf[0];        /* get data */
-            output = a_bmp384_compensate_temperature(handle, *temperature_raw);               /* compensate temperature */
-            *temperature_c = (float)((double)output / 100.0);                                 /* get converted temperature */
-        }
-        else
-        {
-            handle->debug_print("bmp384: temperature data is not ready.\n");                  /* temperature data is not ready */
-           
-            return 1;                                                                         /* return error */
-        }
-        if ((prev & (1 << 5)) != 0)                                                           /* data is ready */
-        {
-            int64_t output;
-            
-            res = a_bmp384_iic_spi_read(handle, BMP384_REG_DATA_0, (uint8_t *)buf, 3);        /* read data */
-            if (res != 0)                                                                     /* check result */
-            {
-                handle->debug_print("bmp384: get data register failed.\n");                   /* get data register failed */
-               
-                return 1;                                                                     /* return error */
-            }
-            *pressure_raw = (uint32_t)buf[2] << 16 | (uint32_t)buf[1] << 8 | buf[0];          /* get data */
-            output = a_bmp384_compensate_pressure(handle, *pressure_raw);                     /* compensate pressure */
-            *pressure_pa = (float)((double)output / 100.0);                                   /* get converted pressure */
-            
-            return 0;                                                                         /* success return 0 */
-        }
-        else
-        {
-            handle->debug_print("bmp384: pressure data is not ready.\n");                     /* pressure data is not ready */
-           
-            return 1;                                                                         /* return error */
-        }
+        return 2;                                                                    /* return error */
     }
-    else if (((prev >> 4) & 0x03) == 0x00)                                                    /* force mode */
+    if (handle->inited != 1)                                                         /* check handle initialization */
     {
-        uint16_t cnt = 5000;
-        
-        res = a_bmp384_iic_spi_read(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);        /* read config */
-        if (res != 0)                                                                         /* check result */
-        {
-            handle->debug_print("bmp384: get pwr ctrl register failed.\n");                   /* get pwr ctrl register failed */
-           
-            return 1;                                                                         /* return error */
-        }
-        prev &= ~(0x03 << 4);                                                                 /* clear 4-5 bits */
-        prev |= 0x01 << 4;                                                                    /* set bit 4 */
-        res = a_bmp384_iic_spi_write(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);       /* write config */
-        if (res != 0)                                                                         /* check result */
-        {
-            handle->debug_print("bmp384: set pwr ctrl register failed.\n");                   /* set pwr ctrl register failed */
-           
-            return 1;                                                                         /* return error */
-        }
+        return 3;                                                                    /* return error */
+    }
+    
+    prev = 0xB6;                                                                     /* command */
+    res = a_bmp384_iic_spi_write(handle, BMP384_REG_CMD, (uint8_t *)&prev, 1);       /* write config */
+    if (res != 0)                                                                    /* check result */
+    {
+        handle->debug_print("bmp384: set cmd register failed.\n");                   /* set cmd register failed */
+       
+        return 1;                                                                    /* return error */
+    }
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     extmode enable middle
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 extmode enable middle failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t bmp384_extmode_en_middle(bmp384_handle_t *handle)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                              /* check handle */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if (handle->inited != 1)                                                         /* check handle initialization */
+    {
+        return 3;                                                                    /* return error */
+    }
+    
+    prev = 0x34;                                                                     /* command */
+    res = a_bmp384_iic_spi_write(handle, BMP384_REG_CMD, (uint8_t *)&prev, 1);       /* write config */
+    if (res != 0)                                                                    /* check result */
+    {
+        handle->debug_print("bmp384: set cmd register failed.\n");                   /* set cmd register failed */
+       
+        return 1;                                                                    /* return error */
+    }
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable the register shadow
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set register shadow failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the shadow caches the registers from 0x15 to 0x1F,
+ *            setters become one write and getters cost no bus access
+ */
+uint8_t bmp384_set_register_shadow(bmp384_handle_t *handle, bmp384_bool_t enable)
+{
+    uint8_t res;
+    uint8_t buf[BMP384_SHADOW_LENGTH];
+    
+    if (handle == NULL)                                                              /* check handle */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if (handle->inited != 1)                                                         /* check handle initialization */
+    {
+        return 3;                                                                    /* return error */
+    }
+    
+    handle->shadow_enable = 0;                                                       /* disable register shadow */
+    if (enable == BMP384_BOOL_FALSE)                                                 /* disable */
+    {
+        return 0;                                                                    /* success return 0 */
+    }
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_WTM_0, 
+                                (uint8_t *)buf, BMP384_SHADOW_LENGTH);               /* read all config registers */
+    if (res != 0)                                                                    /* check result */
+    {
+        handle->debug_print("bmp384: get config registers failed.\n");               /* get config registers failed */
+       
+        return 1;                                                                    /* return error */
+    }
+    memcpy(handle->shadow, buf, BMP384_SHADOW_LENGTH);                               /* copy to the shadow */
+    a_bmp384_shadow_update(handle, BMP384_REG_PWR_CTRL, 
+                           handle->shadow[BMP384_REG_PWR_CTRL - BMP384_REG_FIFO_WTM_0]);  /* check the mode */
+    handle->shadow_enable = 1;                                                       /* enable register shadow */
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief      get the register shadow status
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get register shadow failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the shadow is disabled after a failed bus write
+ */
+uint8_t bmp384_get_register_shadow(bmp384_handle_t *handle, bmp384_bool_t *enable)
+{
+    if (handle == NULL)                                                              /* check handle */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if (handle->inited != 1)                                                         /* check handle initialization */
+    {
+        return 3;                                                                    /* return error */
+    }
+    
+    *enable = (bmp384_bool_t)(handle->shadow_enable);                                /* get bool */
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     apply the whole chip config
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @param[in] *config pointer to a config structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 apply config failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 config is invalid
+ * @note      registers 0x15 - 0x1F are written in one burst,
+ *            the chip enters sleep mode first and the mode is set last
+ */
+uint8_t bmp384_apply_config(bmp384_handle_t *handle, const bmp384_config_t *config)
+{
+    uint8_t res;
+    uint8_t pwr;
+    uint8_t reg[BMP384_BURST_WRITE_MAX_LENGTH];
+    uint8_t buf[BMP384_BURST_WRITE_MAX_LENGTH];
+    
+    if (handle == NULL)                                                              /* check handle */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if (handle->inited != 1)                                                         /* check handle initialization */
+    {
+        return 3;                                                                    /* return error */
+    }
+    if (config == NULL)                                                              /* check config */
+    {
+        handle->debug_print("bmp384: config is null.\n");                            /* config is null */
+        
+        return 1;                                                                    /* return error */
+    }
+    if (config->fifo_watermark > 0x1FF)                                              /* check fifo watermark */
+    {
+        handle->debug_print("bmp384: fifo watermark is invalid.\n");                 /* fifo watermark is invalid */
+        
+        return 4;                                                                    /* return error */
+    }
+    if (config->fifo_subsampling > 7)                                                /* check subsample */
+    {
+        handle->debug_print("bmp384: subsample is invalid.\n");                      /* subsample is invalid */
+        
+        return 4;                                                                    /* return error */
+    }
+    
+    pwr = (uint8_t)((config->pressure << 0) | (config->temperature << 1));           /* set pressure and temperature */
+    reg[0] = BMP384_REG_PWR_CTRL;                                                    /* enter sleep mode first */
+    buf[0] = pwr;                                                                    /* sleep mode */
+    reg[1] = BMP384_REG_FIFO_WTM_0;                                                  /* fifo watermark 0 */
+    buf[1] = (uint8_t)(config->fifo_watermark & 0xFF);                               /* set low part */
+    reg[2] = BMP384_REG_FIFO_WTM_1;                                                  /* fifo watermark 1 */
+    buf[2] = (uint8_t)((config->fifo_watermark >> 8) & 0x01);                        /* set high part */
+    reg[3] = BMP384_REG_FIFO_CONFIG_1;                                               /* fifo config 1 */
+    buf[3] = (uint8_t)((config->fifo << 0) | (config->fifo_stop_on_full << 1) | 
+                       (config->fifo_sensortime_on << 2) | 
+                       (config->fifo_pressure_on << 3) | 
+                       (config->fifo_temperature_on << 4));                          /* set fifo config 1 */
+    reg[4] = BMP384_REG_FIFO_CONFIG_2;                                               /* fifo config 2 */
+    buf[4] = (uint8_t)((config->fifo_subsampling << 0) | 
+                       (config->fifo_data_source << 3));                             /* set fifo config 2 */
+    reg[5] = BMP384_REG_INT_CTRL;                                                    /* interrupt control */
+    buf[5] = (uint8_t)((config->interrupt_pin_type << 0) | 
+                       (config->interrupt_active_level << 1) | 
+                       (config->latch_interrupt_pin_and_interrupt_status << 2) | 
+                       (config->interrupt_fifo_watermark << 3) | 
+                       (config->interrupt_fifo_full << 4) | 
+                       (config->interrupt_data_ready << 6));                         /* set interrupt control */
+    reg[6] = BMP384_REG_IF_CONF;                                                     /* if config */
+    buf[6] = (uint8_t)((config->spi_wire << 0) | (config->iic_watchdog_timer << 1) | 
+                       (config->iic_watchdog_period << 2));                          /* set if config */
+    reg[7] = BMP384_REG_OSR;                                                         /* oversampling */
+    buf[7] = (uint8_t)((config->pressure_oversampling << 0) | 
+                       (config->temperature_oversampling << 3));                     /* set oversampling */
+    reg[8] = BMP384_REG_ODR;                                                         /* output data rate */
+    buf[8] = (uint8_t)(config->odr << 0);                                            /* set odr */
+    reg[9] = BMP384_REG_CONFIG;                                                      /* config */
+    buf[9] = (uint8_t)(config->filter_coefficient << 1);                             /* set filter coefficient */
+    reg[10] = BMP384_REG_PWR_CTRL;                                                   /* set the mode last */
+    buf[10] = (uint8_t)(pwr | (config->mode << 4));                                  /* set mode */
+    res = a_bmp384_iic_spi_burst_write(handle, (const uint8_t *)reg, 
+                                       (const uint8_t *)buf, 11);                    /* write all config */
+    if (res != 0)                                                                    /* check result */
+    {
+        handle->debug_print("bmp384: apply config failed.\n");                       /* apply config failed */
+       
+        return 1;                                                                    /* return error */
+    }
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief      get the whole chip config
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *config pointer to a config structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get config failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t bmp384_get_config(bmp384_handle_t *handle, bmp384_config_t *config)
+{
+    uint8_t res;
+    uint8_t buf[BMP384_SHADOW_LENGTH];
+    
+    if (handle == NULL)                                                              /* check handle */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if (handle->inited != 1)                                                         /* check handle initialization */
+    {
+        return 3;                                                                    /* return error */
+    }
+    
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_WTM_0, 
+                                (uint8_t *)buf, BMP384_SHADOW_LENGTH);               /* read all config registers */
+    if (res != 0)                                                                    /* check result */
+    {
+        handle->debug_print("bmp384: get config registers failed.\n");               /* get config registers failed */
+       
+        return 1;                                                                    /* return error */
+    }
+    config->fifo_watermark = (uint16_t)(((uint16_t)(buf[1] & 0x01) << 8) | buf[0]);  /* get fifo watermark */
+    config->fifo = (bmp384_bool_t)((buf[2] >> 0) & 0x01);                            /* get fifo */
+    config->fifo_stop_on_full = (bmp384_bool_t)((buf[2] >> 1) & 0x01);               /* get fifo stop on full */
+    config->fifo_sensortime_on = (bmp384_bool_t)((buf[2] >> 2) & 0x01);              /* get fifo sensortime on */
+    config->fifo_pressure_on = (bmp384_bool_t)((buf[2] >> 3) & 0x01);                /* get fifo pressure on */
+    config->fifo_temperature_on = (bmp384_bool_t)((buf[2] >> 4) & 0x01);             /* get fifo temperature on */
+    config->fifo_subsampling = (uint8_t)((buf[3] >> 0) & 0x07);                      /* get fifo subsampling */
+    config->fifo_data_source = (bmp384_fifo_data_source_t)((buf[3] >> 3) & 0x03);    /* get fifo data source */
+    config->interrupt_pin_type = (bmp384_interrupt_pin_type_t)((buf[4] >> 0) & 0x01);            /* get interrupt pin type */
+    config->interrupt_active_level = (bmp384_interrupt_active_level_t)((buf[4] >> 1) & 0x01);     /* get interrupt active level */
+    config->latch_interrupt_pin_and_interrupt_status = (bmp384_bool_t)((buf[4] >> 2) & 0x01);     /* get latch interrupt */
+    config->interrupt_fifo_watermark = (bmp384_bool_t)((buf[4] >> 3) & 0x01);        /* get interrupt fifo watermark */
+    config->interrupt_fifo_full = (bmp384_bool_t)((buf[4] >> 4) & 0x01);             /* get interrupt fifo full */
+    config->interrupt_data_ready = (bmp384_bool_t)((buf[4] >> 6) & 0x01);            /* get interrupt data ready */
+    config->spi_wire = (bmp384_spi_wire_t)((buf[5] >> 0) & 0x01);                    /* get spi wire */
+    config->iic_watchdog_timer = (bmp384_bool_t)((buf[5] >> 1) & 0x01);              /* get iic watchdog timer */
+    config->iic_watchdog_period = (bmp384_iic_watchdog_period_t)((buf[5] >> 2) & 0x01);  /* get iic watchdog period */
+    config->pressure = (bmp384_bool_t)((buf[6] >> 0) & 0x01);                        /* get pressure */
+    config->temperature = (bmp384_bool_t)((buf[6] >> 1) & 0x01);                     /* get temperature */
+    config->mode = (bmp384_mode_t)((buf[6] >> 4) & 0x03);                            /* get mode */
+    config->pressure_oversampling = (bmp384_oversampling_t)((buf[7] >> 0) & 0x07);   /* get pressure oversampling */
+    config->temperature_oversampling = (bmp384_oversampling_t)((buf[7] >> 3) & 0x07);  /* get temperature oversampling */
+    config->odr = (bmp384_odr_t)((buf[8] >> 0) & 0x1F);                              /* get odr */
+    config->filter_coefficient = (bmp384_filter_coefficient_t)((buf[10] >> 1) & 0x07);  /* get filter coefficient */
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     close the chip
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+static uint8_t a_bmp384_close(bmp384_handle_t *handle)
+{
+    if (handle->iic_spi == BMP384_INTERFACE_IIC)                        /* if iic interface */
+    {
+        if (((handle->transport != NULL) ? handle->transport->iic_deinit(handle->ctx) : 
+             handle->iic_deinit()) != 0)                                /* close iic */
+        {
+            handle->debug_print("bmp384: iic deinit failed.\n");        /* iic deinit failed */
+       
+            return 1;                                                   /* return error */
+        }
+        else
+        {
+            return 0;                                                   /* success return 0 */
+        }
+    }
+    else
+    {
+        if (((handle->transport != NULL) ? handle->transport->spi_deinit(handle->ctx) : 
+             handle->spi_deinit()) != 0)                                /* close spi */
+        {
+            handle->debug_print("bmp384: spi deinit failed.\n");        /* spi deinit failed */
+       
+            return 1;                                                   /* return error */
+        }
+        else
+        {
+            return 0;                                                   /* success return 0 */
+        }
+    }
+}
+
+/**
+ * @brief     initialize the chip
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @param[in] *snapshot pointer to a calibration snapshot buffer
+ * @param[in] len snapshot length
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic or spi initialization failed
+ *            - 2 handle is NULL
+ *            - 3 linked functions is NULL
+ *            - 4 id is invalid
+ *            - 5 reset failed
+ *            - 6 get calibration failed
+ * @note      snapshot can be NULL
+ */
+static uint8_t a_bmp384_init(bmp384_handle_t *handle, const uint8_t *snapshot, uint16_t len)
+{
+    uint8_t id;
+    uint8_t reg;
+  
+    if (handle == NULL)                                                              /* check handle */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if (handle->debug_print == NULL)                                                 /* check debug_print */
+    {
+        return 3;                                                                    /* return error */
+    }
+    if (handle->transport != NULL)                                                   /* context transport */
+    {
+        if (handle->transport->iic_init == NULL)                                     /* check iic_init */
+        {
+            handle->debug_print("bmp384: transport iic_init is null.\n");            /* iic_init is null */
+           
+            return 3;                                                                /* return error */
+        }
+        if (handle->transport->iic_deinit == NULL)                                   /* check iic_deinit */
+        {
+            handle->debug_print("bmp384: transport iic_deinit is null.\n");          /* iic_deinit is null */
+           
+            return 3;                                                                /* return error */
+        }
+        if (handle->transport->iic_read == NULL)                                     /* check iic_read */
+        {
+            handle->debug_print("bmp384: transport iic_read is null.\n");            /* iic_read is null */
+           
+            return 3;                                                                /* return error */
+        }
+        if (handle->transport->iic_write == NULL)                                    /* check iic_write */
+        {
+            handle->debug_print("bmp384: transport iic_write is null.\n");           /* iic_write is null */
+           
+            return 3;                                                                /* return error */
+        }
+        if (handle->transport->spi_init == NULL)                                     /* check spi_init */
+        {
+            handle->debug_print("bmp384: transport spi_init is null.\n");            /* spi_init is null */
+           
+            return 3;                                                                /* return error */
+        }
+        if (handle->transport->spi_deinit == NULL)                                   /* check spi_deinit */
+        {
+            handle->debug_print("bmp384: transport spi_deinit is null.\n");          /* spi_deinit is null */
+           
+            return 3;                                                                /* return error */
+        }
+        if (handle->transport->spi_read == NULL)                                     /* check spi_read */
+        {
+            handle->debug_print("bmp384: transport spi_read is null.\n");            /* spi_read is null */
+           
+            return 3;                                                                /* return error */
+        }
+        if (handle->transport->spi_write == NULL)                                    /* check spi_write */
+        {
+            handle->debug_print("bmp384: transport spi_write is null.\n");           /* spi_write is null */
+           
+            return 3;                                                                /* return error */
+        }
+        if (handle->transport->delay_ms == NULL)                                     /* check delay_ms */
+        {
+            handle->debug_print("bmp384: transport delay_ms is null.\n");            /* delay_ms is null */
+           
+            return 3;                                                                /* return error */
+        }
+    }
+    else
+    {
+        if (handle->iic_init == NULL)                                                /* check iic_init */
+        {
+            handle->debug_print("bmp384: iic_init is null.\n");                      /* iic_init is null */
+           
+            return 3;                                                                /* return error */
+        }
+        if (handle->iic_deinit == NULL)                                              /* check iic_init */
+        {
+            handle->debug_print("bmp384: iic_deinit is null.\n");                    /* iic_deinit is null */
+           
+            return 3;                                                                /* return error */
+        }
+        if (handle->iic_read == NULL)                                                /* check iic_read */
+        {
+            handle->debug_print("bmp384: iic_read is null.\n");                      /* iic_read is null */
+           
+            return 3;                                                                /* return error */
+        }
+        if (handle->iic_write == NULL)                                               /* check iic_write */
+        {
+            handle->debug_print("bmp384: iic_write is null.\n");                     /* iic_write is null */
+           
+            return 3;                                                                /* return error */
+        }
+        if (handle->spi_init == NULL)                                                /* check spi_init */
+        {
+            handle->debug_print("bmp384: spi_init is null.\n");                      /* spi_init is null */
+           
+            return 3;                                                                /* return error */
+        }
+        if (handle->spi_deinit == NULL)                                              /* check spi_deinit */
+        {
+            handle->debug_print("bmp384: spi_deinit is null.\n");                    /* spi_deinit is null */
+           
+            return 3;                                                                /* return error */
+        }
+        if (handle->spi_read == NULL)                                                /* check spi_read */
+        {
+            handle->debug_print("bmp384: spi_read is null.\n");                      /* spi_read is null */
+           
+            return 3;                                                                /* return error */
+        }
+        if (handle->spi_write == NULL)                                               /* check spi_write */
+        {
+            handle->debug_print("bmp384: spi_write is null.\n");                     /* spi_write is null */
+           
+            return 3;                                                                /* return error */
+        }
+        if (handle->delay_ms == NULL)                                                /* check delay_ms */
+        {
+            handle->debug_print("bmp384: delay_ms is null.\n");                      /* delay_ms is null */
+           
+            return 3;                                                                /* return error */
+        }
+    }
+    
+#if (BMP384_SPI_BUFFER_LENGTH == 0)
+    if ((handle->iic_spi == BMP384_INTERFACE_SPI) && 
+        ((handle->transport != NULL) ? (handle->transport->spi_read_direct == NULL) : 
+                                       (handle->spi_read_direct == NULL)) && 
+        ((handle->scratch == NULL) || (handle->scratch_len < 2)))                    /* check spi read buffer */
+    {
+        handle->debug_print("bmp384: spi scratch buffer is null.\n");                /* spi scratch buffer is null */
+       
+        return 3;                                                                    /* return error */
+    }
+#endif
+    
+    if (handle->iic_spi == BMP384_INTERFACE_IIC)                                     /* if iic interface */
+    {
+        if (((handle->transport != NULL) ? handle->transport->iic_init(handle->ctx) : 
+             handle->iic_init()) != 0)                                               /* initialize iic bus */
+        {
+            handle->debug_print("bmp384: iic init failed.\n");                       /* iic init failed */
+            
+            return 1;                                                                /* return error */
+        }
+    }
+    else
+    {
+        if (((handle->transport != NULL) ? handle->transport->spi_init(handle->ctx) : 
+             handle->spi_init()) != 0)                                               /* initialize spi bus */
+        {
+            handle->debug_print("bmp384: spi init failed.\n");                       /* spi init failed */
+           
+            return 1;                                                                /* return error */
+        }
+    }
+    if (a_bmp384_iic_spi_read(handle, BMP384_REG_CHIP_ID, (uint8_t *)&id, 1) != 0)   /* read chip id */
+    {
+        handle->debug_print("bmp384: read chip id failed.\n");                       /* read chip id failed */
+        (void)a_bmp384_close(handle);                                                /* close bmp384 */
+        
+        return 4;                                                                    /* return error */
+    }
+    if (id != 0x50)                                                                  /* check chip id */
+    {
+        handle->debug_print("bmp384: id is invalid.\n");                             /* id is invalid */
+        (void)a_bmp384_close(handle);                                                /* close bmp384 */
+        
+        return 4;         
+    }                                                                                /* return error */
+    reg = 0xB6;                                                                      /* set command */
+    if (a_bmp384_iic_spi_write(handle, BMP384_REG_CMD, (uint8_t *)&reg, 1) != 0)     /* write command */
+    {
+        handle->debug_print("bmp384: soft rest failed.\n");                          /* soft rest failed */
+        (void)a_bmp384_close(handle);                                                /* close bmp384 */
+        
+        return 5;                                                                    /* return error */
+    }
+    a_bmp384_delay_ms(handle, 10);                                                   /* delay 10 ms */
+    if (a_bmp384_iic_spi_read(handle, BMP384_REG_ERR_REG, (uint8_t *)&reg, 1) != 0)  /* read reg */
+    {
+        handle->debug_print("bmp384: get err reg failed.\n");                        /* return error */
+        (void)a_bmp384_close(handle);                                                /* close bmp384 */
+        
+        return 5;                                                                    /* return error */
+    }
+    if ((reg & 0x07) != 0)                                                           /* check running status */
+    {
+        handle->debug_print("bmp384: find running error.\n");                        /* find running error */
+        (void)a_bmp384_close(handle);                                                /* close bmp384 */
+        
+        return 5;                                                                    /* return error */
+    }
+    handle->shadow_enable = 0;                                                       /* disable register shadow */
+    handle->stream_enable = 0;                                                       /* disable stream */
+    handle->forced_enable = 0x03;                                                    /* temperature and pressure */
+    handle->fifo_sample_index = 0;                                                   /* clear sample index */
+    handle->drdy_sample_index = 0;                                                   /* clear data ready sample index */
+    handle->fifo_period_valid = 0;                                                   /* read the fifo period when needed */
+    if (snapshot != NULL)                                                            /* check snapshot */
+    {
+        if (a_bmp384_load_calibration_snapshot(handle, snapshot, len) == 0)          /* load calibration snapshot */
+        {
+            handle->inited = 1;                                                      /* flag finish initialization */
+            
+            return 0;                                                                /* success return 0 */
+        }
+        handle->debug_print("bmp384: calibration snapshot is invalid.\n");           /* calibration snapshot is invalid */
+    }
+    if (a_bmp384_get_calibration_data(handle) != 0)                                  /* get calibration data */
+    {
+        handle->debug_print("bmp384: get calibration data error.\n");                /* get calibration data error */
+        (void)a_bmp384_close(handle);                                                /* close bmp384 */
+        
+        return 6;                                                                    /* return error */
+    }
+    handle->inited = 1;                                                              /* flag finish initialization */
+     
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief     initialize the chip
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic or spi initialization failed
+ *            - 2 handle is NULL
+ *            - 3 linked functions is NULL
+ *            - 4 id is invalid
+ *            - 5 reset failed
+ *            - 6 get calibration failed
+ * @note      none
+ */
+uint8_t bmp384_init(bmp384_handle_t *handle)
+{
+    return a_bmp384_init(handle, NULL, 0);                                           /* init without snapshot */
+}
+
+/**
+ * @brief     initialize the chip with a calibration snapshot
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @param[in] *snapshot pointer to a calibration snapshot buffer
+ * @param[in] len snapshot length
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic or spi initialization failed
+ *            - 2 handle is NULL
+ *            - 3 linked functions is NULL
+ *            - 4 id is invalid
+ *            - 5 reset failed
+ *            - 6 get calibration failed
+ * @note      if the snapshot fails validation the calibration data is read from the chip nvm
+ */
+uint8_t bmp384_init_with_calibration_snapshot(bmp384_handle_t *handle, const uint8_t *snapshot, uint16_t len)
+{
+    return a_bmp384_init(handle, snapshot, len);                                     /* init with snapshot */
+}
+
+/**
+ * @brief      get the calibration snapshot
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *snapshot pointer to a calibration snapshot buffer
+ * @param[in]  len snapshot buffer length
+ * @return     status code
+ *             - 0 success
+ *             - 1 get calibration snapshot failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 len is too small
+ * @note       len >= BMP384_CALIBRATION_SNAPSHOT_LENGTH
+ */
+uint8_t bmp384_get_calibration_snapshot(bmp384_handle_t *handle, uint8_t *snapshot, uint16_t len)
+{
+    uint16_t crc;
+    
+    if (handle == NULL)                                                              /* check handle */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if (handle->inited != 1)                                                         /* check handle initialization */
+    {
+        return 3;                                                                    /* return error */
+    }
+    if (snapshot == NULL)                                                            /* check snapshot */
+    {
+        handle->debug_print("bmp384: snapshot is null.\n");                          /* snapshot is null */
+        
+        return 1;                                                                    /* return error */
+    }
+    if (len < BMP384_CALIBRATION_SNAPSHOT_LENGTH)                                    /* check length */
+    {
+        handle->debug_print("bmp384: len is too small.\n");                          /* len is too small */
+        
+        return 4;                                                                    /* return error */
+    }
+    snapshot[0] = BMP384_CALIBRATION_SNAPSHOT_VERSION;                               /* set version */
+    snapshot[1] = 0x50;                                                              /* set chip id */
+    a_bmp384_encode_calibration_data(handle, &snapshot[2]);                          /* encode the calibration data */
+    crc = a_bmp384_crc16(snapshot, BMP384_CALIBRATION_SNAPSHOT_LENGTH - 2);          /* get crc */
+    snapshot[BMP384_CALIBRATION_SNAPSHOT_LENGTH - 2] = (uint8_t)(crc & 0xFF);        /* set crc lsb */
+    snapshot[BMP384_CALIBRATION_SNAPSHOT_LENGTH - 1] = (uint8_t)((crc >> 8) & 0xFF); /* set crc msb */
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief      get the calibration data
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *calibration pointer to a calibration structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 calibration is NULL
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the copy can be shared by bmp384_compensate_temperature and bmp384_compensate_pressure
+ */
+uint8_t bmp384_get_calibration(bmp384_handle_t *handle, bmp384_calibration_t *calibration)
+{
+    if (handle == NULL)                                                              /* check handle */
+    {
+        return 2;                                                                    /* return error */
+    }
+    if (handle->inited != 1)                                                         /* check handle initialization */
+    {
+        return 3;                                                                    /* return error */
+    }
+    if (calibration == NULL)                                                         /* check calibration */
+    {
+        handle->debug_print("bmp384: calibration is null.\n");                       /* calibration is null */
+        
+        return 1;                                                                    /* return error */
+    }
+    *calibration = handle->calibration;                                              /* copy the calibration data */
+    
+    return 0;                                                                        /* success return 0 */
+}
+
+/**
+ * @brief      compensate the raw temperature
+ * @param[in]  *calibration pointer to a calibration structure
+ * @param[in]  raw raw temperature
+ * @param[out] *temperature_c pointer to a compensated temperature buffer
+ * @param[out] *t_fine pointer to a t_fine buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 output is NULL
+ *             - 2 calibration is NULL
+ * @note       temperature_c is in 0.01C, the handle is not used so the function is reentrant
+ */
+uint8_t bmp384_compensate_temperature(const bmp384_calibration_t *calibration, uint32_t raw, int32_t *temperature_c, int64_t *t_fine)
+{
+    if (calibration == NULL)                                                                  /* check calibration */
+    {
+        return 2;                                                                             /* return error */
+    }
+    if ((temperature_c == NULL) || (t_fine == NULL))                                          /* check output */
+    {
+        return 1;                                                                             /* return error */
+    }
+    *temperature_c = (int32_t)a_bmp384_calculate_temperature(calibration, raw, t_fine);       /* get temperature in 0.01C */
+    
+    return 0;                                                                                 /* success return 0 */
+}
+
+/**
+ * @brief      compensate the raw pressure
+ * @param[in]  *calibration pointer to a calibration structure
+ * @param[in]  raw raw pressure
+ * @param[in]  t_fine t_fine from bmp384_compensate_temperature
+ * @param[out] *pressure_pa pointer to a compensated pressure buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 output is NULL
+ *             - 2 calibration is NULL
+ * @note       pressure_pa is in 0.01Pa, the handle is not used so the function is reentrant
+ */
+uint8_t bmp384_compensate_pressure(const bmp384_calibration_t *calibration, uint32_t raw, int64_t t_fine, uint32_t *pressure_pa)
+{
+    if (calibration == NULL)                                                                  /* check calibration */
+    {
+        return 2;                                                                             /* return error */
+    }
+    if (pressure_pa == NULL)                                                                  /* check output */
+    {
+        return 1;                                                                             /* return error */
+    }
+    *pressure_pa = (uint32_t)a_bmp384_calculate_pressure(calibration, raw, t_fine);           /* get pressure in 0.01Pa */
+    
+    return 0;                                                                                 /* success return 0 */
+}
+
+/**
+ * @brief      compensate a batch of raw temperature and pressure pairs
+ * @param[in]  *calibration pointer to a calibration structure
+ * @param[in]  *temperature_raw pointer to a raw temperature array
+ * @param[in]  *pressure_raw pointer to a raw pressure array
+ * @param[in]  len array length
+ * @param[out] *temperature_c pointer to a compensated temperature array
+ * @param[out] *pressure_pa pointer to a compensated pressure array
+ * @return     status code
+ *             - 0 success
+ *             - 1 buffer is NULL
+ *             - 2 calibration is NULL
+ * @note       temperature_c is in 0.01C and pressure_pa is in 0.01Pa,
+ *             each output matches bmp384_compensate_temperature and bmp384_compensate_pressure,
+ *             the pressure runs on the sse4.1, avx2 or neon kernel when enabled by BMP384_COMPENSATE_BATCH_SIMD
+ */
+uint8_t bmp384_compensate_batch(const bmp384_calibration_t *calibration, const uint32_t *temperature_raw, const uint32_t *pressure_raw,
+                                uint32_t len, int32_t *temperature_c, uint32_t *pressure_pa)
+{
+    uint32_t i;
+    uint32_t last_raw;
+    int32_t last_temperature;
+    int64_t t_fine;
+    bmp384_pressure_terms_t terms;
+#ifdef BMP384_BATCH_LANES
+    bmp384_pressure_terms_t lane[BMP384_BATCH_LANES];
+#endif
+    
+    if (calibration == NULL)                                                                               /* check calibration */
+    {
+        return 2;                                                                                          /* return error */
+    }
+    if ((temperature_raw == NULL) || (pressure_raw == NULL) ||
+        (temperature_c == NULL) || (pressure_pa == NULL))                                                  /* check buffer */
+    {
+        return 1;                                                                                          /* return error */
+    }
+    if (len == 0)                                                                                          /* check length */
+    {
+        return 0;                                                                                          /* success return 0 */
+    }
+    
+    last_raw = temperature_raw[0];                                                                         /* set the first raw */
+    last_temperature = (int32_t)a_bmp384_calculate_temperature(calibration, last_raw, &t_fine);            /* calculate the first temperature */
+    a_bmp384_calculate_pressure_terms(calibration, t_fine, &terms);                                        /* calculate the first terms */
+    for (i = 0; i < len; i++)                                                                              /* compensate all pairs */
+    {
+        if (temperature_raw[i] != last_raw)                                                                /* check temperature change */
+        {
+            last_raw = temperature_raw[i];                                                                 /* save raw */
+            last_temperature = (int32_t)a_bmp384_calculate_temperature(calibration, last_raw, &t_fine);    /* calculate temperature */
+            if (t_fine != terms.t_fine)                                                                    /* check t_fine change */
+            {
+                a_bmp384_calculate_pressure_terms(calibration, t_fine, &terms);                            /* calculate terms */
+            }
+        }
+        temperature_c[i] = last_temperature;                                                               /* set temperature in 0.01C */
+#ifdef BMP384_BATCH_LANES
+        lane[i % BMP384_BATCH_LANES] = terms;                                                              /* set the lane terms */
+        if ((i % BMP384_BATCH_LANES) == (BMP384_BATCH_LANES - 1))                                          /* check the lanes are full */
+        {
+            a_bmp384_calculate_pressure_lanes(calibration, lane, &pressure_raw[i + 1 - BMP384_BATCH_LANES],
+                                              &pressure_pa[i + 1 - BMP384_BATCH_LANES]);                   /* set pressure in 0.01Pa */
+        }
+#else
+        pressure_pa[i] = (uint32_t)a_bmp384_calculate_pressure_raw(calibration, &terms, pressure_raw[i]);  /* set pressure in 0.01Pa */
+#endif
+    }
+#ifdef BMP384_BATCH_LANES
+    for (i = len - (len % BMP384_BATCH_LANES); i < len; i++)                                               /* compensate the tail */
+    {
+        pressure_pa[i] = (uint32_t)a_bmp384_calculate_pressure_raw(calibration, &lane[i % BMP384_BATCH_LANES], 
+                                                                   pressure_raw[i]);                       /* set pressure in 0.01Pa */
+    }
+#endif
+    
+    return 0;                                                                                              /* success return 0 */
+}
+
+/**
+ * @brief     close the chip
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic or spi deinit failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 power down failed
+ * @note      none
+ */
+uint8_t bmp384_deinit(bmp384_handle_t *handle)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);        /* read config */
+    if (res != 0)                                                                         /* check result */
+    {
+        handle->debug_print("bmp384: get pwr ctrl register failed.\n");                   /* get pwr ctrl register failed */
+       
+        return 4;                                                                         /* return error */
+    }
+    prev &= ~(3 << 0);                                                                    /* clear config */
+    prev &= ~(3 << 4);                                                                    /* set config */
+    res = a_bmp384_iic_spi_write(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);       /* write config */
+    if (res != 0)                                                                         /* check result */
+    {
+        handle->debug_print("bmp384: set pwr ctrl register failed.\n");                   /* set pwr ctrl register failed */
+       
+        return 4;                                                                         /* return error */
+    }
+    if (a_bmp384_close(handle) != 0)                                                      /* close bmp384 */
+    {
+        return 1;                                                                         /* return error */
+    }
+    else
+    {
+        handle->inited = 0;                                                               /* flag close */
+    
+        return 0;                                                                         /* success return 0 */
+    }
+}
+
+/**
+ * @brief      read the temperature
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *raw pointer to a raw temperature buffer
+ * @param[out] *c pointer to a compensated temperature buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read temperature failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       output is in 0.01C
+ */
+static uint8_t a_bmp384_read_temperature(bmp384_handle_t *handle, uint32_t *raw, int64_t *c)
+{
+    uint8_t res;
+    uint8_t prev;
+    uint8_t buf[3];
+    
+    if (handle == NULL)                                                                       /* check handle */
+    {
+        return 2;                                                                             /* return error */
+    }
+    if (handle->inited != 1)                                                                  /* check handle initialization */
+    {
+        return 3;                                                                             /* return error */
+    }
+    
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);       /* read config */
+    if (res != 0)                                                                             /* check result */
+    {
+        handle->debug_print("bmp384: get fifo config 1 register failed.\n");                  /* get fifo config 1 register failed */
+       
+        return 1;                                                                             /* return error */
+    }
+    if ((prev & 0x01) != 0)                                                                   /* check mode */
+    {
+        handle->debug_print("bmp384: fifo mode can't use this function.\n");                  /* fifo mode can't use this function */
+       
+        return 1;                                                                             /* return error */
+    }
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);            /* read pwr ctrl */
+    if (res != 0)                                                                             /* check result */
+    {
+        handle->debug_print("bmp384: get pwr ctrl register failed.\n");                       /* get pwr ctrl register failed */
+       
+        return 1;                                                                             /* return error */
+    } 
+    if (((prev >> 4) & 0x03) == 0x03)                                                         /* normal mode */
+    {
+        res = a_bmp384_iic_spi_read(handle, BMP384_REG_STATUS, (uint8_t *)&prev, 1);          /* read config */
+        if (res != 0)                                                                         /* check result */
+        {
+            handle->debug_print("bmp384: get status register failed.\n");                     /* get status register failed */
+           
+            return 1;                                                                         /* return error */
+        }
+        if ((prev & (1 << 6)) != 0)                                                           /* data is ready */
+        {
+            int64_t output;
+            
+            res = a_bmp384_iic_spi_read(handle, BMP384_REG_DATA_3, (uint8_t *)buf, 3);        /* read raw data */
+            if (res != 0)                                                                     /* check result */
+            {
+                handle->debug_print("bmp384: get data register failed.\n");                   /* get data register failed */
+               
+                return 1;                                                                     /* return error */
+            }
+            *raw = (uint32_t)buf[2] << 16 | (uint32_t)buf[1] << 8 | buf[0];                   /* get data */
+            output = a_bmp384_compensate_temperature(handle, *raw);                           /* compensate temperature */
+            *c = output;                                                                      /* get compensated temperature */
+            
+            return 0;                                                                         /* success return 0 */
+            
+        }
+        else
+        {
+            handle->debug_print("bmp384: temperature data is not ready.\n");                  /* temperature data is not ready */
+           
+            return 1;                                                                         /* return error */
+        }            
+    }
+    else if (((prev >> 4) & 0x03) == 0x00)                                                    /* force mode */
+    {
+        uint16_t cnt = 5000;
+        
+        res = a_bmp384_iic_spi_read(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);        /* read config */
+        if (res != 0)                                                                         /* check result */
+        {
+            handle->debug_print("bmp384: get pwr ctrl register failed.\n");                   /* get pwr ctrl register failed */
+           
+            return 1;                                                                         /* return error */
+        }
+        prev &= ~(0x03 << 4);                                                                 /* clear 4-5 bits */
+        prev |= 0x01 << 4;                                                                    /* set bit 4 */
+        res = a_bmp384_iic_spi_write(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);       /* read config */
+        if (res != 0)                                                                         /* check result */
+        {
+            handle->debug_print("bmp384: set pwr ctrl register failed.\n");                   /* set pwr ctrl register failed */
+           
+            return 1;                                                                         /* return error */
+        }
+        
+        while (1)                                                                             /* loop */
+        {
+            res = a_bmp384_iic_spi_read(handle, BMP384_REG_STATUS, (uint8_t *)&prev, 1);      /* read status */
+            if (res != 0)                                                                     /* check result */
+            {
+                handle->debug_print("bmp384: get status register failed.\n");                 /* get status register failed */
+               
+                return 1;                                                                     /* return error */
+            }
+            if ((prev & (1 << 6)) != 0)                                                       /* data is ready */
+            {
+                int64_t output;
+                
+                res = a_bmp384_iic_spi_read(handle, BMP384_REG_DATA_3, (uint8_t *)buf, 3);    /* read raw data */
+                if (res != 0)                                                                 /* check result */
+                {
+                    handle->debug_print("bmp384: get data register failed.\n");               /* get data register failed */
+                   
+                    return 1;                                                                 /* return error */
+                }
+                *raw = (uint32_t)buf[2] << 16 | (uint32_t)buf[1] << 8 | buf[0];               /* get data */
+                output = a_bmp384_compensate_temperature(handle, *raw);                       /* compensate temperature */
+                *c = output;                                                                  /* get compensated temperature */
+                
+                return 0;                                                                     /* success return 0 */
+                
+            }
+            else
+            {
+                if (cnt != 0)                                                                 /* check cnt */
+                {
+                    cnt--;                                                                    /* cnt-- */
+                    a_bmp384_delay_ms(handle, 1);                                             /* delay 1 ms */
+                    
+                    continue;                                                                 /* continue */
+                }
+                handle->debug_print("bmp384: temperature data is not ready.\n");              /* temperature data is not ready */
+               
+                return 1;                                                                     /* return error */
+            }
+        }
+    }
+    else
+    {
+        handle->debug_print("bmp384: mode is invalid.\n");                                    /* mode is invalid */
+           
+        return 1;                                                                             /* return error */
+    }
+}
+
+/**
+ * @brief      read the temperature
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *raw pointer to a raw temperature buffer
+ * @param[out] *c pointer to a converted temperature buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read temperature failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t bmp384_read_temperature(bmp384_handle_t *handle, uint32_t *raw, float *c)
+{
+    uint8_t res;
+    int64_t output;
+    
+    res = a_bmp384_read_temperature(handle, raw, &output);                                  /* read temperature */
+    if (res != 0)                                                                           /* check result */
+    {
+        return res;                                                                         /* return error */
+    }
+    *c = (float)((double)output / 100.0);                                                   /* get converted temperature */
+    
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief      read the temperature in fixed point
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *raw pointer to a raw temperature buffer
+ * @param[out] *c pointer to a fixed point temperature buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read temperature failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       output is in 0.01C without float conversion
+ */
+uint8_t bmp384_read_temperature_int(bmp384_handle_t *handle, uint32_t *raw, int32_t *c)
+{
+    uint8_t res;
+    int64_t output;
+    
+    res = a_bmp384_read_temperature(handle, raw, &output);                                  /* read temperature */
+    if (res != 0)                                                                           /* check result */
+    {
+        return res;                                                                         /* return error */
+    }
+    *c = (int32_t)output;                                                                   /* get temperature in 0.01C */
+    
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief      read the pressure
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *raw pointer to a raw pressure buffer
+ * @param[out] *pa pointer to a compensated pressure buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read pressure failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       output is in 0.01Pa
+ */
+static uint8_t a_bmp384_read_pressure(bmp384_handle_t *handle, uint32_t *raw, int64_t *pa)
+{
+    uint8_t res;
+    uint8_t prev;
+    uint8_t buf[3];
+    uint32_t temperature_raw;
+    
+    if (handle == NULL)                                                                       /* check handle */
+    {
+        return 2;                                                                             /* return error */
+    }
+    if (handle->inited != 1)                                                                  /* check handle initialization */
+    {
+        return 3;                                                                             /* return error */
+    }
+    
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);       /* read config */
+    if (res != 0)                                                                             /* check result */
+    {
+        handle->debug_print("bmp384: get fifo config 1 register failed.\n");                  /* get fifo config 1 register failed */
+       
+        return 1;                                                                             /* return error */
+    }
+    if ((prev & 0x01) != 0)                                                                   /* check mode */
+    {
+        handle->debug_print("bmp384: fifo mode can't use this function.\n");                  /* fifo mode can't use this function */
+       
+        return 1;                                                                             /* return error */
+    }
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);            /* read config */
+    if (res != 0)                                                                             /* check result */
+    {
+        handle->debug_print("bmp384: get pwr ctrl register failed.\n");                       /* get pwr ctrl register failed */
+       
+        return 1;                                                                             /* return error */
+    }
+    if (((prev >> 4) & 0x03) == 0x03)                                                         /* normal mode */
+    {
+        res = a_bmp384_iic_spi_read(handle, BMP384_REG_STATUS, (uint8_t *)&prev, 1);          /* read status */
+        if (res != 0)                                                                         /* check result */
+        {
+            handle->debug_print("bmp384: get status register failed.\n");                     /* get status register failed */
+           
+            return 1;                                                                         /* return error */
+        }
+        if ((prev & (1 << 6)) != 0)                                                           /* data is ready */
+        {
+            res = a_bmp384_iic_spi_read(handle, BMP384_REG_DATA_3, (uint8_t *)buf, 3);        /* read config */
+            if (res != 0)                                                                     /* check result */
+            {
+                handle->debug_print("bmp384: get data register failed.\n");                   /* get data register failed */
+               
+                return 1;                                                                     /* return error */
+            }
+            temperature_raw= (uint32_t)buf[2] << 16 | (uint32_t)buf[1] << 8 | buf[0];         /* get data */
+            (void)a_bmp384_compensate_temperature(handle, temperature_raw);                   /* compensate temperature */
+        }
+        else
+        {
+            handle->debug_print("bmp384: temperature data is not ready.\n");                  /* temperature data is not ready */
+           
+            return 1;                                                                         /* return error */
+        }
+        if ((prev & (1 << 5)) != 0)                                                           /* data is ready */
+        {
+            int64_t output;
+            
+            res = a_bmp384_iic_spi_read(handle, BMP384_REG_DATA_0, (uint8_t *)buf, 3);        /* read config */
+            if (res != 0)                                                                     /* check result */
+            {
+                handle->debug_print("bmp384: get data register failed.\n");                   /* get data register failed */
+               
+                return 1;                                                                     /* return error */
+            }
+            *raw = (uint32_t)buf[2] << 16 | (uint32_t)buf[1] << 8 | buf[0];                   /* get data */
+            output = a_bmp384_compensate_pressure(handle, *raw);                              /* compensate pressure */
+            *pa = output;                                                                     /* get compensated pressure */
+            
+            return 0;                                                                         /* success return 0 */
+        }
+        else
+        {
+            handle->debug_print("bmp384: pressure data is not ready.\n");                     /* pressure data is not ready */
+           
+            return 1;                                                                         /* return error */
+        }
+    }
+    else if (((prev >> 4) & 0x03) == 0x00)                                                    /* force mode */
+    {
+        uint16_t cnt = 5000;
+        
+        res = a_bmp384_iic_spi_read(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);        /* read config */
+        if (res != 0)                                                                         /* check result */
+        {
+            handle->debug_print("bmp384: get pwr ctrl register failed.\n");                   /* get pwr ctrl register failed */
+           
+            return 1;                                                                         /* return error */
+        }
+        prev &= ~(0x03 << 4);                                                                 /* clear 4-5 bits */
+        prev |= 0x01 << 4;                                                                    /* set 4 bit */
+        res = a_bmp384_iic_spi_write(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);       /* read config */
+        if (res != 0)                                                                         /* check result */
+        {
+            handle->debug_print("bmp384: set pwr ctrl register failed.\n");                   /* set pwr ctrl register failed */
+           
+            return 1;                                                                         /* return error */
+        }
+        
+        while (1)                                                                             /* loop */
+        {
+            res = a_bmp384_iic_spi_read(handle, BMP384_REG_STATUS, (uint8_t *)&prev, 1);      /* read config */
+            if (res != 0)                                                                     /* check result */
+            {
+                handle->debug_print("bmp384: get status register failed.\n");                 /* get status register failed */
+               
+                return 1;                                                                     /* return error */
+            }
+            if ((prev & (1 << 6)) != 0)                                                       /* data is ready */
+            {
+                res = a_bmp384_iic_spi_read(handle, BMP384_REG_DATA_3, (uint8_t *)buf, 3);    /* read raw data */
+                if (res != 0)                                                                 /* check result */
+                {
+                    handle->debug_print("bmp384: get data register failed.\n");               /* get data register failed */
+                   
+                    return 1;                                                                 /* return error */
+                }
+                temperature_raw = (uint32_t)buf[2] << 16 | (uint32_t)buf[1] << 8 | buf[0];    /* get data */
+                (void)a_bmp384_compensate_temperature(handle, temperature_raw);               /* compensate temperature */
+                
+                goto press;                                                                   /* goto press */
+            }
+            else
+            {
+                if (cnt != 0)                                                                 /* check cnt */
+                {
+                    cnt--;                                                                    /* cnt-- */
+                    a_bmp384_delay_ms(handle, 1);                                             /* delay 1 ms */
+                    
+                    continue;                                                                 /* continue */
+                }
+                handle->debug_print("bmp384: temperature data is not ready.\n");              /* temperature data is not ready */
+               
+                return 1;                                                                     /* return error */
+            }
+        
+            press:
+            
+            cnt = 5000;                                                                       /* set cnt 5000 */
+            while (cnt != 0)
+            {
+                res = a_bmp384_iic_spi_read(handle, BMP384_REG_STATUS, 
+                                           (uint8_t *)&prev, 1);                              /* read config */
+                if (res != 0)                                                                 /* check result */
+                {
+                    handle->debug_print("bmp384: get status register failed.\n");             /* get status register failed */
+                   
+                    return 1;                                                                 /* return error */
+                }
+                if ((prev & (1 << 5)) != 0)                                                   /* data is ready */
+                {
+                    int64_t output;
+                    
+                    res = a_bmp384_iic_spi_read(handle, BMP384_REG_DATA_0, 
+                                               (uint8_t *)buf, 3);                            /* read config */
+                    if (res != 0)                                                             /* check result */
+                    {
+                        handle->debug_print("bmp384: get data register failed.\n");           /* get data register failed */
+                       
+                        return 1;                                                             /* return error */
+                    }
+                    *raw = (uint32_t)buf[2] << 16 | (uint32_t)buf[1] << 8 | buf[0];           /* get data */
+                    output = a_bmp384_compensate_pressure(handle, *raw);                      /* compensate pressure */
+                    *pa = output;                                                             /* get compensated pressure */
+                    
+                    return 0;                                                                 /* success return 0 */
+                }
+                else
+                {
+                    if (cnt != 0)                                                             /* check cnt */
+                    {
+                        cnt--;                                                                /* cnt-- */
+                        a_bmp384_delay_ms(handle, 1);                                         /* delay 1 ms */
+                        
+                        continue;                                                             /* continue */
+                    }
+                    handle->debug_print("bmp384: pressure data is not ready.\n");             /* pressure data is not ready */
+                   
+                    return 1;                                                                 /* return error */
+                }
+            }
+        }
+    }
+    else
+    {
+        handle->debug_print("bmp384: mode is invalid.\n");                                    /* mode is invalid */
+        
+        return 1;                                                                             /* return error */
+    }
+}
+
+/**
+ * @brief      read the pressure
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *raw pointer to a raw pressure buffer
+ * @param[out] *pa pointer to a converted pressure buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read pressure failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t bmp384_read_pressure(bmp384_handle_t *handle, uint32_t *raw, float *pa)
+{
+    uint8_t res;
+    int64_t output;
+    
+    res = a_bmp384_read_pressure(handle, raw, &output);                                     /* read pressure */
+    if (res != 0)                                                                           /* check result */
+    {
+        return res;                                                                         /* return error */
+    }
+    *pa = (float)((double)output / 100.0);                                                  /* get converted pressure */
+    
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief      read the pressure in fixed point
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *raw pointer to a raw pressure buffer
+ * @param[out] *pa pointer to a fixed point pressure buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read pressure failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       output is in 0.01Pa without float conversion
+ */
+uint8_t bmp384_read_pressure_int(bmp384_handle_t *handle, uint32_t *raw, uint32_t *pa)
+{
+    uint8_t res;
+    int64_t output;
+    
+    res = a_bmp384_read_pressure(handle, raw, &output);                                     /* read pressure */
+    if (res != 0)                                                                           /* check result */
+    {
+        return res;                                                                         /* return error */
+    }
+    *pa = (uint32_t)output;                                                                 /* get pressure in 0.01Pa */
+    
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief     start the normal mode stream
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @param[in] sensortime bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 stream start failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 fifo mode can't use this function
+ *            - 5 chip is not in normal mode
+ * @note      the mode and the enabled outputs are read once, writing the mode, fifo or cmd register stops the stream
+ */
+uint8_t bmp384_stream_start(bmp384_handle_t *handle, bmp384_bool_t sensortime)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                                       /* check handle */
+    {
+        return 2;                                                                             /* return error */
+    }
+    if (handle->inited != 1)                                                                  /* check handle initialization */
+    {
+        return 3;                                                                             /* return error */
+    }
+    
+    handle->stream_enable = 0;                                                                /* disable stream */
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);       /* read config */
+    if (res != 0)                                                                             /* check result */
+    {
+        handle->debug_print("bmp384: get fifo config 1 register failed.\n");                  /* get fifo config 1 register failed */
+       
+        return 1;                                                                             /* return error */
+    }
+    if ((prev & 0x01) != 0)                                                                   /* check fifo mode */
+    {
+        handle->debug_print("bmp384: fifo mode can't use this function.\n");                  /* fifo mode can't use this function */
+       
+        return 4;                                                                             /* return error */
+    }
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);            /* read config */
+    if (res != 0)                                                                             /* check result */
+    {
+        handle->debug_print("bmp384: get pwr ctrl register failed.\n");                       /* get pwr ctrl register failed */
+       
+        return 1;                                                                             /* return error */
+    }
+    if (((prev >> 4) & 0x03) != 0x03)                                                         /* check normal mode */
+    {
+        handle->debug_print("bmp384: chip is not in normal mode.\n");                         /* chip is not in normal mode */
+       
+        return 5;                                                                             /* return error */
+    }
+    handle->stream_output = prev & 0x03;                                                      /* save the enabled outputs */
+    handle->stream_sensortime = (uint8_t)sensortime;                                          /* save sensortime */
+    handle->stream_enable = 1;                                                                /* enable stream */
+    
+    return 0;                                                                                 /* success return 0 */
+}
+
+/**
+ * @brief      read one sample of the stream
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *data pointer to a stream data structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 stream read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 stream is not started
+ *             - 5 data is not ready
+ * @note       one burst read from 0x03 to 0x09, or to 0x0E with sensortime,
+ *             only the outputs enabled at bmp384_stream_start are waited for and set, the others are set to 0,
+ *             a pressure without temperature is compensated with the t_fine of the last temperature
+ */
+uint8_t bmp384_stream_read(bmp384_handle_t *handle, bmp384_stream_data_t *data)
+{
+    uint8_t res;
+    uint8_t mask;
+    uint8_t buf[12];
+    int64_t output;
+    
+    if (handle == NULL)                                                                       /* check handle */
+    {
+        return 2;                                                                             /* return error */
+    }
+    if (handle->inited != 1)                                                                  /* check handle initialization */
+    {
+        return 3;                                                                             /* return error */
+    }
+    if (handle->stream_enable == 0)                                                           /* check stream */
+    {
+        handle->debug_print("bmp384: stream is not started.\n");                              /* stream is not started */
+       
+        return 4;                                                                             /* return error */
+    }
+    
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_STATUS, (uint8_t *)buf, 
+                                (handle->stream_sensortime != 0) ? 12 : 7);                   /* read status and data */
+    if (res != 0)                                                                             /* check result */
+    {
+        handle->debug_print("bmp384: get data register failed.\n");                           /* get data register failed */
+       
+        return 1;                                                                             /* return error */
+    }
+    data->status = buf[0];                                                                    /* get status */
+    mask = 0;                                                                                 /* init 0 */
+    if ((handle->stream_output & (1 << 0)) != 0)                                              /* pressure enable */
+    {
+        mask |= 1 << 5;                                                                       /* pressure ready */
+    }
+    if ((handle->stream_output & (1 << 1)) != 0)                                              /* temperature enable */
+    {
+        mask |= 1 << 6;                                                                       /* temperature ready */
+    }
+    if ((buf[0] & mask) != mask)                                                              /* check data ready */
+    {
+        return 5;                                                                             /* return error */
+    }
+    data->temperature_raw = 0;                                                                /* init 0 */
+    data->temperature_c = 0.0f;                                                               /* init 0 */
+    data->pressure_raw = 0;                                                                   /* init 0 */
+    data->pressure_pa = 0.0f;                                                                 /* init 0 */
+    if ((mask & (1 << 6)) != 0)                                                               /* temperature */
+    {
+        data->temperature_raw = (uint32_t)buf[6] << 16 | (uint32_t)buf[5] << 8 | buf[4];      /* get data */
+        output = a_bmp384_compensate_temperature(handle, data->temperature_raw);              /* compensate temperature */
+        data->temperature_c = (float)((double)output / 100.0);                                /* get converted temperature */
+    }
+    if ((mask & (1 << 5)) != 0)                                                               /* pressure */
+    {
+        data->pressure_raw = (uint32_t)buf[3] << 16 | (uint32_t)buf[2] << 8 | buf[1];         /* get data */
+        output = a_bmp384_compensate_pressure(handle, data->pressure_raw);                    /* compensate pressure */
+        data->pressure_pa = (float)((double)output / 100.0);                                  /* get converted pressure */
+    }
+    if (handle->stream_sensortime != 0)                                                       /* check sensortime */
+    {
+        data->sensortime = (uint32_t)buf[11] << 16 | (uint32_t)buf[10] << 8 | buf[9];         /* get sensortime */
+    }
+    else
+    {
+        data->sensortime = 0;                                                                 /* no sensortime */
+    }
+    
+    return 0;                                                                                 /* success return 0 */
+}
+
+/**
+ * @brief     stop the normal mode stream
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t bmp384_stream_stop(bmp384_handle_t *handle)
+{
+    if (handle == NULL)                                                                       /* check handle */
+    {
+        return 2;                                                                             /* return error */
+    }
+    if (handle->inited != 1)                                                                  /* check handle initialization */
+    {
+        return 3;                                                                             /* return error */
+    }
+    
+    handle->stream_enable = 0;                                                                /* disable stream */
+    
+    return 0;                                                                                 /* success return 0 */
+}
+
+/**
+ * @brief      trigger one forced mode conversion
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *us pointer to a conversion time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 forced trigger failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 fifo mode can't use this function
+ * @note       the conversion time is computed from the current oversampling settings,
+ *             the enabled outputs are saved for bmp384_forced_collect,
+ *             call bmp384_forced_collect after it has passed
+ */
+uint8_t bmp384_forced_trigger(bmp384_handle_t *handle, uint32_t *us)
+{
+    uint8_t res;
+    uint8_t prev;
+    uint8_t buf[2];
+    uint32_t t;
+    bmp384_transfer_t transfer[2];
+    
+    if (handle == NULL)                                                                       /* check handle */
+    {
+        return 2;                                                                             /* return error */
+    }
+    if (handle->inited != 1)                                                                  /* check handle initialization */
+    {
+        return 3;                                                                             /* return error */
+    }
+    if (us == NULL)                                                                           /* check us */
+    {
+        handle->debug_print("bmp384: us is null.\n");                                         /* us is null */
+        
+        return 1;                                                                             /* return error */
+    }
+    
+    transfer[0].reg = BMP384_REG_FIFO_CONFIG_1;                                               /* fifo config 1 */
+    transfer[0].read = 1;                                                                     /* read */
+    transfer[0].buf = (uint8_t *)&prev;                                                       /* set buffer */
+    transfer[0].len = 1;                                                                      /* 1 byte */
+    transfer[1].reg = BMP384_REG_PWR_CTRL;                                                    /* pwr ctrl and osr */
+    transfer[1].read = 1;                                                                     /* read */
+    transfer[1].buf = (uint8_t *)buf;                                                         /* set buffer */
+    transfer[1].len = 2;                                                                      /* 2 bytes */
+    res = a_bmp384_iic_spi_transfer(handle, transfer, 2);                                     /* read config */
+    if (res != 0)                                                                             /* check result */
+    {
+        handle->debug_print("bmp384: get fifo config 1 and pwr ctrl register failed.\n");     /* get fifo config 1 and pwr ctrl register failed */
+       
+        return 1;                                                                             /* return error */
+    }
+    if ((prev & 0x01) != 0)                                                                   /* check fifo mode */
+    {
+        handle->debug_print("bmp384: fifo mode can't use this function.\n");                  /* fifo mode can't use this function */
+       
+        return 4;                                                                             /* return error */
+    }
+    prev = buf[0];                                                                            /* get pwr ctrl */
+    prev &= ~(0x03 << 4);                                                                     /* clear 4-5 bits */
+    prev |= 0x01 << 4;                                                                        /* set bit 4 */
+    res = a_bmp384_iic_spi_write(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);           /* write config */
+    if (res != 0)                                                                             /* check result */
+    {
+        handle->debug_print("bmp384: set pwr ctrl register failed.\n");                       /* set pwr ctrl register failed */
+       
+        return 1;                                                                             /* return error */
+    }
+    handle->forced_enable = buf[0] & 0x03;                                                    /* save the enabled outputs */
+    t = 234;                                                                                  /* base time */
+    if ((buf[0] & (1 << 0)) != 0)                                                             /* pressure enable */
+    {
+        t += 392 + ((uint32_t)1 << (buf[1] & 0x07)) * 2020;                                   /* add pressure time */
+    }
+    if ((buf[0] & (1 << 1)) != 0)                                                             /* temperature enable */
+    {
+        t += 163 + ((uint32_t)1 << ((buf[1] >> 3) & 0x07)) * 2020;                            /* add temperature time */
+    }
+    *us = t;                                                                                  /* set conversion time */
+    
+    return 0;                                                                                 /* success return 0 */
+}
+
+/**
+ * @brief      collect the forced mode conversion result
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *temperature_raw pointer to a raw temperature buffer
+ * @param[out] *temperature_c pointer to a converted temperature buffer
+ * @param[out] *pressure_raw pointer to a raw pressure buffer
+ * @param[out] *pressure_pa pointer to a converted pressure buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 forced collect failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 data is not ready
+ * @note       one burst read from 0x03 to 0x09 without polling,
+ *             only the outputs enabled at bmp384_forced_trigger are waited for and set, the others are left untouched,
+ *             a pressure without temperature is compensated with the t_fine of the last temperature
+ */
+uint8_t bmp384_forced_collect(bmp384_handle_t *handle, uint32_t *temperature_raw, float *temperature_c, 
+                              uint32_t *pressure_raw, float *pressure_pa)
+{
+    uint8_t res;
+    uint8_t mask;
+    uint8_t buf[7];
+    int64_t output;
+    
+    if (handle == NULL)                                                                       /* check handle */
+    {
+        return 2;                                                                             /* return error */
+    }
+    if (handle->inited != 1)                                                                  /* check handle initialization */
+    {
+        return 3;                                                                             /* return error */
+    }
+    
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_STATUS, (uint8_t *)buf, 7);                /* read status and data */
+    if (res != 0)                                                                             /* check result */
+    {
+        handle->debug_print("bmp384: get data register failed.\n");                           /* get data register failed */
+       
+        return 1;                                                                             /* return error */
+    }
+    mask = 0;                                                                                 /* init 0 */
+    if ((handle->forced_enable & (1 << 0)) != 0)                                              /* pressure enable */
+    {
+        mask |= 1 << 5;                                                                       /* pressure ready */
+    }
+    if ((handle->forced_enable & (1 << 1)) != 0)                                              /* temperature enable */
+    {
+        mask |= 1 << 6;                                                                       /* temperature ready */
+    }
+    if ((buf[0] & mask) != mask)                                                              /* check data ready */
+    {
+        return 4;                                                                             /* return error */
+    }
+    if ((mask & (1 << 6)) != 0)                                                               /* temperature */
+    {
+        *temperature_raw = (uint32_t)buf[6] << 16 | (uint32_t)buf[5] << 8 | buf[4];           /* get data */
+        output = a_bmp384_compensate_temperature(handle, *temperature_raw);                   /* compensate temperature */
+        *temperature_c = (float)((double)output / 100.0);                                     /* get converted temperature */
+    }
+    if ((mask & (1 << 5)) != 0)                                                               /* pressure */
+    {
+        *pressure_raw = (uint32_t)buf[3] << 16 | (uint32_t)buf[2] << 8 | buf[1];              /* get data */
+        output = a_bmp384_compensate_pressure(handle, *pressure_raw);                         /* compensate pressure */
+        *pressure_pa = (float)((double)output / 100.0);                                       /* get converted pressure */
+    }
+    
+    return 0;                                                                                 /* success return 0 */
+}
+
+/**
+ * @brief      read the temperature and pressure
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *temperature_raw pointer to a raw temperature buffer
+ * @param[out] *temperature_c pointer to a compensated temperature buffer
+ * @param[out] *pressure_raw pointer to a raw pressure buffer
+ * @param[out] *pressure_pa pointer to a compensated pressure buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read temperature pressure failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       output is in 0.01C and 0.01Pa
+ */
+static uint8_t a_bmp384_read_temperature_pressure(bmp384_handle_t *handle, uint32_t *temperature_raw, int64_t *temperature_c, 
+                                                  uint32_t *pressure_raw, int64_t *pressure_pa)
+{
+    uint8_t res;
+    uint8_t prev;
+    uint8_t status;
+    uint8_t buf[3];
+    bmp384_transfer_t transfer[2];
+    
+    if (handle == NULL)                                                                       /* check handle */
+    {
+        return 2;                                                                             /* return error */
+    }
+    if (handle->inited != 1)                                                                  /* check handle initialization */
+    {
+        return 3;                                                                             /* return error */
+    }
+    
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);       /* read config */
+    if (res != 0)                                                                             /* check result */
+    {
+        handle->debug_print("bmp384: get fifo config 1 register failed.\n");                  /* get fifo config 1 register failed */
+       
+        return 1;                                                                             /* return error */
+    }
+    if ((prev & 0x01) != 0)                                                                   /* check fifo mode */
+    {
+        handle->debug_print("bmp384: fifo mode can't use this function.\n");                  /* fifo mode can't use this function */
+       
+        return 1;                                                                             /* return error */
+    }
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);            /* read config */
+    if (res != 0)                                                                             /* check result */
+    {
+        handle->debug_print("bmp384: get pwr ctrl register failed.\n");                       /* get pwr ctrl register failed */
+       
+        return 1;                                                                             /* return error */
+    }
+    if (((prev >> 4) & 0x03) == 0x03)                                                         /* normal mode */
+    {
+        res = a_bmp384_iic_spi_read(handle, BMP384_REG_STATUS, (uint8_t *)&prev, 1);          /* read config */
+        if (res != 0)                                                                         /* check result */
+        {
+            handle->debug_print("bmp384: get status register failed.\n");                     /* get status register failed */
+           
+            return 1;                                                                         /* return error */
+        }
+        if ((prev & (1 << 6)) != 0)                                                           /* data is ready */
+        {
+            int64_t output;
+            
+            res = a_bmp384_iic_spi_read(handle, BMP384_REG_DATA_3, (uint8_t *)buf, 3);        /* read raw data */
+            if (res != 0)                                                                     /* check result */
+            {
+                handle->debug_print("bmp384: get data register failed.\n");                   /* get data register failed */
+               
+                return 1;                                                                     /* return error */
+            }
+            *temperature_raw= (uint32_t)buf[2] << 16 | (uint32_t)buf[1] << 8 | buf[0];        /* get data */
+            output = a_bmp384_compensate_temperature(handle, *temperature_raw);               /* compensate temperature */
+            *temperature_c = output;                                                          /* get compensated temperature */
+        }
+        else
+        {
+            handle->debug_print("bmp384: temperature data is not ready.\n");                  /* temperature data is not ready */
+           
+            return 1;                                                                         /* return error */
+        }
+        if ((prev & (1 << 5)) != 0)                                                           /* data is ready */
+        {
+            int64_t output;
+            
+            res = a_bmp384_iic_spi_read(handle, BMP384_REG_DATA_0, (uint8_t *)buf, 3);        /* read data */
+            if (res != 0)                                                                     /* check result */
+            {
+                handle->debug_print("bmp384: get data register failed.\n");                   /* get data register failed */
+               
+                return 1;                                                                     /* return error */
+            }
+            *pressure_raw = (uint32_t)buf[2] << 16 | (uint32_t)buf[1] << 8 | buf[0];          /* get data */
+            output = a_bmp384_compensate_pressure(handle, *pressure_raw);                     /* compensate pressure */
+            *pressure_pa = output;                                                            /* get compensated pressure */
+            
+            return 0;                                                                         /* success return 0 */
+        }
+        else
+        {
+            handle->debug_print("bmp384: pressure data is not ready.\n");                     /* pressure data is not ready */
+           
+            return 1;                                                                         /* return error */
+        }
+    }
+    else if (((prev >> 4) & 0x03) == 0x00)                                                    /* force mode */
+    {
+        uint16_t cnt = 5000;
+        
+        res = a_bmp384_iic_spi_read(handle, BMP384_REG_PWR_CTRL, (uint8_t *)&prev, 1);        /* read config */
+        if (res != 0)                                                                         /* check result */
+        {
+            handle->debug_print("bmp384: get pwr ctrl register failed.\n");                   /* get pwr ctrl register failed */
+           
+            return 1;                                                                         /* return error */
+        }
+        prev &= ~(0x03 << 4);                                                                 /* clear 4-5 bits */
+        prev |= 0x01 << 4;                                                                    /* set bit 4 */
+        transfer[0].reg = BMP384_REG_PWR_CTRL;                                                /* pwr ctrl */
+        transfer[0].read = 0;                                                                 /* write */
+        transfer[0].buf = (uint8_t *)&prev;                                                   /* set buffer */
+        transfer[0].len = 1;                                                                  /* 1 byte */
+        transfer[1].reg = BMP384_REG_STATUS;                                                  /* status */
+        transfer[1].read = 1;                                                                 /* read */
+        transfer[1].buf = (uint8_t *)&status;                                                 /* set buffer */
+        transfer[1].len = 1;                                                                  /* 1 byte */
+        res = a_bmp384_iic_spi_transfer(handle, transfer, 2);                                 /* trigger and read status */
+        if (res != 0)                                                                         /* check result */
+        {
+            handle->debug_print("bmp384: set pwr ctrl register failed.\n");                   /* set pwr ctrl register failed */
+           
+            return 1;                                                                         /* return error */
+        }
+        
+        while (1)                                                                             /* loop */
+        {
+            if ((status & (1 << 6)) != 0)                                                     /* data is ready */
+            {
+                int64_t output;
+                
+                res = a_bmp384_iic_spi_read(handle, BMP384_REG_DATA_3, (uint8_t *)buf, 3);    /* read raw data */
+                if (res != 0)                                                                 /* check result */
+                {
+                    handle->debug_print("bmp384: get data register failed.\n");               /* get data register failed */
+                   
+                    return 1;                                                                 /* return error */
+                }
+                *temperature_raw = (uint32_t)buf[2] << 16 | (uint32_t)buf[1] << 8 | buf[0];   /* get data */
+                output = a_bmp384_compensate_temperature(handle, *temperature_raw);           /* compensate temperature */
+                *temperature_c = output;                                                      /* get compensated temperature */
+                
+                break;                                                                        /* break */
+            }
+            else
+            {
+                if (cnt != 0)                                                                 /* check cnt */
+                {
+                    cnt--;                                                                    /* cnt-- */
+                    a_bmp384_delay_ms(handle, 1);                                             /* delay 1 ms */
+                    res = a_bmp384_iic_spi_read(handle, BMP384_REG_STATUS, 
+                                                (uint8_t *)&status, 1);                       /* read status */
+                    if (res != 0)                                                             /* check result */
+                    {
+                        handle->debug_print("bmp384: get status register failed.\n");         /* get status register failed */
+                       
+                        return 1;                                                             /* return error */
+                    }
+                    
+                    continue;                                                                 /* continue */
+                }
+                handle->debug_print("bmp384: temperature data is not ready.\n");              /* temperature data is not ready */
+               
+                return 1;                                                                     /* return error */
+            }
+        }
+        cnt = 5000;                                                                           /* set cnt */
         
         while (1)                                                                             /* loop */
         {
-            res = a_bmp384_iic_spi_read(handle, BMP384_REG_STATUS, (uint8_t *)&prev, 1);      /* read config */
-            if (res != 0)                                                                     /* check result */
+            res = a_bmp384_iic_spi_read(handle, BMP384_REG_STATUS, (uint8_t *)&prev, 1);      /* read config */
+            if (res != 0)                                                                     /* check result */
+            {
+                handle->debug_print("bmp384: get status register failed.\n");                 /* get status register failed */
+               
+                return 1;                                                                     /* return error */
+            }
+            if ((prev & (1 << 5)) != 0)                                                       /* data is ready */
+            {
+                int64_t output;
+                
+                res = a_bmp384_iic_spi_read(handle, BMP384_REG_DATA_0, (uint8_t *)buf, 3);    /* read raw data */
+                if (res != 0)                                                                 /* check result */
+                {
+                    handle->debug_print("bmp384: get data register failed.\n");               /* get data register failed */
+                   
+                    return 1;                                                                 /* return error */
+                }
+                *pressure_raw = (uint32_t)buf[2] << 16 | (uint32_t)buf[1] << 8 | buf[0];      /* get data */
+                output = a_bmp384_compensate_pressure(handle, *pressure_raw);                 /* compensate pressure */
+                *pressure_pa = output;                                                        /* get compensated pressure */
+                
+                return 0;                                                                     /* success return 0 */
+            }
+            else
+            {
+                if (cnt != 0)                                                                 /* check cnt */
+                {
+                    cnt--;                                                                    /* cnt-- */
+                    a_bmp384_delay_ms(handle, 1);                                             /* delay 1 ms */
+                    
+                    continue;                                                                 /* continue */
+                }
+                handle->debug_print("bmp384: pressure data is not ready.\n");                 /* pressure data is not ready */
+               
+                return 1;                                                                     /* return error */
+            }
+        }
+    }
+    else
+    {
+        handle->debug_print("bmp384: mode is invalid.\n");                                    /* mode is invalid */
+           
+        return 1;                                                                             /* return error */
+    }
+}
+
+/**
+ * @brief      read the temperature and pressure
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *temperature_raw pointer to a raw temperature buffer
+ * @param[out] *temperature_c pointer to a converted temperature buffer
+ * @param[out] *pressure_raw pointer to a raw pressure buffer
+ * @param[out] *pressure_pa pointer to a converted pressure buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read temperature pressure failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t bmp384_read_temperature_pressure(bmp384_handle_t *handle, uint32_t *temperature_raw, float *temperature_c, 
+                                         uint32_t *pressure_raw, float *pressure_pa)
+{
+    uint8_t res;
+    int64_t temperature;
+    int64_t pressure;
+    
+    res = a_bmp384_read_temperature_pressure(handle, temperature_raw, &temperature, 
+                                             pressure_raw, &pressure);                      /* read temperature and pressure */
+    if (res != 0)                                                                           /* check result */
+    {
+        return res;                                                                         /* return error */
+    }
+    *temperature_c = (float)((double)temperature / 100.0);                                  /* get converted temperature */
+    *pressure_pa = (float)((double)pressure / 100.0);                                       /* get converted pressure */
+    
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief      read the temperature and pressure in fixed point
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *temperature_raw pointer to a raw temperature buffer
+ * @param[out] *temperature_c pointer to a fixed point temperature buffer
+ * @param[out] *pressure_raw pointer to a raw pressure buffer
+ * @param[out] *pressure_pa pointer to a fixed point pressure buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read temperature pressure failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       output is in 0.01C and 0.01Pa without float conversion
+ */
+uint8_t bmp384_read_temperature_pressure_int(bmp384_handle_t *handle, uint32_t *temperature_raw, int32_t *temperature_c, 
+                                             uint32_t *pressure_raw, uint32_t *pressure_pa)
+{
+    uint8_t res;
+    int64_t temperature;
+    int64_t pressure;
+    
+    res = a_bmp384_read_temperature_pressure(handle, temperature_raw, &temperature, 
+                                             pressure_raw, &pressure);                      /* read temperature and pressure */
+    if (res != 0)                                                                           /* check result */
+    {
+        return res;                                                                         /* return error */
+    }
+    *temperature_c = (int32_t)temperature;                                                  /* get temperature in 0.01C */
+    *pressure_pa = (uint32_t)pressure;                                                      /* get pressure in 0.01Pa */
+    
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief     irq handler
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t bmp384_irq_handler(bmp384_handle_t *handle)
+{
+    uint8_t res;
+    uint8_t status;
+    
+    if (handle == NULL)                                                                      /* check handle */
+    {
+        return 2;                                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                                 /* check handle initialization */
+    {
+        return 3;                                                                            /* return error */
+    }
+    
+    res = a_bmp384_iic_spi_read(handle, BMP384_REG_INT_STATUS, (uint8_t *)&status, 1);       /* read config */
+    if (res != 0)                                                                            /* check result */
+    {
+        handle->debug_print("bmp384: get interrupt status register failed.\n");              /* get interrupt status register failed */
+       
+        return 1;                                                                            /* return error */
+    }
+    if ((status & (1 << 1)) != 0)                                                            /* if fifo full */
+    {
+        a_bmp384_receive_callback(handle, BMP384_INTERRUPT_STATUS_FIFO_FULL);                /* run receive callback */
+    }
+    if ((status & (1 << 0)) != 0)                                                            /* if fifo watermark */
+    {
+        a_bmp384_receive_callback(handle, BMP384_INTERRUPT_STATUS_FIFO_WATERMARK);           /* run receive callback */
+    }
+    if ((status & (1 << 3)) != 0)                                                            /* if data ready */
+    {
+        a_bmp384_receive_callback(handle, BMP384_INTERRUPT_STATUS_DATA_READY);               /* run receive callback */
+    }
+    
+    return 0;                                                                                /* success return 0 */
+}
+
+/**
+ * @brief     irq handler with the interrupt payload
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @param[in] *buf pointer to a fifo data buffer
+ * @param[in] buf_len fifo data buffer length
+ * @param[in] *sample pointer to a sample buffer
+ * @param[in] sample_len sample buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      one batched transfer reads 0x03 to 0x0E, 0x11 to 0x13 and the fifo config,
+ *            the event register 0x10 is skipped because reading it clears por_detected,
+ *            data ready passes one sample with the sensor time and a running index cleared by bmp384_init,
+ *            only the outputs flagged ready in the status register are set and the others are 0,
+ *            fifo watermark or full drains the whole fifo through buf in chunks of at most buf_len bytes,
+ *            a frame split at the end of a chunk is moved to the front of buf and finished by the next chunk,
+ *            the paired samples of each chunk are passed in one call, so only the samples of the last chunk
+ *            get the sensor time when buf_len is smaller than the 516 bytes of a full fifo,
+ *            buf_len >= BMP384_FIFO_FRAME_MAX_LENGTH,
+ *            samples are passed to receive_data_callback and receive_callback is not called
+ */
+uint8_t bmp384_irq_handler_read(bmp384_handle_t *handle, uint8_t *buf, uint16_t buf_len,
+                                bmp384_sample_t *sample, uint16_t sample_len)
+{
+    uint8_t res;
+    uint8_t n;
+    uint8_t prev;
+    uint8_t type;
+    uint8_t reg[12];
+    uint8_t status[3];
+    uint16_t i;
+    uint16_t carry;
+    uint16_t chunk;
+    uint16_t total;
+    uint16_t length;
+    uint16_t sample_num;
+    uint32_t raw;
+    int64_t output;
+    bmp384_transfer_t transfer[3];
+    
+    if (handle == NULL)                                                                          /* check handle */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                                     /* check handle initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
+    if ((buf == NULL) || (buf_len < BMP384_FIFO_FRAME_MAX_LENGTH) || 
+        (sample == NULL) || (sample_len == 0))                                                   /* check buffer */
+    {
+        handle->debug_print("bmp384: buffer is invalid.\n");                                     /* buffer is invalid */
+       
+        return 1;                                                                                /* return error */
+    }
+    
+    transfer[0].reg = BMP384_REG_STATUS;                                                         /* status to sensor time */
+    transfer[0].read = 1;                                                                        /* read */
+    transfer[0].buf = (uint8_t *)reg;                                                            /* set buffer */
+    transfer[0].len = 12;                                                                        /* 12 bytes */
+    transfer[1].reg = BMP384_REG_INT_STATUS;                                                     /* interrupt status and fifo length */
+    transfer[1].read = 1;                                                                        /* read */
+    transfer[1].buf = (uint8_t *)status;                                                         /* set buffer */
+    transfer[1].len = 3;                                                                         /* 3 bytes */
+    transfer[2].reg = BMP384_REG_FIFO_CONFIG_1;                                                  /* fifo config 1 */
+    transfer[2].read = 1;                                                                        /* read */
+    transfer[2].buf = (uint8_t *)&prev;                                                          /* set buffer */
+    transfer[2].len = 1;                                                                         /* 1 byte */
+    res = a_bmp384_iic_spi_transfer(handle, transfer, 3);                                        /* read without the event register */
+    if (res != 0)                                                                                /* check result */
+    {
+        handle->debug_print("bmp384: get interrupt status register failed.\n");                  /* get interrupt status register failed */
+       
+        return 1;                                                                                /* return error */
+    }
+    if ((status[0] & ((1 << 1) | (1 << 0))) != 0)                                                /* if fifo full or watermark */
+    {
+        type = ((status[0] & (1 << 1)) != 0) ? BMP384_INTERRUPT_STATUS_FIFO_FULL : 
+                                               BMP384_INTERRUPT_STATUS_FIFO_WATERMARK;           /* set type */
+        length = ((uint16_t)(status[2] & 0x01) << 8) | status[1];                                /* get fifo length */
+        if ((prev & (1 << 2)) != 0)                                                              /* if include sensor time */
+        {
+            length += 4;                                                                         /* add sensor time length */
+        }
+        carry = 0;                                                                               /* no partial frame */
+        while (length > 0)                                                                       /* drain the fifo in chunks */
+        {
+            chunk = ((buf_len - carry) < length) ? (buf_len - carry) : length;                   /* get chunk length */
+            res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_DATA, &buf[carry], chunk);       /* read fifo data */
+            if (res != 0)                                                                        /* check result */
             {
-                handle->debug_print("bmp384: get status register failed.\n");                 /* get status register failed */
+                handle->debug_print("bmp384: get fifo data failed.\n");                          /* get fifo data failed */
                
-                return 1;                                                                     /* return error */
+                return 1;                                                                        /* return error */
             }
-            if ((prev & (1 << 6)) != 0)                                                       /* data is ready */
+            length -= chunk;                                                                     /* left length */
+            total = carry + chunk;                                                               /* bytes in buf */
+            i = 0;                                                                               /* set 0 */
+            while (i < total)                                                                    /* find the last complete frame */
             {
-                int64_t output;
-                
-                res = a_bmp384_iic_spi_read(handle, BMP384_REG_DATA_3, (uint8_t *)buf, 3);    /* read raw data */
-                if (res != 0)                                                                 /* check result */
+                n = a_bmp384_fifo_frame_length(buf[i]);                                          /* get frame length */
+                if (n == 0)                                                                      /* check header */
                 {
-                    handle->debug_print("bmp384: get data register failed.\n");               /* get data register failed */
-                   
-                    return 1;                                                                 /* return error */
+                    handle->debug_print("bmp384: header is invalid.\n");                         /* header is invalid */
+                    
+                    return 1;                                                                    /* return error */
                 }
-                *temperature_raw = (uint32_t)buf[2] << 16 | (uint32_t)buf[1] << 8 | buf[0];   /* get data */
-                output = a_bmp384_compensate_temperature(handle, *temperature_raw);           /* compensate temperature */
-                *temperature_c = (float)((double)output / 100.0);                             /* get converted temperature */
-                
-                break;                                                                        /* break */
-            }
-            else
-            {
-                if (cnt != 0)                                                                 /* check cnt */
+                if ((uint32_t)i + n > total)                                                     /* check partial frame */
                 {
-                    cnt--;                                                                    /* cnt-- */
-                    handle->delay_ms(1);                                                      /* delay 1 ms */
-                    
-                    continue;                                                                 /* continue */
+                    break;                                                                       /* break */
                 }
-                handle->debug_print("bmp384: temperature data is not ready.\n");              /* temperature data is not ready */
-               
-                return 1;                                                                     /* return error */
+                i += n;                                                                          /* next frame */
+            }
+            sample_num = sample_len;                                                             /* set sample length */
+            res = bmp384_fifo_parse_sample(handle, buf, i, sample, &sample_num);                 /* parse fifo */
+            if (res != 0)                                                                        /* check result */
+            {
+                return 1;                                                                        /* return error */
             }
+            a_bmp384_receive_data_callback(handle, type, sample, sample_num);                    /* run receive data callback */
+            carry = total - i;                                                                   /* partial frame length */
+            memmove(buf, &buf[i], carry);                                                        /* keep the partial frame */
         }
-        cnt = 5000;                                                                           /* set cnt */
-        
-        while (1)                                                                             /* loop */
+    }
+    if (((status[0] & (1 << 3)) != 0) && ((reg[0] & ((1 << 6) | (1 << 5))) != 0))                /* if data ready */
+    {
+        memset(&sample[0], 0, sizeof(bmp384_sample_t));                                          /* clear the sample */
+        sample[0].index = handle->drdy_sample_index;                                             /* set index */
+        handle->drdy_sample_index++;                                                             /* index++ */
+        if ((reg[0] & (1 << 6)) != 0)                                                            /* if temperature ready */
+        {
+            memcpy(sample[0].temperature_raw, &reg[4], 3);                                       /* set raw temperature */
+            raw = (uint32_t)reg[6] << 16 | (uint32_t)reg[5] << 8 | reg[4];                       /* get temperature raw */
+            output = a_bmp384_compensate_temperature(handle, raw);                               /* compensate temperature */
+            sample[0].temperature = a_bmp384_sample_temperature(output);                         /* set temperature in 0.01C */
+        }
+        if ((reg[0] & (1 << 5)) != 0)                                                            /* if pressure ready */
+        {
+            memcpy(sample[0].pressure_raw, &reg[1], 3);                                          /* set raw pressure */
+            raw = (uint32_t)reg[3] << 16 | (uint32_t)reg[2] << 8 | reg[1];                       /* get pressure raw */
+            output = a_bmp384_compensate_pressure(handle, raw);                                  /* compensate pressure */
+            sample[0].pressure = (uint32_t)output;                                               /* set pressure in 0.01Pa */
+        }
+        sample[0].sensortime = (uint32_t)reg[11] << 16 | (uint32_t)reg[10] << 8 | reg[9] | 
+                               BMP384_SAMPLE_SENSORTIME_VALID;                                   /* get sensor time */
+        a_bmp384_receive_data_callback(handle, BMP384_INTERRUPT_STATUS_DATA_READY, sample, 1);   /* run receive data callback */
+    }
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief     set the iic address pin
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @param[in] addr_pin iic address pin
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      none
+ */
+uint8_t bmp384_set_addr_pin(bmp384_handle_t *handle, bmp384_address_t addr_pin)
+{
+    if (handle == NULL)                          /* check handle */
+    {
+        return 2;                                /* return error */
+    }
+    
+    handle->iic_addr = (uint8_t)addr_pin;        /* set iic address */
+    
+    return 0;                                    /* success return 0 */
+}
+
+/**
+ * @brief      get the iic address pin
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *addr_pin pointer to an iic address pin buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t bmp384_get_addr_pin(bmp384_handle_t *handle, bmp384_address_t *addr_pin)
+{
+    if (handle == NULL)                                    /* check handle */
+    {
+        return 2;                                          /* return error */
+    }
+    
+    *addr_pin = (bmp384_address_t)handle->iic_addr;        /* get iic address */
+    
+    return 0;                                              /* success return 0 */
+}
+
+/**
+ * @brief     set the interface
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @param[in] interface chip interface
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      none
+ */
+uint8_t bmp384_set_interface(bmp384_handle_t *handle, bmp384_interface_t interface) 
+{
+    if (handle == NULL)                        /* check handle */
+    {
+        return 2;                              /* return error */
+    }
+    
+    handle->iic_spi = (uint8_t)interface;      /* set interface */
+    
+    return 0;                                  /* success return 0 */
+}
+
+/**
+ * @brief      get the interface
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *interface pointer to a chip interface buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t bmp384_get_interface(bmp384_handle_t *handle, bmp384_interface_t *interface)
+{
+    if (handle == NULL)                                        /* check handle */
+    {
+        return 2;                                              /* return error */
+    }
+    
+    *interface = (bmp384_interface_t)(handle->iic_spi);        /* get interface */
+    
+    return 0;                                                  /* success return 0 */
+}
+
+/**
+ * @brief         read the fifo
+ * @param[in]     *handle pointer to a bmp384 handle structure
+ * @param[in]     *buf pointer to a data buffer
+ * @param[in,out] *len pointer to a data length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 read fifo failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ * @note          len returns the exact number of bytes read,
+ *                a full fifo with sensor time can be drained in one call with any buffer size
+ */
+uint8_t bmp384_read_fifo(bmp384_handle_t *handle, uint8_t *buf, uint16_t *len)
+{
+    uint8_t res;
+    uint8_t prev;
+    uint8_t tmp_buf[2];
+    uint16_t length;
+    bmp384_transfer_t transfer[2];
+    
+    if (handle == NULL)                                                                             /* check handle */
+    {
+        return 2;                                                                                   /* return error */
+    }
+    if (handle->inited != 1)                                                                        /* check handle initialization */
+    {
+        return 3;                                                                                   /* return error */
+    }
+    
+    transfer[0].reg = BMP384_REG_FIFO_CONFIG_1;                                                     /* fifo config 1 */
+    transfer[0].read = 1;                                                                           /* read */
+    transfer[0].buf = (uint8_t *)&prev;                                                             /* set buffer */
+    transfer[0].len = 1;                                                                            /* 1 byte */
+    transfer[1].reg = BMP384_REG_FIFO_LENGTH_0;                                                     /* fifo length */
+    transfer[1].read = 1;                                                                           /* read */
+    transfer[1].buf = (uint8_t *)tmp_buf;                                                           /* set buffer */
+    transfer[1].len = 2;                                                                            /* 2 bytes */
+    res = a_bmp384_iic_spi_transfer(handle, transfer, 2);                                           /* read config and length */
+    if (res != 0)                                                                                   /* check result */
+    {
+        handle->debug_print("bmp384: get fifo config 1 and length register failed.\n");             /* get fifo config 1 and length register failed */
+       
+        return 1;                                                                                   /* return error */
+    }
+    if ((prev & 0x01) != 0)                                                                         /* check mode */
+    {
+        length = ((uint16_t)(tmp_buf[1] & 0x01) << 8) | tmp_buf[0];                                 /* get data */
+        if ((prev & (1 << 2)) != 0)                                                                 /* if include sensor time */
         {
-            res = a_bmp384_iic_spi_read(handle, BMP384_REG_STATUS, (uint8_t *)&prev, 1);      /* read config */
-            if (res != 0)                                                                     /* check result */
-            {
-                handle->debug_print("bmp384: get status register failed.\n");                 /* get status register failed */
-               
-                return 1;                                                                     /* return error */
-            }
-            if ((prev & (1 << 5)) != 0)                                                       /* data is ready */
-            {
-                int64_t output;
-                
-                res = a_bmp384_iic_spi_read(handle, BMP384_REG_DATA_0, (uint8_t *)buf, 3);    /* read raw data */
-                if (res != 0)                                                                 /* check result */
-                {
-                    handle->debug_print("bmp384: get data register failed.\n");               /* get data register failed */
-                   
-                    return 1;                                                                 /* return error */
-                }
-                *pressure_raw = (uint32_t)buf[2] << 16 | (uint32_t)buf[1] << 8 | buf[0];      /* get data */
-                output = a_bmp384_compensate_pressure(handle, *pressure_raw);                 /* compensate pressure */
-                *pressure_pa = (float)((double)output / 100.0);                               /* get converted pressure */
-                
-                return 0;                                                                     /* success return 0 */
-            }
-            else
-            {
-                if (cnt != 0)                                                                 /* check cnt */
-                {
-                    cnt--;                                                                    /* cnt-- */
-                    handle->delay_ms(1);                                                      /* delay 1 ms */
-                    
-                    continue;                                                                 /* continue */
-                }
-                handle->debug_print("bmp384: pressure data is not ready.\n");                 /* pressure data is not ready */
-               
-                return 1;                                                                     /* return error */
-            }
+            length += 4;                                                                            /* add sensor time length */
+        }            
+        *len = (*len) < length ? (*len) :length;                                                    /* get real length */
+        res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_DATA, (uint8_t *)buf, *len);            /* read config */
+        if (res != 0)                                                                               /* check result */
+        {
+            handle->debug_print("bmp384: get fifo data failed.\n");                                 /* get fifo data failed */
+           
+            return 1;                                                                               /* return error */
         }
+        
+        return 0;                                                                                   /* success return 0 */
     }
     else
     {
-        handle->debug_print("bmp384: mode is invalid.\n");                                    /* mode is invalid */
+        handle->debug_print("bmp384: normal mode or forced mode can't use this function.\n");       /* normal mode or forced mode can't use this function */
            
-        return 1;                                                                             /* return error */
+        return 1;                                                                                   /* return error */
     }
 }
 
 /**
- * @brief     irq handler
- * @param[in] *handle pointer to a bmp384 handle structure
- * @return    status code
- *            - 0 success
- *            - 1 run failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief     set one fifo frame
+ * @param[in] *frame pointer to a frame buffer
+ * @param[in] *frame_int pointer to a fixed point frame buffer
+ * @param[in] index frame index
+ * @param[in] type frame type
+ * @param[in] raw raw data
+ * @param[in] output compensated data
+ * @note      frame is used when it is not NULL, otherwise frame_int is used
  */
-uint8_t bmp384_irq_handler(bmp384_handle_t *handle)
+static void a_bmp384_fifo_set_frame(bmp384_frame_t *frame, bmp384_frame_int_t *frame_int, uint16_t index, 
+                                    bmp384_frame_type_t type, uint32_t raw, int64_t output)
+{
+    if (frame != NULL)                                                                 /* float frame */
+    {
+        frame[index].type = type;                                                      /* set type */
+        frame[index].raw = raw;                                                        /* set raw */
+        frame[index].data = (float)((double)output / 100.0);                           /* set converted data */
+    }
+    else                                                                               /* fixed point frame */
+    {
+        frame_int[index].type = type;                                                  /* set type */
+        frame_int[index].raw = raw;                                                    /* set raw */
+        frame_int[index].data = (int32_t)output;                                       /* set data in 0.01C or 0.01Pa */
+    }
+}
+
+/**
+ * @brief         parse the fifo data
+ * @param[in]     *handle pointer to a bmp384 handle structure
+ * @param[in]     *buf pointer to fifo data
+ * @param[in]     buf_len fifo data length
+ * @param[out]    *frame pointer to a frame buffer
+ * @param[out]    *frame_int pointer to a fixed point frame buffer
+ * @param[in,out] *frame_len pointer to a frame length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 fifo parse failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ * @note          only one of frame and frame_int is used
+ */
+static uint8_t a_bmp384_fifo_parse(bmp384_handle_t *handle, uint8_t *buf, uint16_t buf_len, bmp384_frame_t *frame, 
+                                  bmp384_frame_int_t *frame_int, uint16_t *frame_len)
 {
     uint8_t res;
-    uint8_t status;
+    uint8_t n;
+    uint16_t i;
+    uint16_t frame_total;
+    uint32_t raw;
     
-    if (handle == NULL)                                                                      /* check handle */
+    if (handle == NULL)                                                                                                                   /* check handle */
     {
-        return 2;                                                                            /* return error */
+        return 2;                                                                                                                         /* return error */
     }
-    if (handle->inited != 1)                                                                 /* check handle initialization */
+    if (handle->inited != 1)                                                                                                              /* check handle initialization */
     {
-        return 3;                                                                            /* return error */
+        return 3;                                                                                                                         /* return error */
     }
     
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_INT_STATUS, (uint8_t *)&status, 1);       /* read config */
-    if (res != 0)                                                                            /* check result */
+    if (buf_len == 0)                                                                                                                     /* check buffer length */
     {
-        handle->debug_print("bmp384: get interrupt status register failed.\n");              /* get interrupt status register failed */
+        handle->debug_print("bmp384: buffer length is invalid.\n");                                                                       /* buffer length is invalid */
        
-        return 1;                                                                            /* return error */
-    }
-    if ((status & (1 << 1)) != 0)                                                            /* if fifo full */
+        return 1;                                                                                                                         /* return error */
+    } 
+    frame_total = 0;                                                                                                                      /* clear total frame */
+    res = 0;                                                                                                                              /* set 0 */
+    i = 0;                                                                                                                                /* set 0 */
+    while (i < buf_len)                                                                                                                   /* loop */
     {
-        if(handle->receive_callback != NULL)                                                 /* if receive callback is valid */
+        n = a_bmp384_fifo_frame_length(buf[i]);                                                                                           /* get frame length */
+        if ((n != 0) && ((uint32_t)i + n > buf_len))                                                                                      /* check partial frame */
         {
-            handle->receive_callback(BMP384_INTERRUPT_STATUS_FIFO_FULL);                     /* run receive callback */
+            break;                                                                                                                        /* ignore the partial frame */
         }
-    }
-    if ((status & (1 << 0)) != 0)                                                            /* if fifo watermark */
-    {
-        if(handle->receive_callback != NULL)                                                 /* if receive callback is valid */
+        switch ((uint8_t)buf[i])
         {
-            handle->receive_callback(BMP384_INTERRUPT_STATUS_FIFO_WATERMARK);                /* run receive callback */
+            case 0x90 :
+            {
+                if (frame_total > ((*frame_len)-1))                                                                                       /* check length */
+                {
+                    return 0;                                                                                                             /* return success */
+                }
+                raw = (uint32_t)buf[i + 2 + 1] << 16 | (uint32_t)buf[i + 1 + 1] << 8 | buf[i + 0 + 1];                                    /* set raw */
+                a_bmp384_fifo_set_frame(frame, frame_int, frame_total, BMP384_FRAME_TYPE_TEMPERATURE, 
+                                        raw, a_bmp384_compensate_temperature(handle, raw));                                               /* set compensate temperature */
+                frame_total++;                                                                                                            /* frame++ */
+                i += 4;                                                                                                                   /* index + 4 */
+                
+                break;                                                                                                                    /* break */
+            }
+            case 0x94 :
+            {
+                if ((frame_total) > ((*frame_len)-1))                                                                                     /* check length */
+                {
+                    return 0;                                                                                                             /* return success */
+                }
+                raw = (uint32_t)buf[i + 2 + 1] << 16 | (uint32_t)buf[i + 1 + 1] << 8 | buf[i + 0 + 1];                                    /* set raw */
+                a_bmp384_fifo_set_frame(frame, frame_int, frame_total, BMP384_FRAME_TYPE_TEMPERATURE, 
+                                        raw, a_bmp384_compensate_temperature(handle, raw));                                               /* set compensate temperature */
+                frame_total++;                                                                                                            /* frame++ */
+                if (frame_total > ((*frame_len)-1))                                                                                       /* check length */
+                {
+                    return 0;                                                                                                             /* return success */
+                }
+                raw = (uint32_t)buf[i + 5 + 1] << 16 | (uint32_t)buf[i + 4 + 1] << 8 | buf[i + 3 + 1];                                    /* set raw */
+                a_bmp384_fifo_set_frame(frame, frame_int, frame_total, BMP384_FRAME_TYPE_PRESSURE, 
+                                        raw, a_bmp384_compensate_pressure(handle, raw));                                                  /* set compensate pressure */
+                frame_total++;                                                                                                            /* frame++ */
+                i += 7;                                                                                                                   /* index + 7 */
+                
+                break;                                                                                                                    /* break */
+            }
+            case 0xA0 :
+            {
+                if (frame_total > ((*frame_len)-1))                                                                                       /* check length */
+                {
+                    return 0;                                                                                                             /* return success */
+                }
+                raw = (uint32_t)buf[i + 2 + 1] << 16 | (uint32_t)buf[i + 1 + 1] << 8 | buf[i + 0 + 1];                                    /* set raw */
+                a_bmp384_fifo_set_frame(frame, frame_int, frame_total, BMP384_FRAME_TYPE_SENSORTIME, raw, 0);                             /* set sensor time */
+                frame_total++;                                                                                                            /* frame++ */
+                i += 4;                                                                                                                   /* index+4 */
+                
+                break;                                                                                                                    /* break */
+            }
+            case 0x80 :                                                                                                                   /* fifo empty */
+            {
+                i += 2;                                                                                                                   /* index+2 */
+                
+                break;                                                                                                                    /* break */
+            }
+            case 0x48 :                                                                                                                   /* fifo input config */
+            {
+                i += 2;                                                                                                                   /* index+2 */
+                
+                break;                                                                                                                    /* break */
+            }
+            case 0x44 :                                                                                                                   /* config error */
+            {
+                i += 2;                                                                                                                   /* index+2 */
+                
+                break;                                                                                                                    /* break */
+            }
+            default :
+            {
+                handle->debug_print("bmp384: header is invalid.\n");                                                                      /* header is invalid */
+                res = 1;                                                                                                                  /* set 1 */
+                
+                break;                                                                                                                    /* break */
+            }
         }
-    }
-    if ((status & (1 << 3)) != 0)                                                            /* if data ready */
-    {
-        if (handle->receive_callback != NULL)                                                /* if receive callback is valid */
+        if (res == 1)                                                                                                                     /* check the result */
         {
-            handle->receive_callback(BMP384_INTERRUPT_STATUS_DATA_READY);                    /* run receive callback */
+            return 1;                                                                                                                     /* return error */
         }
     }
+    *frame_len = frame_total;                                                                                                             /* set frame length */
     
-    return 0;                                                                                /* success return 0 */
+    return 0;                                                                                                                             /* success return 0 */
 }
 
 /**
- * @brief     set the iic address pin
- * @param[in] *handle pointer to a bmp384 handle structure
- * @param[in] addr_pin iic address pin
- * @return    status code
- *            - 0 success
- *            - 2 handle is NULL
- * @note      none
+ * @brief         parse the fifo data
+ * @param[in]     *handle pointer to a bmp384 handle structure
+ * @param[in]     *buf pointer to fifo data
+ * @param[in]     buf_len fifo data length
+ * @param[out]    *frame pointer to a frame buffer
+ * @param[in,out] *frame_len pointer to a frame length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 fifo parse failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ * @note          none
  */
-uint8_t bmp384_set_addr_pin(bmp384_handle_t *handle, bmp384_address_t addr_pin)
+uint8_t bmp384_fifo_parse(bmp384_handle_t *handle, uint8_t *buf, uint16_t buf_len, bmp384_frame_t *frame, uint16_t *frame_len)
 {
-    if (handle == NULL)                          /* check handle */
-    {
-        return 2;                                /* return error */
-    }
-    
-    handle->iic_addr = (uint8_t)addr_pin;        /* set iic address */
-    
-    return 0;                                    /* success return 0 */
+    return a_bmp384_fifo_parse(handle, buf, buf_len, frame, NULL, frame_len);                 /* parse to float frames */
 }
 
 /**
- * @brief      get the iic address pin
- * @param[in]  *handle pointer to a bmp384 handle structure
- * @param[out] *addr_pin pointer to an iic address pin buffer
- * @return     status code
- *             - 0 success
- *             - 2 handle is NULL
- * @note       none
+ * @brief         parse the fifo data to fixed point frames
+ * @param[in]     *handle pointer to a bmp384 handle structure
+ * @param[in]     *buf pointer to fifo data
+ * @param[in]     buf_len fifo data length
+ * @param[out]    *frame pointer to a fixed point frame buffer
+ * @param[in,out] *frame_len pointer to a frame length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 fifo parse failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ * @note          data is in 0.01C or 0.01Pa without float conversion
  */
-uint8_t bmp384_get_addr_pin(bmp384_handle_t *handle, bmp384_address_t *addr_pin)
+uint8_t bmp384_fifo_parse_int(bmp384_handle_t *handle, uint8_t *buf, uint16_t buf_len, bmp384_frame_int_t *frame, uint16_t *frame_len)
 {
-    if (handle == NULL)                                    /* check handle */
+    if (handle == NULL)                                                                       /* check handle */
     {
-        return 2;                                          /* return error */
+        return 2;                                                                             /* return error */
+    }
+    if (handle->inited != 1)                                                                  /* check handle initialization */
+    {
+        return 3;                                                                             /* return error */
+    }
+    if ((buf == NULL) || (frame == NULL) || (frame_len == NULL))                              /* check buffer */
+    {
+        handle->debug_print("bmp384: buffer is null.\n");                                     /* buffer is null */
+        
+        return 1;                                                                             /* return error */
     }
     
-    *addr_pin = (bmp384_address_t)handle->iic_addr;        /* get iic address */
-    
-    return 0;                                              /* success return 0 */
+    return a_bmp384_fifo_parse(handle, buf, buf_len, NULL, frame, frame_len);                 /* parse to fixed point frames */
 }
 
 /**
- * @brief     set the interface
- * @param[in] *handle pointer to a bmp384 handle structure
- * @param[in] interface chip interface
- * @return    status code
- *            - 0 success
- *            - 2 handle is NULL
- * @note      none
+ * @brief         parse the fifo data to raw frames
+ * @param[in]     *handle pointer to a bmp384 handle structure
+ * @param[in]     *buf pointer to fifo data
+ * @param[in]     buf_len fifo data length
+ * @param[out]    *frame pointer to a raw frame buffer
+ * @param[in,out] *frame_len pointer to a frame length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 fifo parse raw failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ * @note          no compensation is run, use bmp384_fifo_compensate_raw or bmp384_compensate_temperature
+ *                and bmp384_compensate_pressure later for the frames that are used
  */
-uint8_t bmp384_set_interface(bmp384_handle_t *handle, bmp384_interface_t interface) 
+uint8_t bmp384_fifo_parse_raw(bmp384_handle_t *handle, uint8_t *buf, uint16_t buf_len, bmp384_frame_raw_t *frame, uint16_t *frame_len)
 {
-    if (handle == NULL)                        /* check handle */
+    uint8_t n;
+    uint16_t i;
+    uint16_t frame_total;
+    
+    if (handle == NULL)                                                           /* check handle */
     {
-        return 2;                              /* return error */
+        return 2;                                                                 /* return error */
+    }
+    if (handle->inited != 1)                                                      /* check handle initialization */
+    {
+        return 3;                                                                 /* return error */
+    }
+    if ((buf == NULL) || (frame == NULL) || (frame_len == NULL))                  /* check buffer */
+    {
+        handle->debug_print("bmp384: buffer is null.\n");                         /* buffer is null */
+        
+        return 1;                                                                 /* return error */
     }
     
-    handle->iic_spi = (uint8_t)interface;      /* set interface */
+    frame_total = 0;                                                              /* clear total frame */
+    i = 0;                                                                        /* set 0 */
+    while (i < buf_len)                                                           /* loop */
+    {
+        n = a_bmp384_fifo_frame_length(buf[i]);                                   /* get frame length */
+        if (n == 0)                                                               /* check header */
+        {
+            handle->debug_print("bmp384: header is invalid.\n");                  /* header is invalid */
+            
+            return 1;                                                             /* return error */
+        }
+        if ((uint32_t)i + n > buf_len)                                            /* check partial frame */
+        {
+            break;                                                                /* ignore the partial frame */
+        }
+        if (n > 2)                                                                /* data frame */
+        {
+            if ((frame_total + ((buf[i] == 0x94) ? 2 : 1)) > (*frame_len))        /* check length */
+            {
+                break;                                                            /* frame buffer is full */
+            }
+            frame[frame_total].type = (buf[i] == 0xA0) ? (uint8_t)BMP384_FRAME_TYPE_SENSORTIME : 
+                                      (uint8_t)BMP384_FRAME_TYPE_TEMPERATURE;     /* set type */
+            frame[frame_total].raw = (uint32_t)buf[i + 3] << 16 | 
+                                     (uint32_t)buf[i + 2] << 8 | buf[i + 1];      /* set raw */
+            frame_total++;                                                        /* frame++ */
+            if (buf[i] == 0x94)                                                   /* pressure */
+            {
+                frame[frame_total].type = (uint8_t)BMP384_FRAME_TYPE_PRESSURE;    /* set type */
+                frame[frame_total].raw = (uint32_t)buf[i + 6] << 16 | 
+                                         (uint32_t)buf[i + 5] << 8 | buf[i + 4];  /* set raw */
+                frame_total++;                                                    /* frame++ */
+            }
+        }
+        i += n;                                                                   /* next frame */
+    }
+    *frame_len = frame_total;                                                     /* set frame length */
     
-    return 0;                                  /* success return 0 */
+    return 0;                                                                     /* success return 0 */
 }
 
 /**
- * @brief      get the interface
+ * @brief      compensate the raw frames
  * @param[in]  *handle pointer to a bmp384 handle structure
- * @param[out] *interface pointer to a chip interface buffer
+ * @param[in]  *raw pointer to a raw frame buffer
+ * @param[in]  len raw frame length
+ * @param[out] *frame pointer to a frame buffer
  * @return     status code
  *             - 0 success
+ *             - 1 compensate raw failed
  *             - 2 handle is NULL
- * @note       none
+ *             - 3 handle is not initialized
+ * @note       frame[i] is made from raw[i], a pressure frame uses the t_fine of the last temperature frame
  */
-uint8_t bmp384_get_interface(bmp384_handle_t *handle, bmp384_interface_t *interface)
+uint8_t bmp384_fifo_compensate_raw(bmp384_handle_t *handle, const bmp384_frame_raw_t *raw, uint16_t len, bmp384_frame_t *frame)
 {
-    if (handle == NULL)                                        /* check handle */
+    uint16_t i;
+    
+    if (handle == NULL)                                                                            /* check handle */
     {
-        return 2;                                              /* return error */
+        return 2;                                                                                  /* return error */
+    }
+    if (handle->inited != 1)                                                                       /* check handle initialization */
+    {
+        return 3;                                                                                  /* return error */
+    }
+    if ((raw == NULL) || (frame == NULL))                                                          /* check buffer */
+    {
+        handle->debug_print("bmp384: buffer is null.\n");                                          /* buffer is null */
+        
+        return 1;                                                                                  /* return error */
     }
     
-    *interface = (bmp384_interface_t)(handle->iic_spi);        /* get interface */
+    for (i = 0; i < len; i++)                                                                      /* compensate all frames */
+    {
+        if (raw[i].type == (uint8_t)BMP384_FRAME_TYPE_TEMPERATURE)                                 /* temperature */
+        {
+            a_bmp384_fifo_set_frame(frame, NULL, i, BMP384_FRAME_TYPE_TEMPERATURE, raw[i].raw, 
+                                    a_bmp384_compensate_temperature(handle, raw[i].raw));          /* set compensate temperature */
+        }
+        else if (raw[i].type == (uint8_t)BMP384_FRAME_TYPE_PRESSURE)                               /* pressure */
+        {
+            a_bmp384_fifo_set_frame(frame, NULL, i, BMP384_FRAME_TYPE_PRESSURE, raw[i].raw, 
+                                    a_bmp384_compensate_pressure(handle, raw[i].raw));             /* set compensate pressure */
+        }
+        else if (raw[i].type == (uint8_t)BMP384_FRAME_TYPE_SENSORTIME)                             /* sensor time */
+        {
+            a_bmp384_fifo_set_frame(frame, NULL, i, BMP384_FRAME_TYPE_SENSORTIME, raw[i].raw, 0);  /* set sensor time */
+        }
+        else
+        {
+            handle->debug_print("bmp384: frame type is invalid.\n");                               /* frame type is invalid */
+            
+            return 1;                                                                              /* return error */
+        }
+    }
     
-    return 0;                                                  /* success return 0 */
+    return 0;                                                                                      /* success return 0 */
 }
 
 /**
- * @brief         read the fifo
+ * @brief         parse the fifo data to paired samples
  * @param[in]     *handle pointer to a bmp384 handle structure
- * @param[in]     *buf pointer to a data buffer
- * @param[in,out] *len pointer to a data length buffer
+ * @param[in]     *buf pointer to fifo data
+ * @param[in]     buf_len fifo data length
+ * @param[out]    *sample pointer to a sample buffer
+ * @param[in,out] *sample_len pointer to a sample length buffer
  * @return        status code
  *                - 0 success
- *                - 1 read fifo failed
+ *                - 1 fifo parse sample failed
  *                - 2 handle is NULL
  *                - 3 handle is not initialized
- * @note          none
+ * @note          one sample is made from each temperature and pressure frame,
+ *                temperature only frames update the compensation and sensor time frames are skipped,
+ *                the sample index is cleared by bmp384_flush_fifo,
+ *                a sensor time frame back fills the sensortime of the samples before it from the odr and
+ *                fifo subsampling, taking the sensor time as the time of the last data frame,
+ *                they come from the register shadow when it is enabled, otherwise they are read once
+ *                and cached until the driver writes them again,
+ *                a back filled sensortime has BMP384_SAMPLE_SENSORTIME_VALID set and is 0 otherwise,
+ *                samples beyond sample_len are dropped but still advance the sample index,
+ *                the temperature saturates to the int16_t range
  */
-uint8_t bmp384_read_fifo(bmp384_handle_t *handle, uint8_t *buf, uint16_t *len)
+uint8_t bmp384_fifo_parse_sample(bmp384_handle_t *handle, uint8_t *buf, uint16_t buf_len, bmp384_sample_t *sample, uint16_t *sample_len)
 {
-    uint8_t res;
-    uint8_t prev;
-    uint8_t tmp_buf[2];
-    uint16_t length;
+    uint8_t n;
+    uint8_t shift;
+    uint8_t reg[BMP384_REG_ODR - BMP384_REG_FIFO_CONFIG_2 + 1];
+    uint16_t i;
+    uint16_t j;
+    uint16_t start;
+    uint16_t first;
+    uint16_t sample_total;
+    uint32_t raw;
+    uint32_t frame_count;
     
     if (handle == NULL)                                                                             /* check handle */
     {
@@ -3690,173 +6461,241 @@ uint8_t bmp384_read_fifo(bmp384_handle_t *handle, uint8_t *buf, uint16_t *len)
     {
         return 3;                                                                                   /* return error */
     }
-    
-    res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_1, (uint8_t *)&prev, 1);             /* read config */
-    if (res != 0)                                                                                   /* check result */
+    if ((buf == NULL) || (sample == NULL) || (sample_len == NULL))                                  /* check buffer */
     {
-        handle->debug_print("bmp384: get fifo config 1 register failed.\n");                        /* get fifo config 1 register failed */
-       
+        handle->debug_print("bmp384: buffer is null.\n");                                           /* buffer is null */
+        
         return 1;                                                                                   /* return error */
     }
-    if ((prev & 0x01) != 0)                                                                         /* check mode */
+    
+    if (handle->shadow_enable != 0)                                                                 /* register shadow */
     {
-        res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_LENGTH_0, (uint8_t *)tmp_buf, 2);       /* read config */
-        if (res != 0)                                                                               /* check result */
+        shift = (uint8_t)((handle->shadow[BMP384_REG_ODR - BMP384_REG_FIFO_WTM_0] & 0x1F) + 
+                          (handle->shadow[BMP384_REG_FIFO_CONFIG_2 - BMP384_REG_FIFO_WTM_0] & 0x07)); /* get the period shift */
+    }
+    else
+    {
+        if (handle->fifo_period_valid == 0)                                                         /* not cached */
         {
-            handle->debug_print("bmp384: get fifo length register failed.\n");                      /* get fifo length register failed */
-           
+            if (a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_CONFIG_2, (uint8_t *)reg, 
+                                      BMP384_REG_ODR - BMP384_REG_FIFO_CONFIG_2 + 1) != 0)          /* read fifo config 2 to odr */
+            {
+                handle->debug_print("bmp384: get odr register failed.\n");                         /* get odr register failed */
+                
+                return 1;                                                                           /* return error */
+            }
+            handle->fifo_period_shift = (uint8_t)((reg[BMP384_REG_ODR - BMP384_REG_FIFO_CONFIG_2] & 0x1F) + 
+                                                  (reg[0] & 0x07));                                 /* cache the period shift */
+            handle->fifo_period_valid = 1;                                                          /* set valid */
+        }
+        shift = handle->fifo_period_shift;                                                          /* get the period shift */
+    }
+    frame_count = 0;                                                                                /* clear frame count */
+    start = 0;                                                                                      /* first frame without sensor time */
+    first = 0;                                                                                      /* first sample without sensor time */
+    sample_total = 0;                                                                               /* clear total sample */
+    i = 0;                                                                                          /* set 0 */
+    while (i < buf_len)                                                                             /* loop */
+    {
+        n = a_bmp384_fifo_frame_length(buf[i]);                                                     /* get frame length */
+        if (n == 0)                                                                                 /* check header */
+        {
+            handle->debug_print("bmp384: header is invalid.\n");                                    /* header is invalid */
+            
             return 1;                                                                               /* return error */
         }
-        length = ((uint16_t)(tmp_buf[1] & 0x01) << 8) | tmp_buf[0];                                 /* get data */
-        if ((prev & (1 << 2)) != 0)                                                                 /* if include sensor time */
+        if ((uint32_t)i + n > buf_len)                                                              /* check partial frame */
         {
-            length += 4;                                                                            /* add sensor time length */
-        }            
-        *len = (*len) < length ? (*len) :length;                                                    /* get real length */
-        res = a_bmp384_iic_spi_read(handle, BMP384_REG_FIFO_DATA, (uint8_t *)buf, *len);            /* read config */
-        if (res != 0)                                                                               /* check result */
+            break;                                                                                  /* ignore the partial frame */
+        }
+        if ((buf[i] == 0x94) && (sample_total >= (*sample_len)))                                    /* sample buffer is full */
         {
-            handle->debug_print("bmp384: get fifo data failed.\n");                                 /* get fifo data failed */
-           
-            return 1;                                                                               /* return error */
+            frame_count++;                                                                          /* frame++ */
+            handle->fifo_sample_index++;                                                            /* index++ for the dropped sample */
         }
-        
-        return 0;                                                                                   /* success return 0 */
+        else if (buf[i] == 0x94)                                                                    /* temperature and pressure */
+        {
+            raw = (uint32_t)buf[i + 3] << 16 | (uint32_t)buf[i + 2] << 8 | buf[i + 1];              /* get raw temperature */
+            sample[sample_total].index = handle->fifo_sample_index;                                 /* set index */
+            memcpy(sample[sample_total].temperature_raw, &buf[i + 1], 3);                           /* set raw temperature */
+            memcpy(sample[sample_total].pressure_raw, &buf[i + 4], 3);                              /* set raw pressure */
+            sample[sample_total].temperature = 
+                a_bmp384_sample_temperature(a_bmp384_compensate_temperature(handle, raw));          /* set temperature in 0.01C */
+            raw = (uint32_t)buf[i + 6] << 16 | (uint32_t)buf[i + 5] << 8 | buf[i + 4];              /* get raw pressure */
+            sample[sample_total].pressure = (uint32_t)a_bmp384_compensate_pressure(handle, raw);    /* set pressure in 0.01Pa */
+            sample[sample_total].sensortime = 0;                                                    /* no sensor time yet */
+            frame_count++;                                                                          /* frame++ */
+            handle->fifo_sample_index++;                                                            /* index++ */
+            sample_total++;                                                                         /* sample++ */
+        }
+        else if (buf[i] == 0x90)                                                                    /* temperature only */
+        {
+            raw = (uint32_t)buf[i + 3] << 16 | (uint32_t)buf[i + 2] << 8 | buf[i + 1];              /* get raw temperature */
+            (void)a_bmp384_compensate_temperature(handle, raw);                                     /* update t_fine */
+            frame_count++;                                                                          /* frame++ */
+        }
+        else if (buf[i] == 0xA0)                                                                    /* sensor time */
+        {
+            raw = (uint32_t)buf[i + 3] << 16 | (uint32_t)buf[i + 2] << 8 | buf[i + 1];              /* get sensor time */
+            for (j = start; j < i; j += a_bmp384_fifo_frame_length(buf[j]))                         /* walk the frames again */
+            {
+                if ((buf[j] == 0x94) || (buf[j] == 0x90))                                           /* data frame */
+                {
+                    frame_count--;                                                                  /* frames after this one */
+                    if ((buf[j] == 0x94) && (first < sample_total))                                 /* kept sample */
+                    {
+                        sample[first].sensortime = ((raw - ((frame_count << shift) * 
+                                                    BMP384_FIFO_SENSORTIME_PERIOD)) & 0xFFFFFF) | 
+                                                    BMP384_SAMPLE_SENSORTIME_VALID;                 /* set sensor time */
+                        first++;                                                                    /* next sample */
+                    }
+                }
+            }
+            start = i + n;                                                                          /* next frame without sensor time */
+            first = sample_total;                                                                   /* next sample without sensor time */
+        }
+        else
+        {
+            
+        }
+        i += n;                                                                                     /* next frame */
     }
-    else
+    *sample_len = sample_total;                                                                     /* set sample length */
+    
+    return 0;                                                                                       /* success return 0 */
+}
+
+/**
+ * @brief     reset the fifo stream
+ * @param[in] *stream pointer to a fifo stream structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 stream is NULL
+ * @note      call it before the first chunk and after a fifo flush
+ */
+uint8_t bmp384_fifo_stream_reset(bmp384_fifo_stream_t *stream)
+{
+    if (stream == NULL)                                                                       /* check stream */
     {
-        handle->debug_print("bmp384: normal mode or forced mode can't use this function.\n");       /* normal mode or forced mode can't use this function */
-           
-        return 1;                                                                                   /* return error */
+        return 1;                                                                             /* return error */
     }
+    
+    stream->len = 0;                                                                          /* clear partial frame */
+    
+    return 0;                                                                                 /* success return 0 */
 }
 
 /**
- * @brief         parse the fifo data
+ * @brief         parse one chunk of a fifo stream
  * @param[in]     *handle pointer to a bmp384 handle structure
+ * @param[in]     *stream pointer to a fifo stream structure
  * @param[in]     *buf pointer to fifo data
  * @param[in]     buf_len fifo data length
  * @param[out]    *frame pointer to a frame buffer
  * @param[in,out] *frame_len pointer to a frame length buffer
  * @return        status code
  *                - 0 success
- *                - 1 fifo parse failed
+ *                - 1 fifo stream parse failed
  *                - 2 handle is NULL
  *                - 3 handle is not initialized
- * @note          none
+ *                - 4 frame_len is too small
+ * @note          a frame split at the end of buf is kept in the stream and finished by the next chunk,
+ *                frame_len >= buf_len / 3 + 3
  */
-uint8_t bmp384_fifo_parse(bmp384_handle_t *handle, uint8_t *buf, uint16_t buf_len, bmp384_frame_t *frame, uint16_t *frame_len)
+uint8_t bmp384_fifo_stream_parse(bmp384_handle_t *handle, bmp384_fifo_stream_t *stream, uint8_t *buf, uint16_t buf_len,
+                                 bmp384_frame_t *frame, uint16_t *frame_len)
 {
     uint8_t res;
+    uint8_t n;
     uint16_t i;
+    uint16_t start;
+    uint16_t len;
     uint16_t frame_total;
     
-    if (handle == NULL)                                                                                                                   /* check handle */
+    if (handle == NULL)                                                               /* check handle */
     {
-        return 2;                                                                                                                         /* return error */
+        return 2;                                                                     /* return error */
     }
-    if (handle->inited != 1)                                                                                                              /* check handle initialization */
+    if (handle->inited != 1)                                                          /* check handle initialization */
     {
-        return 3;                                                                                                                         /* return error */
+        return 3;                                                                     /* return error */
+    }
+    if ((stream == NULL) || (buf == NULL) || (frame == NULL) || (frame_len == NULL))  /* check buffer */
+    {
+        handle->debug_print("bmp384: buffer is null.\n");                             /* buffer is null */
+        
+        return 1;                                                                     /* return error */
+    }
+    if ((*frame_len) < (buf_len / 3 + 3))                                             /* check frame length */
+    {
+        handle->debug_print("bmp384: frame_len is too small.\n");                     /* frame_len is too small */
+        
+        return 4;                                                                     /* return error */
     }
     
-    if (buf_len == 0)                                                                                                                     /* check buffer length */
+    frame_total = 0;                                                                  /* clear total frame */
+    start = 0;                                                                        /* set 0 */
+    if (stream->len != 0)                                                             /* finish the partial frame */
     {
-        handle->debug_print("bmp384: buffer length is invalid.\n");                                                                       /* buffer length is invalid */
-       
-        return 1;                                                                                                                         /* return error */
-    } 
-    frame_total = 0;                                                                                                                      /* clear total frame */
-    res = 0;                                                                                                                              /* set 0 */
-    i = 0;                                                                                                                                /* set 0 */
-    while (i < buf_len)                                                                                                                   /* loop */
+        n = a_bmp384_fifo_frame_length(stream->buf[0]);                               /* get frame length */
+        while ((stream->len < n) && (start < buf_len))                                /* copy the rest bytes */
+        {
+            stream->buf[stream->len] = buf[start];                                    /* copy one byte */
+            stream->len++;                                                            /* length++ */
+            start++;                                                                  /* index++ */
+        }
+        if (stream->len < n)                                                          /* still partial */
+        {
+            *frame_len = 0;                                                           /* no frame */
+            
+            return 0;                                                                 /* success return 0 */
+        }
+        len = (*frame_len);                                                           /* set frame length */
+        res = a_bmp384_fifo_parse(handle, stream->buf, n, frame, NULL, &len);         /* parse the frame */
+        stream->len = 0;                                                              /* clear partial frame */
+        if (res != 0)                                                                 /* check result */
+        {
+            return 1;                                                                 /* return error */
+        }
+        frame_total = len;                                                            /* set frame total */
+    }
+    
+    i = start;                                                                        /* set start */
+    while (i < buf_len)                                                               /* find the last complete frame */
     {
-        switch ((uint8_t)buf[i])
+        n = a_bmp384_fifo_frame_length(buf[i]);                                       /* get frame length */
+        if (n == 0)                                                                   /* check header */
         {
-            case 0x90 :
-            {
-                if (frame_total > ((*frame_len)-1))                                                                                       /* check length */
-                {
-                    return 0;                                                                                                             /* return success */
-                }
-                frame[frame_total].type =  BMP384_FRAME_TYPE_TEMPERATURE;                                                                 /* set temperature type */
-                frame[frame_total].raw = (uint32_t)buf[i + 2 + 1] << 16 | (uint32_t)buf[i + 1 + 1] << 8 | buf[i + 0 + 1];                 /* set raw */
-                frame[frame_total].data = (float)((double)a_bmp384_compensate_temperature(handle, frame[frame_total].raw) / 100.0);       /* set compensate temperature */
-                frame_total++;                                                                                                            /* frame++ */
-                i += 4;                                                                                                                   /* index + 4 */
-                
-                break;                                                                                                                    /* break */
-            }
-            case 0x94 :
-            {
-                if ((frame_total) > ((*frame_len)-1))                                                                                     /* check length */
-                {
-                    return 0;                                                                                                             /* return success */
-                }
-                frame[frame_total].type =  BMP384_FRAME_TYPE_TEMPERATURE;                                                                 /* set temperature type */
-                frame[frame_total].raw = (uint32_t)buf[i + 2 + 1] << 16 | (uint32_t)buf[i + 1 + 1] << 8 | buf[i + 0 + 1];                 /* set raw */
-                frame[frame_total].data = (float)((double)a_bmp384_compensate_temperature(handle, frame[frame_total].raw) / 100.0);       /* set compensate temperature */
-                frame_total++;                                                                                                            /* frame++ */
-                if (frame_total > ((*frame_len)-1))                                                                                       /* check length */
-                {
-                    return 0;                                                                                                             /* return success */
-                }
-                frame[frame_total].type =  BMP384_FRAME_TYPE_PRESSURE;                                                                    /* set pressure type */
-                frame[frame_total].raw = (uint32_t)buf[i + 5 + 1] << 16 | (uint32_t)buf[i + 4 + 1] << 8 | buf[i + 3 + 1];                 /* set raw */
-                frame[frame_total].data = (float)((double)a_bmp384_compensate_pressure(handle, frame[frame_total].raw) / 100.0);          /* set compensate pressure */
-                frame_total++;                                                                                                            /* frame++ */
-                i += 7;                                                                                                                   /* index + 7 */
-                
-                break;                                                                                                                    /* break */
-            }
-            case 0xA0 :
-            {
-                if (frame_total > ((*frame_len)-1))                                                                                       /* check length */
-                {
-                    return 0;                                                                                                             /* return success */
-                }
-                frame[frame_total].type =  BMP384_FRAME_TYPE_SENSORTIME;                                                                  /* set sensor time type */
-                frame[frame_total].raw = (uint32_t)buf[i + 2 + 1] << 16 | (uint32_t)buf[i + 1 + 1] << 8 | buf[i + 0 + 1];                 /* set raw */
-                frame[frame_total].data = 0;                                                                                              /* set data */
-                frame_total++;                                                                                                            /* frame++ */
-                i += 4;                                                                                                                   /* index+4 */
-                
-                break;                                                                                                                    /* break */
-            }
-            case 0x80 :                                                                                                                   /* fifo empty */
-            {
-                i += 2;                                                                                                                   /* index+2 */
-                
-                break;                                                                                                                    /* break */
-            }
-            case 0x48 :                                                                                                                   /* fifo input config */
-            {
-                i += 2;                                                                                                                   /* index+2 */
-                
-                break;                                                                                                                    /* break */
-            }
-            case 0x44 :                                                                                                                   /* config error */
-            {
-                i += 2;                                                                                                                   /* index+2 */
-                
-                break;                                                                                                                    /* break */
-            }
-            default :
-            {
-                handle->debug_print("bmp384: header is invalid.\n");                                                                      /* header is invalid */
-                res = 1;                                                                                                                  /* set 1 */
-                
-                break;                                                                                                                    /* break */
-            }
+            handle->debug_print("bmp384: header is invalid.\n");                      /* header is invalid */
+            
+            return 1;                                                                 /* return error */
         }
-        if (res == 1)                                                                                                                     /* check the result */
+        if ((uint32_t)i + n > buf_len)                                                /* check partial frame */
         {
-            return 1;                                                                                                                     /* return error */
+            break;                                                                    /* break */
         }
+        i += n;                                                                       /* next frame */
     }
-    *frame_len = frame_total;                                                                                                             /* set frame length */
+    if (i > start)                                                                    /* parse the complete frames */
+    {
+        len = (*frame_len) - frame_total;                                             /* set frame length */
+        res = a_bmp384_fifo_parse(handle, &buf[start], i - start, 
+                                  &frame[frame_total], NULL, &len);                   /* parse the frames */
+        if (res != 0)                                                                 /* check result */
+        {
+            return 1;                                                                 /* return error */
+        }
+        frame_total += len;                                                           /* add frame total */
+    }
+    while (i < buf_len)                                                               /* save the partial frame */
+    {
+        stream->buf[stream->len] = buf[i];                                            /* copy one byte */
+        stream->len++;                                                                /* length++ */
+        i++;                                                                          /* index++ */
+    }
+    *frame_len = frame_total;                                                         /* set frame length */
     
-    return 0;                                                                                                                             /* success return 0 */
+    return 0;                                                                         /* success return 0 */
 }
 
 /**
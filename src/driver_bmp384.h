@@ -56,6 +56,50 @@ extern "C"{
  * @{
  */
 
+/**
+ * @brief bmp384 pressure compensation kernel definition
+ * @note  set 1 to replace the 64-bit divisions with shifts on targets without a 64-bit divider,
+ *        the multiplications keep their 64-bit width in both kernels
+ */
+#ifndef BMP384_COMPENSATE_PRESSURE_SHIFT
+    #define BMP384_COMPENSATE_PRESSURE_SHIFT 0        /**< use the division based kernel */
+#endif
+
+/**
+ * @brief bmp384 batch compensation simd definition
+ * @note  set 0 to keep bmp384_compensate_batch on the scalar kernel when sse4.1, avx2 or neon is enabled
+ */
+#ifndef BMP384_COMPENSATE_BATCH_SIMD
+    #define BMP384_COMPENSATE_BATCH_SIMD 1        /**< use the simd kernel of the target */
+#endif
+
+/**
+ * @brief bmp384 spi inner buffer length definition
+ * @note  payload bytes of one spi bounce chunk, set 0 to drop the inner buffer from the handle
+ *        on iic only builds or when every spi handle links spi_read_direct or a scratch buffer
+ */
+#ifndef BMP384_SPI_BUFFER_LENGTH
+    #define BMP384_SPI_BUFFER_LENGTH 512        /**< one full fifo per chunk */
+#endif
+
+/**
+ * @brief bmp384 clock sync window definition
+ * @note  effective number of pairs in the drift fit, older pairs fade by 1 - 1 / window per pair
+ */
+#ifndef BMP384_CLOCK_SYNC_WINDOW
+    #define BMP384_CLOCK_SYNC_WINDOW 64        /**< 64 pairs */
+#endif
+
+/**
+ * @brief bmp384 calibration snapshot length definition
+ */
+#define BMP384_CALIBRATION_SNAPSHOT_LENGTH 25        /**< version, chip id, 21 calibration bytes and crc16 */
+
+/**
+ * @brief bmp384 fifo max frame length definition
+ */
+#define BMP384_FIFO_FRAME_MAX_LENGTH 7        /**< header, temperature and pressure */
+
 /**
  * @brief bmp384 interface enumeration definition
  */
@@ -240,6 +284,47 @@ typedef enum
     BMP384_FRAME_TYPE_SENSORTIME  = 0x03,        /**< sensor time frame type */
 } bmp384_frame_type_t;
 
+/**
+ * @brief bmp384 fixed point frame structure definition
+ */
+typedef struct bmp384_frame_int_s
+{
+    bmp384_frame_type_t type;        /**< frame type */
+    uint32_t raw;                    /**< raw data */
+    int32_t data;                    /**< data in 0.01C or 0.01Pa */
+} bmp384_frame_int_t;
+
+/**
+ * @brief bmp384 config structure definition
+ */
+typedef struct bmp384_config_s
+{
+    uint16_t fifo_watermark;                                         /**< fifo watermark */
+    bmp384_bool_t fifo;                                              /**< fifo enable */
+    bmp384_bool_t fifo_stop_on_full;                                 /**< fifo stop on full */
+    bmp384_bool_t fifo_sensortime_on;                                /**< fifo sensortime on */
+    bmp384_bool_t fifo_pressure_on;                                  /**< fifo pressure on */
+    bmp384_bool_t fifo_temperature_on;                               /**< fifo temperature on */
+    uint8_t fifo_subsampling;                                        /**< fifo subsampling */
+    bmp384_fifo_data_source_t fifo_data_source;                      /**< fifo data source */
+    bmp384_interrupt_pin_type_t interrupt_pin_type;                  /**< interrupt pin type */
+    bmp384_interrupt_active_level_t interrupt_active_level;          /**< interrupt active level */
+    bmp384_bool_t latch_interrupt_pin_and_interrupt_status;          /**< latch interrupt pin and interrupt status */
+    bmp384_bool_t interrupt_fifo_watermark;                          /**< interrupt fifo watermark */
+    bmp384_bool_t interrupt_fifo_full;                               /**< interrupt fifo full */
+    bmp384_bool_t interrupt_data_ready;                              /**< interrupt data ready */
+    bmp384_spi_wire_t spi_wire;                                      /**< spi wire */
+    bmp384_bool_t iic_watchdog_timer;                                /**< iic watchdog timer */
+    bmp384_iic_watchdog_period_t iic_watchdog_period;                /**< iic watchdog period */
+    bmp384_bool_t pressure;                                          /**< pressure enable */
+    bmp384_bool_t temperature;                                       /**< temperature enable */
+    bmp384_mode_t mode;                                              /**< chip mode */
+    bmp384_oversampling_t pressure_oversampling;                     /**< pressure oversampling */
+    bmp384_oversampling_t temperature_oversampling;                  /**< temperature oversampling */
+    bmp384_odr_t odr;                                                /**< output data rate */
+    bmp384_filter_coefficient_t filter_coefficient;                  /**< filter coefficient */
+} bmp384_config_t;
+
 /**
  * @brief bmp384 frame structure definition
  */
@@ -250,13 +335,158 @@ typedef struct bmp384_frame_s
     float data;                      /**< converted data */
 } bmp384_frame_t;
 
+/**
+ * @brief bmp384 raw frame structure definition
+ */
+typedef struct bmp384_frame_raw_s
+{
+    uint8_t type;            /**< frame type */
+    uint32_t raw;            /**< raw data */
+} bmp384_frame_raw_t;
+
+/**
+ * @brief bmp384 sample sensor time valid flag definition
+ */
+#define BMP384_SAMPLE_SENSORTIME_VALID 0x80000000U        /**< set in sensortime when the sensor time is back filled */
+
+/**
+ * @brief bmp384 fifo sample structure definition
+ */
+typedef struct bmp384_sample_s
+{
+    uint32_t index;                  /**< sample index */
+    uint32_t pressure;               /**< pressure in 0.01Pa */
+    uint32_t sensortime;             /**< sensor time in bits 0 to 23 and BMP384_SAMPLE_SENSORTIME_VALID */
+    uint8_t temperature_raw[3];      /**< 24 bits raw temperature, little endian */
+    uint8_t pressure_raw[3];         /**< 24 bits raw pressure, little endian */
+    int16_t temperature;             /**< temperature in 0.01C */
+} bmp384_sample_t;
+
+/**
+ * @brief     get the 24 bits raw value of a sample
+ * @param[in] RAW temperature_raw or pressure_raw of a sample
+ * @note      none
+ */
+#define BMP384_SAMPLE_RAW(RAW) ((uint32_t)(RAW)[2] << 16 | (uint32_t)(RAW)[1] << 8 | (uint32_t)(RAW)[0])
+
+/**
+ * @brief bmp384 fifo stream structure definition
+ */
+typedef struct bmp384_fifo_stream_s
+{
+    uint8_t buf[BMP384_FIFO_FRAME_MAX_LENGTH];        /**< partial frame buffer */
+    uint8_t len;                                      /**< partial frame length */
+} bmp384_fifo_stream_t;
+
+/**
+ * @brief bmp384 stream data structure definition
+ */
+typedef struct bmp384_stream_data_s
+{
+    uint8_t status;                  /**< status register */
+    uint32_t temperature_raw;        /**< raw temperature */
+    float temperature_c;             /**< converted temperature */
+    uint32_t pressure_raw;           /**< raw pressure */
+    float pressure_pa;               /**< converted pressure */
+    uint32_t sensortime;             /**< sensor time */
+} bmp384_stream_data_t;
+
+/**
+ * @brief bmp384 calibration structure definition
+ */
+typedef struct bmp384_calibration_s
+{
+    uint16_t t1;        /**< t1 register */
+    uint16_t t2;        /**< t2 register */
+    int8_t t3;          /**< t3 register */
+    int16_t p1;         /**< p1 register */
+    int16_t p2;         /**< p2 register */
+    int8_t p3;          /**< p3 register */
+    int8_t p4;          /**< p4 register */
+    uint16_t p5;        /**< p5 register */
+    uint16_t p6;        /**< p6 register */
+    int8_t p7;          /**< p7 register */
+    int8_t p8;          /**< p8 register */
+    int16_t p9;         /**< p9 register */
+    int8_t p10;         /**< p10 register */
+    int8_t p11;         /**< p11 register */
+} bmp384_calibration_t;
+
+/**
+ * @brief bmp384 pressure terms structure definition
+ */
+typedef struct bmp384_pressure_terms_s
+{
+    int64_t t_fine;             /**< t_fine of the terms */
+    int64_t offset;             /**< offset / 4 */
+    int64_t sensitivity;        /**< sensitivity / 2^24 */
+    int64_t linear;             /**< p10 * t_fine + p9 * 2^16 */
+} bmp384_pressure_terms_t;
+
+/**
+ * @brief bmp384 clock sync structure definition
+ */
+typedef struct bmp384_clock_sync_s
+{
+    uint32_t count;               /**< pair count */
+    uint32_t last_raw;            /**< last raw sensor time */
+    int64_t ticks;                /**< unwrapped sensor time of the last pair */
+    uint64_t host_ns0;            /**< host time of the first pair */
+    double weight;                /**< sum of the pair weights */
+    double mean_x;                /**< weighted mean of the unwrapped sensor time */
+    double mean_y;                /**< weighted mean of the host time since the first pair */
+    double cxx;                   /**< weighted sum of the sensor time squared deviations */
+    double cxy;                   /**< weighted sum of the sensor time and host time co-deviations */
+} bmp384_clock_sync_t;
+
+/**
+ * @brief bmp384 transfer max number definition
+ */
+#define BMP384_TRANSFER_MAX_NUM 4        /**< max transfer number of one iic_transfer or spi_transfer call */
+
+/**
+ * @brief bmp384 transfer structure definition
+ */
+typedef struct bmp384_transfer_s
+{
+    uint8_t reg;          /**< register address */
+    uint8_t read;         /**< 1 read, 0 write */
+    uint8_t *buf;         /**< data buffer */
+    uint16_t len;         /**< data length */
+} bmp384_transfer_t;
+
+/**
+ * @brief bmp384 transport structure definition
+ */
+typedef struct bmp384_transport_s
+{
+    uint8_t (*iic_init)(void *ctx);                                                                /**< point to an iic_init function address */
+    uint8_t (*iic_deinit)(void *ctx);                                                              /**< point to an iic_deinit function address */
+    uint8_t (*iic_read)(void *ctx, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);         /**< point to an iic_read function address */
+    uint8_t (*iic_write)(void *ctx, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);        /**< point to an iic_write function address */
+    uint8_t (*spi_init)(void *ctx);                                                                /**< point to a spi_init function address */
+    uint8_t (*spi_deinit)(void *ctx);                                                              /**< point to a spi_deinit function address */
+    uint8_t (*spi_read)(void *ctx, uint8_t reg, uint8_t *buf, uint16_t len);                       /**< point to a spi_read function address */
+    uint8_t (*spi_write)(void *ctx, uint8_t reg, uint8_t *buf, uint16_t len);                      /**< point to a spi_write function address */
+    uint8_t (*spi_read_direct)(void *ctx, uint8_t reg, uint8_t *buf, uint16_t len);                /**< point to an optional spi_read_direct function address */
+    uint8_t (*iic_transfer)(void *ctx, uint8_t addr, bmp384_transfer_t *transfer, uint16_t num);   /**< point to an optional iic_transfer function address */
+    uint8_t (*spi_transfer)(void *ctx, bmp384_transfer_t *transfer, uint16_t num);                /**< point to an optional spi_transfer function address */
+    void (*delay_ms)(void *ctx, uint32_t ms);                                                      /**< point to a delay_ms function address */
+    void (*receive_callback)(void *ctx, uint8_t type);                                             /**< point to a receive_callback function address */
+    void (*receive_data_callback)(void *ctx, uint8_t type, bmp384_sample_t *sample, uint16_t len); /**< point to a receive_data_callback function address */
+} bmp384_transport_t;
+
 /**
  * @brief bmp384 handle structure definition
  */
 typedef struct bmp384_handle_s
 {
     uint8_t iic_addr;                                                                   /**< iic device address */
-    uint8_t buf[512 + 1];                                                               /**< inner buffer */
+#if (BMP384_SPI_BUFFER_LENGTH > 0)
+    uint8_t buf[BMP384_SPI_BUFFER_LENGTH + 1];                                          /**< inner buffer */
+#endif
+    uint8_t *scratch;                                                                   /**< caller scratch buffer */
+    uint16_t scratch_len;                                                               /**< caller scratch buffer length */
     uint8_t (*iic_init)(void);                                                          /**< point to an iic_init function address */
     uint8_t (*iic_deinit)(void);                                                        /**< point to an iic_deinit function address */
     uint8_t (*iic_read)(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);         /**< point to an iic_read function address */
@@ -265,26 +495,31 @@ typedef struct bmp384_handle_s
     uint8_t (*spi_deinit)(void);                                                        /**< point to a spi_deinit function address */
     uint8_t (*spi_read)(uint8_t reg, uint8_t *buf, uint16_t len);                       /**< point to a spi_read function address */
     uint8_t (*spi_write)(uint8_t reg, uint8_t *buf, uint16_t len);                      /**< point to a spi_write function address */
+    uint8_t (*spi_read_direct)(uint8_t reg, uint8_t *buf, uint16_t len);                /**< point to an optional spi_read_direct function address */
+    uint8_t (*iic_transfer)(uint8_t addr, bmp384_transfer_t *transfer, uint16_t num);   /**< point to an optional iic_transfer function address */
+    uint8_t (*spi_transfer)(bmp384_transfer_t *transfer, uint16_t num);                /**< point to an optional spi_transfer function address */
     void (*receive_callback)(uint8_t type);                                             /**< point to a receive_callback function address */
+    void (*receive_data_callback)(uint8_t type, bmp384_sample_t *sample, uint16_t len); /**< point to a receive_data_callback function address */
     void (*delay_ms)(uint32_t ms);                                                      /**< point to a delay_ms function address */
     void (*debug_print)(const char *const fmt, ...);                                    /**< point to a debug_print function address */
+    const bmp384_transport_t *transport;                                                /**< context transport, overrides the functions above when linked */
+    void *ctx;                                                                          /**< user context passed to the transport */
     uint8_t inited;                                                                     /**< inited flag */
     uint8_t iic_spi;                                                                    /**< iic spi interface */
-    uint16_t t1;                                                                        /**< t1 register */
-    uint16_t t2;                                                                        /**< t2 register */
-    int8_t t3;                                                                          /**< t3 register */
-    int16_t p1;                                                                         /**< p1 register */
-    int16_t p2;                                                                         /**< p2 register */
-    int8_t p3;                                                                          /**< p3 register */
-    int8_t p4;                                                                          /**< p4 register */
-    uint16_t p5;                                                                        /**< p5 register */
-    uint16_t p6;                                                                        /**< p6 register */
-    int8_t p7;                                                                          /**< p7 register */
-    int8_t p8;                                                                          /**< p8 register */
-    int16_t p9;                                                                         /**< p9 register */
-    int8_t p10;                                                                         /**< p10 register */
-    int8_t p11;                                                                         /**< p11 register */
+    bmp384_calibration_t calibration;                                                   /**< calibration data */
     int64_t t_fine;                                                                     /**< t_fine register */
+    bmp384_pressure_terms_t pressure_terms;                                             /**< cached temperature dependent pressure terms */
+    uint8_t pressure_terms_valid;                                                       /**< pressure terms valid flag */
+    uint8_t shadow[11];                                                                 /**< register shadow from 0x15 to 0x1F */
+    uint8_t shadow_enable;                                                              /**< register shadow enable flag */
+    uint8_t stream_enable;                                                              /**< stream enable flag */
+    uint8_t stream_sensortime;                                                          /**< stream sensortime flag */
+    uint8_t stream_output;                                                              /**< stream enabled outputs */
+    uint8_t forced_enable;                                                              /**< forced mode enabled outputs */
+    uint32_t fifo_sample_index;                                                         /**< fifo sample index */
+    uint32_t drdy_sample_index;                                                         /**< data ready sample index */
+    uint8_t fifo_period_shift;                                                          /**< cached odr and fifo subsampling shift */
+    uint8_t fifo_period_valid;                                                          /**< cached shift valid flag */
 } bmp384_handle_t;
 
 /**
@@ -386,6 +621,44 @@ typedef struct bmp384_info_s
  */
 #define DRIVER_BMP384_LINK_SPI_WRITE(HANDLE, FUC)        (HANDLE)->spi_write = FUC
 
+/**
+ * @brief     link spi_read_direct function
+ * @param[in] HANDLE pointer to a bmp384 handle structure
+ * @param[in] FUC pointer to a spi_read_direct function address
+ * @note      optional, it sends reg, drops the dummy byte and reads len bytes straight into buf,
+ *            when linked spi reads skip the inner buffer and have no 512 bytes limit
+ */
+#define DRIVER_BMP384_LINK_SPI_READ_DIRECT(HANDLE, FUC) (HANDLE)->spi_read_direct = FUC
+
+/**
+ * @brief     link iic_transfer function
+ * @param[in] HANDLE pointer to a bmp384 handle structure
+ * @param[in] FUC pointer to an iic_transfer function address
+ * @note      optional, it runs all transfers in one bus transaction with repeated starts,
+ *            when linked multi step iic operations are sent in one call
+ */
+#define DRIVER_BMP384_LINK_IIC_TRANSFER(HANDLE, FUC) (HANDLE)->iic_transfer = FUC
+
+/**
+ * @brief     link spi_transfer function
+ * @param[in] HANDLE pointer to a bmp384 handle structure
+ * @param[in] FUC pointer to a spi_transfer function address
+ * @note      optional, it runs all transfers in one bus call with one chip select each,
+ *            a read sends reg and one dummy byte and reads len bytes straight into buf,
+ *            when linked multi step spi operations are sent in one call
+ */
+#define DRIVER_BMP384_LINK_SPI_TRANSFER(HANDLE, FUC) (HANDLE)->spi_transfer = FUC
+
+/**
+ * @brief     link spi scratch buffer
+ * @param[in] HANDLE pointer to a bmp384 handle structure
+ * @param[in] BUF pointer to a scratch buffer
+ * @param[in] LEN scratch buffer length
+ * @note      it replaces the inner buffer for spi bounce reads and LEN - 1 bytes are read per chunk,
+ *            handles on one bus may share it when their accesses are serialized
+ */
+#define DRIVER_BMP384_LINK_SCRATCH(HANDLE, BUF, LEN) ((HANDLE)->scratch = (BUF), (HANDLE)->scratch_len = (LEN))
+
 /**
  * @brief     link delay_ms function
  * @param[in] HANDLE pointer to a bmp384 handle structure
@@ -410,6 +683,31 @@ typedef struct bmp384_info_s
  */
 #define DRIVER_BMP384_LINK_RECEIVE_CALLBACK(HANDLE, FUC) (HANDLE)->receive_callback = FUC
 
+/**
+ * @brief     link receive_data_callback function
+ * @param[in] HANDLE pointer to a bmp384 handle structure
+ * @param[in] FUC pointer to a receive_data_callback function address
+ * @note      none
+ */
+#define DRIVER_BMP384_LINK_RECEIVE_DATA_CALLBACK(HANDLE, FUC) (HANDLE)->receive_data_callback = FUC
+
+/**
+ * @brief     link context transport
+ * @param[in] HANDLE pointer to a bmp384 handle structure
+ * @param[in] TRANSPORT pointer to a transport structure
+ * @note      the transport is shared and must outlive the handle,
+ *            only debug_print is still needed from the plain link functions
+ */
+#define DRIVER_BMP384_LINK_TRANSPORT(HANDLE, TRANSPORT) (HANDLE)->transport = TRANSPORT
+
+/**
+ * @brief     link user context
+ * @param[in] HANDLE pointer to a bmp384 handle structure
+ * @param[in] CTX pointer to a user context
+ * @note      none
+ */
+#define DRIVER_BMP384_LINK_CONTEXT(HANDLE, CTX) (HANDLE)->ctx = CTX
+
 /**
  * @}
  */
@@ -487,6 +785,32 @@ uint8_t bmp384_get_interface(bmp384_handle_t *handle, bmp384_interface_t *interf
  */
 uint8_t bmp384_irq_handler(bmp384_handle_t *handle);
 
+/**
+ * @brief     irq handler with the interrupt payload
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @param[in] *buf pointer to a fifo data buffer
+ * @param[in] buf_len fifo data buffer length
+ * @param[in] *sample pointer to a sample buffer
+ * @param[in] sample_len sample buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      one batched transfer reads 0x03 to 0x0E, 0x11 to 0x13 and the fifo config,
+ *            the event register 0x10 is skipped because reading it clears por_detected,
+ *            data ready passes one sample with the sensor time and a running index cleared by bmp384_init,
+ *            only the outputs flagged ready in the status register are set and the others are 0,
+ *            fifo watermark or full drains the whole fifo through buf in chunks of at most buf_len bytes,
+ *            a frame split at the end of a chunk is moved to the front of buf and finished by the next chunk,
+ *            the paired samples of each chunk are passed in one call, so only the samples of the last chunk
+ *            get the sensor time when buf_len is smaller than the 516 bytes of a full fifo,
+ *            buf_len >= BMP384_FIFO_FRAME_MAX_LENGTH,
+ *            samples are passed to receive_data_callback and receive_callback is not called
+ */
+uint8_t bmp384_irq_handler_read(bmp384_handle_t *handle, uint8_t *buf, uint16_t buf_len,
+                                bmp384_sample_t *sample, uint16_t sample_len);
+
 /**
  * @brief     initialize the chip
  * @param[in] *handle pointer to a bmp384 handle structure
@@ -515,6 +839,98 @@ uint8_t bmp384_init(bmp384_handle_t *handle);
  */
 uint8_t bmp384_deinit(bmp384_handle_t *handle);
 
+/**
+ * @brief     initialize the chip with a calibration snapshot
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @param[in] *snapshot pointer to a calibration snapshot buffer
+ * @param[in] len snapshot length
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic or spi initialization failed
+ *            - 2 handle is NULL
+ *            - 3 linked functions is NULL
+ *            - 4 id is invalid
+ *            - 5 reset failed
+ *            - 6 get calibration failed
+ * @note      if the snapshot fails validation the calibration data is read from the chip nvm
+ */
+uint8_t bmp384_init_with_calibration_snapshot(bmp384_handle_t *handle, const uint8_t *snapshot, uint16_t len);
+
+/**
+ * @brief      get the calibration snapshot
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *snapshot pointer to a calibration snapshot buffer
+ * @param[in]  len snapshot buffer length
+ * @return     status code
+ *             - 0 success
+ *             - 1 get calibration snapshot failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 len is too small
+ * @note       len >= BMP384_CALIBRATION_SNAPSHOT_LENGTH
+ */
+uint8_t bmp384_get_calibration_snapshot(bmp384_handle_t *handle, uint8_t *snapshot, uint16_t len);
+
+/**
+ * @brief      get the calibration data
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *calibration pointer to a calibration structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 calibration is NULL
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the copy can be shared by bmp384_compensate_temperature and bmp384_compensate_pressure
+ */
+uint8_t bmp384_get_calibration(bmp384_handle_t *handle, bmp384_calibration_t *calibration);
+
+/**
+ * @brief      compensate the raw temperature
+ * @param[in]  *calibration pointer to a calibration structure
+ * @param[in]  raw raw temperature
+ * @param[out] *temperature_c pointer to a compensated temperature buffer
+ * @param[out] *t_fine pointer to a t_fine buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 output is NULL
+ *             - 2 calibration is NULL
+ * @note       temperature_c is in 0.01C, the handle is not used so the function is reentrant
+ */
+uint8_t bmp384_compensate_temperature(const bmp384_calibration_t *calibration, uint32_t raw, int32_t *temperature_c, int64_t *t_fine);
+
+/**
+ * @brief      compensate the raw pressure
+ * @param[in]  *calibration pointer to a calibration structure
+ * @param[in]  raw raw pressure
+ * @param[in]  t_fine t_fine from bmp384_compensate_temperature
+ * @param[out] *pressure_pa pointer to a compensated pressure buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 output is NULL
+ *             - 2 calibration is NULL
+ * @note       pressure_pa is in 0.01Pa, the handle is not used so the function is reentrant
+ */
+uint8_t bmp384_compensate_pressure(const bmp384_calibration_t *calibration, uint32_t raw, int64_t t_fine, uint32_t *pressure_pa);
+
+/**
+ * @brief      compensate a batch of raw temperature and pressure pairs
+ * @param[in]  *calibration pointer to a calibration structure
+ * @param[in]  *temperature_raw pointer to a raw temperature array
+ * @param[in]  *pressure_raw pointer to a raw pressure array
+ * @param[in]  len array length
+ * @param[out] *temperature_c pointer to a compensated temperature array
+ * @param[out] *pressure_pa pointer to a compensated pressure array
+ * @return     status code
+ *             - 0 success
+ *             - 1 buffer is NULL
+ *             - 2 calibration is NULL
+ * @note       temperature_c is in 0.01C and pressure_pa is in 0.01Pa,
+ *             each output matches bmp384_compensate_temperature and bmp384_compensate_pressure,
+ *             the pressure runs on the sse4.1, avx2 or neon kernel when enabled by BMP384_COMPENSATE_BATCH_SIMD
+ */
+uint8_t bmp384_compensate_batch(const bmp384_calibration_t *calibration, const uint32_t *temperature_raw, const uint32_t *pressure_raw,
+                                uint32_t len, int32_t *temperature_c, uint32_t *pressure_pa);
+
 /**
  * @brief      read the temperature and pressure
  * @param[in]  *handle pointer to a bmp384 handle structure
@@ -532,6 +948,23 @@ uint8_t bmp384_deinit(bmp384_handle_t *handle);
 uint8_t bmp384_read_temperature_pressure(bmp384_handle_t *handle, uint32_t *temperature_raw, float *temperature_c, 
                                          uint32_t *pressure_raw, float *pressure_pa);
 
+/**
+ * @brief      read the temperature and pressure in fixed point
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *temperature_raw pointer to a raw temperature buffer
+ * @param[out] *temperature_c pointer to a fixed point temperature buffer
+ * @param[out] *pressure_raw pointer to a raw pressure buffer
+ * @param[out] *pressure_pa pointer to a fixed point pressure buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read temperature pressure failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       output is in 0.01C and 0.01Pa without float conversion
+ */
+uint8_t bmp384_read_temperature_pressure_int(bmp384_handle_t *handle, uint32_t *temperature_raw, int32_t *temperature_c, 
+                                             uint32_t *pressure_raw, uint32_t *pressure_pa);
+
 /**
  * @brief      read the temperature
  * @param[in]  *handle pointer to a bmp384 handle structure
@@ -546,6 +979,20 @@ uint8_t bmp384_read_temperature_pressure(bmp384_handle_t *handle, uint32_t *temp
  */
 uint8_t bmp384_read_temperature(bmp384_handle_t *handle, uint32_t *raw, float *c);
 
+/**
+ * @brief      read the temperature in fixed point
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *raw pointer to a raw temperature buffer
+ * @param[out] *c pointer to a fixed point temperature buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read temperature failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       output is in 0.01C without float conversion
+ */
+uint8_t bmp384_read_temperature_int(bmp384_handle_t *handle, uint32_t *raw, int32_t *c);
+
 /**
  * @brief      read the pressure
  * @param[in]  *handle pointer to a bmp384 handle structure
@@ -560,6 +1007,99 @@ uint8_t bmp384_read_temperature(bmp384_handle_t *handle, uint32_t *raw, float *c
  */
 uint8_t bmp384_read_pressure(bmp384_handle_t *handle, uint32_t *raw, float *pa);
 
+/**
+ * @brief      read the pressure in fixed point
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *raw pointer to a raw pressure buffer
+ * @param[out] *pa pointer to a fixed point pressure buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read pressure failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       output is in 0.01Pa without float conversion
+ */
+uint8_t bmp384_read_pressure_int(bmp384_handle_t *handle, uint32_t *raw, uint32_t *pa);
+
+/**
+ * @brief     start the normal mode stream
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @param[in] sensortime bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 stream start failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 fifo mode can't use this function
+ *            - 5 chip is not in normal mode
+ * @note      the mode and the enabled outputs are read once, writing the mode, fifo or cmd register stops the stream
+ */
+uint8_t bmp384_stream_start(bmp384_handle_t *handle, bmp384_bool_t sensortime);
+
+/**
+ * @brief      read one sample of the stream
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *data pointer to a stream data structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 stream read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 stream is not started
+ *             - 5 data is not ready
+ * @note       one burst read from 0x03 to 0x09, or to 0x0E with sensortime,
+ *             only the outputs enabled at bmp384_stream_start are waited for and set, the others are set to 0,
+ *             a pressure without temperature is compensated with the t_fine of the last temperature
+ */
+uint8_t bmp384_stream_read(bmp384_handle_t *handle, bmp384_stream_data_t *data);
+
+/**
+ * @brief     stop the normal mode stream
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t bmp384_stream_stop(bmp384_handle_t *handle);
+
+/**
+ * @brief      trigger one forced mode conversion
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *us pointer to a conversion time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 forced trigger failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 fifo mode can't use this function
+ * @note       the conversion time is computed from the current oversampling settings,
+ *             the enabled outputs are saved for bmp384_forced_collect,
+ *             call bmp384_forced_collect after it has passed
+ */
+uint8_t bmp384_forced_trigger(bmp384_handle_t *handle, uint32_t *us);
+
+/**
+ * @brief      collect the forced mode conversion result
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *temperature_raw pointer to a raw temperature buffer
+ * @param[out] *temperature_c pointer to a converted temperature buffer
+ * @param[out] *pressure_raw pointer to a raw pressure buffer
+ * @param[out] *pressure_pa pointer to a converted pressure buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 forced collect failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 data is not ready
+ * @note       one burst read from 0x03 to 0x09 without polling,
+ *             only the outputs enabled at bmp384_forced_trigger are waited for and set, the others are left untouched,
+ *             a pressure without temperature is compensated with the t_fine of the last temperature
+ */
+uint8_t bmp384_forced_collect(bmp384_handle_t *handle, uint32_t *temperature_raw, float *temperature_c, 
+                              uint32_t *pressure_raw, float *pressure_pa);
+
 /**
  * @brief      get the error
  * @param[in]  *handle pointer to a bmp384 handle structure
@@ -599,6 +1139,55 @@ uint8_t bmp384_get_status(bmp384_handle_t *handle, uint8_t *status);
  */
 uint8_t bmp384_get_sensortime(bmp384_handle_t *handle, uint32_t *t);
 
+/**
+ * @brief     reset the clock sync
+ * @param[in] *sync pointer to a clock sync structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 sync is NULL
+ * @note      none
+ */
+uint8_t bmp384_clock_sync_reset(bmp384_clock_sync_t *sync);
+
+/**
+ * @brief     add a sensor time and host time pair to the clock sync
+ * @param[in] *sync pointer to a clock sync structure
+ * @param[in] sensortime raw sensor time
+ * @param[in] host_ns host monotonic time in ns
+ * @return    status code
+ *            - 0 success
+ *            - 1 sync is NULL
+ * @note      the 24-bit sensor time wraps every 655s, pairs must be added more often than that,
+ *            the fit follows the last BMP384_CLOCK_SYNC_WINDOW pairs with a forgetting factor
+ */
+uint8_t bmp384_clock_sync_update(bmp384_clock_sync_t *sync, uint32_t sensortime, uint64_t host_ns);
+
+/**
+ * @brief      convert a sensor time to the host time
+ * @param[in]  *sync pointer to a clock sync structure
+ * @param[in]  sensortime raw sensor time
+ * @param[out] *host_ns pointer to a host time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 sync is NULL
+ *             - 4 no pair
+ * @note       sensortime must be within 327s of the last pair,
+ *             the nominal 39.0625us tick is used until two pairs are added
+ */
+uint8_t bmp384_clock_sync_convert(const bmp384_clock_sync_t *sync, uint32_t sensortime, uint64_t *host_ns);
+
+/**
+ * @brief      get the clock drift
+ * @param[in]  *sync pointer to a clock sync structure
+ * @param[out] *ppm pointer to a drift buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 sync is NULL
+ *             - 4 not enough pairs
+ * @note       positive ppm means the sensor clock runs slower than the host clock
+ */
+uint8_t bmp384_clock_sync_get_drift(const bmp384_clock_sync_t *sync, double *ppm);
+
 /**
  * @brief      get the event
  * @param[in]  *handle pointer to a bmp384 handle structure
@@ -896,6 +1485,61 @@ uint8_t bmp384_softreset(bmp384_handle_t *handle);
  */
 uint8_t bmp384_extmode_en_middle(bmp384_handle_t *handle);
 
+/**
+ * @brief     enable or disable the register shadow
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set register shadow failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the shadow caches the registers from 0x15 to 0x1F,
+ *            setters become one write and getters cost no bus access
+ */
+uint8_t bmp384_set_register_shadow(bmp384_handle_t *handle, bmp384_bool_t enable);
+
+/**
+ * @brief      get the register shadow status
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get register shadow failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the shadow is disabled after a failed bus write
+ */
+uint8_t bmp384_get_register_shadow(bmp384_handle_t *handle, bmp384_bool_t *enable);
+
+/**
+ * @brief     apply the whole chip config
+ * @param[in] *handle pointer to a bmp384 handle structure
+ * @param[in] *config pointer to a config structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 apply config failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 config is invalid
+ * @note      registers 0x15 - 0x1F are written in one burst,
+ *            the chip enters sleep mode first and the mode is set last
+ */
+uint8_t bmp384_apply_config(bmp384_handle_t *handle, const bmp384_config_t *config);
+
+/**
+ * @brief      get the whole chip config
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[out] *config pointer to a config structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get config failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t bmp384_get_config(bmp384_handle_t *handle, bmp384_config_t *config);
+
 /**
  * @}
  */
@@ -1344,7 +1988,8 @@ uint8_t bmp384_flush_fifo(bmp384_handle_t *handle);
  *                - 1 read fifo failed
  *                - 2 handle is NULL
  *                - 3 handle is not initialized
- * @note          none
+ * @note          len returns the exact number of bytes read,
+ *                a full fifo with sensor time can be drained in one call with any buffer size
  */
 uint8_t bmp384_read_fifo(bmp384_handle_t *handle, uint8_t *buf, uint16_t *len);
 
@@ -1364,6 +2009,109 @@ uint8_t bmp384_read_fifo(bmp384_handle_t *handle, uint8_t *buf, uint16_t *len);
  */
 uint8_t bmp384_fifo_parse(bmp384_handle_t *handle, uint8_t *buf, uint16_t buf_len, bmp384_frame_t *frame, uint16_t *frame_len);
 
+/**
+ * @brief         parse the fifo data to fixed point frames
+ * @param[in]     *handle pointer to a bmp384 handle structure
+ * @param[in]     *buf pointer to fifo data
+ * @param[in]     buf_len fifo data length
+ * @param[out]    *frame pointer to a fixed point frame buffer
+ * @param[in,out] *frame_len pointer to a frame length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 fifo parse failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ * @note          data is in 0.01C or 0.01Pa without float conversion
+ */
+uint8_t bmp384_fifo_parse_int(bmp384_handle_t *handle, uint8_t *buf, uint16_t buf_len, bmp384_frame_int_t *frame, uint16_t *frame_len);
+
+/**
+ * @brief         parse the fifo data to raw frames
+ * @param[in]     *handle pointer to a bmp384 handle structure
+ * @param[in]     *buf pointer to fifo data
+ * @param[in]     buf_len fifo data length
+ * @param[out]    *frame pointer to a raw frame buffer
+ * @param[in,out] *frame_len pointer to a frame length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 fifo parse raw failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ * @note          no compensation is run, use bmp384_fifo_compensate_raw or bmp384_compensate_temperature
+ *                and bmp384_compensate_pressure later for the frames that are used
+ */
+uint8_t bmp384_fifo_parse_raw(bmp384_handle_t *handle, uint8_t *buf, uint16_t buf_len, bmp384_frame_raw_t *frame, uint16_t *frame_len);
+
+/**
+ * @brief      compensate the raw frames
+ * @param[in]  *handle pointer to a bmp384 handle structure
+ * @param[in]  *raw pointer to a raw frame buffer
+ * @param[in]  len raw frame length
+ * @param[out] *frame pointer to a frame buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 compensate raw failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       frame[i] is made from raw[i], a pressure frame uses the t_fine of the last temperature frame
+ */
+uint8_t bmp384_fifo_compensate_raw(bmp384_handle_t *handle, const bmp384_frame_raw_t *raw, uint16_t len, bmp384_frame_t *frame);
+
+/**
+ * @brief         parse the fifo data to paired samples
+ * @param[in]     *handle pointer to a bmp384 handle structure
+ * @param[in]     *buf pointer to fifo data
+ * @param[in]     buf_len fifo data length
+ * @param[out]    *sample pointer to a sample buffer
+ * @param[in,out] *sample_len pointer to a sample length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 fifo parse sample failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ * @note          one sample is made from each temperature and pressure frame,
+ *                temperature only frames update the compensation and sensor time frames are skipped,
+ *                the sample index is cleared by bmp384_flush_fifo,
+ *                a sensor time frame back fills the sensortime of the samples before it from the odr and
+ *                fifo subsampling, taking the sensor time as the time of the last data frame,
+ *                they come from the register shadow when it is enabled, otherwise they are read once
+ *                and cached until the driver writes them again,
+ *                a back filled sensortime has BMP384_SAMPLE_SENSORTIME_VALID set and is 0 otherwise,
+ *                samples beyond sample_len are dropped but still advance the sample index,
+ *                the temperature saturates to the int16_t range
+ */
+uint8_t bmp384_fifo_parse_sample(bmp384_handle_t *handle, uint8_t *buf, uint16_t buf_len, bmp384_sample_t *sample, uint16_t *sample_len);
+
+/**
+ * @brief     reset the fifo stream
+ * @param[in] *stream pointer to a fifo stream structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 stream is NULL
+ * @note      call it before the first chunk and after a fifo flush
+ */
+uint8_t bmp384_fifo_stream_reset(bmp384_fifo_stream_t *stream);
+
+/**
+ * @brief         parse one chunk of a fifo stream
+ * @param[in]     *handle pointer to a bmp384 handle structure
+ * @param[in]     *stream pointer to a fifo stream structure
+ * @param[in]     *buf pointer to fifo data
+ * @param[in]     buf_len fifo data length
+ * @param[out]    *frame pointer to a frame buffer
+ * @param[in,out] *frame_len pointer to a frame length buffer
+ * @return        status code
+ *                - 0 success
+ *                - 1 fifo stream parse failed
+ *                - 2 handle is NULL
+ *                - 3 handle is not initialized
+ *                - 4 frame_len is too small
+ * @note          a frame split at the end of buf is kept in the stream and finished by the next chunk,
+ *                frame_len >= buf_len / 3 + 3
+ */
+uint8_t bmp384_fifo_stream_parse(bmp384_handle_t *handle, bmp384_fifo_stream_t *stream, uint8_t *buf, uint16_t buf_len,
+                                 bmp384_frame_t *frame, uint16_t *frame_len);
+
 /**
  * @}
  */
@@ -0,0 +1,310 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_bmp384_compensation_test.c
+ * @brief     driver bmp384 compensation test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_bmp384_compensation_test.h"
+
+static bmp384_handle_t gs_handle;               /**< bmp384 handle */
+static uint8_t gs_buf[64 * 7];                  /**< fifo buffer */
+static bmp384_frame_int_t gs_frame[64 * 2];     /**< frame buffer */
+static bmp384_calibration_t gs_calibration;     /**< calibration data */
+static uint32_t gs_temperature_raw_batch[64];   /**< batch raw temperature buffer */
+static uint32_t gs_pressure_raw_batch[64];      /**< batch raw pressure buffer */
+static int32_t gs_temperature_c_batch[64];      /**< batch temperature buffer */
+static uint32_t gs_pressure_pa_batch[64];       /**< batch pressure buffer */
+
+/**
+ * @brief temperature raw test points
+ */
+static const uint32_t gs_temperature_raw[] =
+{
+    0x700000, 0x780000, 0x800000, 0x848000, 0x880000, 0x900000,
+};
+
+/**
+ * @brief      reference temperature compensation
+ * @param[in]  *calibration pointer to a bmp384 calibration structure
+ * @param[in]  data raw temperature
+ * @param[out] *t_fine pointer to a t_fine buffer
+ * @return     compensated temperature
+ * @note       division based datasheet formula
+ */
+static int64_t a_reference_compensate_temperature(const bmp384_calibration_t *calibration, uint32_t data, int64_t *t_fine)
+{
+    uint64_t partial_data1;
+    uint64_t partial_data2;
+    uint64_t partial_data3;
+    int64_t partial_data4;
+    int64_t partial_data5;
+    int64_t partial_data6;
+    
+    partial_data1 = (uint64_t)(data - (256 * (uint64_t)(calibration->t1)));
+    partial_data2 = (uint64_t)(calibration->t2 * partial_data1);
+    partial_data3 = (uint64_t)(partial_data1 * partial_data1);
+    partial_data4 = (int64_t)(((int64_t)partial_data3) * ((int64_t)calibration->t3));
+    partial_data5 = ((int64_t)(((int64_t)partial_data2) * 262144) + (int64_t)partial_data4);
+    partial_data6 = (int64_t)(((int64_t)partial_data5) / 4294967296U);
+    *t_fine = partial_data6;
+    
+    return (int64_t)((partial_data6 * 25)  / 16384);
+}
+
+/**
+ * @brief     reference pressure compensation
+ * @param[in] *calibration pointer to a bmp384 calibration structure
+ * @param[in] data raw pressure
+ * @param[in] t_fine t_fine
+ * @return    compensated pressure
+ * @note      division based datasheet formula
+ */
+static int64_t a_reference_compensate_pressure(const bmp384_calibration_t *calibration, uint32_t data, int64_t t_fine)
+{
+    int64_t partial_data1;
+    int64_t partial_data2;
+    int64_t partial_data3;
+    int64_t partial_data4;
+    int64_t partial_data5;
+    int64_t partial_data6;
+    int64_t offset;
+    int64_t sensitivity;
+    
+    partial_data1 = t_fine * t_fine;
+    partial_data2 = partial_data1 / 64;
+    partial_data3 = (partial_data2 * t_fine) / 256;
+    partial_data4 = (calibration->p8 * partial_data3) / 32;
+    partial_data5 = (calibration->p7 * partial_data1) * 16;
+    partial_data6 = (calibration->p6 * t_fine) * 4194304;
+    offset = (int64_t)((int64_t)(calibration->p5) * (int64_t)140737488355328U) + partial_data4 + partial_data5 + partial_data6;
+    partial_data2 = (((int64_t)calibration->p4) * partial_data3) / 32;
+    partial_data4 = (calibration->p3 * partial_data1) * 4;
+    partial_data5 = ((int64_t)(calibration->p2) - 16384) * ((int64_t)t_fine) * 2097152;
+    sensitivity = (((int64_t)(calibration->p1) - 16384) * (int64_t)70368744177664U) + partial_data2 + partial_data4 + partial_data5;
+    partial_data1 = (sensitivity / 16777216) * data;
+    partial_data2 = (int64_t)(calibration->p10) * (int64_t)(t_fine);
+    partial_data3 = partial_data2 + (65536 * (int64_t)(calibration->p9));
+    partial_data4 = (partial_data3 * data) / 8192;
+    partial_data5 = (partial_data4 * data) / 512;
+    partial_data6 = (int64_t)((uint64_t)data * (uint64_t)data);
+    partial_data2 = ((int64_t)(calibration->p11) * (int64_t)(partial_data6)) / 65536;
+    partial_data3 = (partial_data2 * data) / 128;
+    partial_data4 = (offset / 4) + partial_data1 + partial_data5 + partial_data3;
+    
+    return (int64_t)(((uint64_t)partial_data4 * 25) / (uint64_t)1099511627776U);
+}
+
+/**
+ * @brief     compensation test
+ * @param[in] interface chip interface
+ * @param[in] addr_pin iic device address
+ * @return    status code
+ *            - 0 success
+ *            - 1 test failed
+ * @note      none
+ */
+uint8_t bmp384_compensation_test(bmp384_interface_t interface, bmp384_address_t addr_pin)
+{
+    uint8_t res;
+    uint32_t i;
+    uint32_t j;
+    uint32_t k;
+    bmp384_info_t info;
+    
+    /* link functions */
+    DRIVER_BMP384_LINK_INIT(&gs_handle, bmp384_handle_t);
+    DRIVER_BMP384_LINK_IIC_INIT(&gs_handle, bmp384_interface_iic_init);
+    DRIVER_BMP384_LINK_IIC_DEINIT(&gs_handle, bmp384_interface_iic_deinit);
+    DRIVER_BMP384_LINK_IIC_READ(&gs_handle, bmp384_interface_iic_read);
+    DRIVER_BMP384_LINK_IIC_WRITE(&gs_handle, bmp384_interface_iic_write);
+    DRIVER_BMP384_LINK_SPI_INIT(&gs_handle, bmp384_interface_spi_init);
+    DRIVER_BMP384_LINK_SPI_DEINIT(&gs_handle, bmp384_interface_spi_deinit);
+    DRIVER_BMP384_LINK_SPI_READ(&gs_handle, bmp384_interface_spi_read);
+    DRIVER_BMP384_LINK_SPI_WRITE(&gs_handle, bmp384_interface_spi_write);
+    DRIVER_BMP384_LINK_DELAY_MS(&gs_handle, bmp384_interface_delay_ms);
+    DRIVER_BMP384_LINK_DEBUG_PRINT(&gs_handle, bmp384_interface_debug_print);
+    DRIVER_BMP384_LINK_RECEIVE_CALLBACK(&gs_handle, bmp384_interface_receive_callback);
+    
+    /* bmp384 info */
+    res = bmp384_info(&info);
+    if (res != 0)
+    {
+        bmp384_interface_debug_print("bmp384: get info failed.\n");
+       
+        return 1;
+    }
+    else
+    {
+        /* print chip information */
+        bmp384_interface_debug_print("bmp384: chip is %s.\n", info.chip_name);
+        bmp384_interface_debug_print("bmp384: manufacturer is %s.\n", info.manufacturer_name);
+        bmp384_interface_debug_print("bmp384: interface is %s.\n", info.interface);
+        bmp384_interface_debug_print("bmp384: driver version is %d.%d.\n", info.driver_version / 1000, (info.driver_version % 1000) / 100);
+        bmp384_interface_debug_print("bmp384: min supply voltage is %0.1fV.\n", info.supply_voltage_min_v);
+        bmp384_interface_debug_print("bmp384: max supply voltage is %0.1fV.\n", info.supply_voltage_max_v);
+        bmp384_interface_debug_print("bmp384: max current is %0.2fmA.\n", info.max_current_ma);
+        bmp384_interface_debug_print("bmp384: max temperature is %0.1fC.\n", info.temperature_max);
+        bmp384_interface_debug_print("bmp384: min temperature is %0.1fC.\n", info.temperature_min);
+    }
+    
+    /* start compensation test */
+    bmp384_interface_debug_print("bmp384: start compensation test.\n");
+    res = bmp384_set_interface(&gs_handle, interface);
+    if (res != 0)
+    {
+        bmp384_interface_debug_print("bmp384: set interface failed.\n");
+       
+        return 1;
+    }
+    
+    /* set addr pin */
+    res = bmp384_set_addr_pin(&gs_handle, addr_pin);
+    if (res != 0)
+    {
+        bmp384_interface_debug_print("bmp384: set addr pin failed.\n");
+       
+        return 1;
+    }
+    
+    /* bmp384 init */
+    res = bmp384_init(&gs_handle);
+    if (res != 0)
+    {
+        bmp384_interface_debug_print("bmp384: init failed.\n");
+       
+        return 1;
+    }
+    bmp384_interface_debug_print("bmp384: pressure kernel is %s.\n", 
+                                 BMP384_COMPENSATE_PRESSURE_SHIFT == 1 ? "shift" : "division");
+    
+    /* get calibration */
+    res = bmp384_get_calibration(&gs_handle, &gs_calibration);
+    if (res != 0)
+    {
+        bmp384_interface_debug_print("bmp384: get calibration failed.\n");
+        (void)bmp384_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* spot check the raw pressure range, the exhaustive check is test/host/driver_bmp384_compensation_host_test.c */
+    for (i = 0; i < sizeof(gs_temperature_raw) / sizeof(gs_temperature_raw[0]); i++)
+    {
+        int64_t t_fine;
+        int64_t t_fine_check;
+        int64_t temperature;
+        int32_t temperature_check;
+        
+        temperature = a_reference_compensate_temperature(&gs_calibration, gs_temperature_raw[i], &t_fine);
+        res = bmp384_compensate_temperature(&gs_calibration, gs_temperature_raw[i], &temperature_check, &t_fine_check);
+        if ((res != 0) || (temperature_check != (int32_t)temperature) || (t_fine_check != t_fine))
+        {
+            bmp384_interface_debug_print("bmp384: temperature raw 0x%06X compensate temperature check error.\n", 
+                                         gs_temperature_raw[i]);
+            (void)bmp384_deinit(&gs_handle);
+            
+            return 1;
+        }
+        for (j = 0; j < 0x1000000; j += 0x10000)
+        {
+            uint16_t frame_len;
+            
+            /* make the fifo frames, the raw temperature changes every 4 frames */
+            for (k = 0; k < 64; k++)
+            {
+                gs_buf[k * 7 + 0] = 0x94;
+                gs_temperature_raw_batch[k] = gs_temperature_raw[(i + k / 4) % 
+                                                                 (sizeof(gs_temperature_raw) / sizeof(gs_temperature_raw[0]))];
+                gs_buf[k * 7 + 1] = (gs_temperature_raw_batch[k] >> 0) & 0xFF;
+                gs_buf[k * 7 + 2] = (gs_temperature_raw_batch[k] >> 8) & 0xFF;
+                gs_buf[k * 7 + 3] = (gs_temperature_raw_batch[k] >> 16) & 0xFF;
+                gs_buf[k * 7 + 4] = ((j + (k << 10)) >> 0) & 0xFF;
+                gs_buf[k * 7 + 5] = ((j + (k << 10)) >> 8) & 0xFF;
+                gs_buf[k * 7 + 6] = ((j + (k << 10)) >> 16) & 0xFF;
+                gs_pressure_raw_batch[k] = j + (k << 10);
+            }
+            
+            /* parse the frames */
+            frame_len = 64 * 2;
+            res = bmp384_fifo_parse_int(&gs_handle, gs_buf, 64 * 7, gs_frame, &frame_len);
+            if ((res != 0) || (frame_len != 64 * 2))
+            {
+                bmp384_interface_debug_print("bmp384: fifo parse int failed.\n");
+                (void)bmp384_deinit(&gs_handle);
+                
+                return 1;
+            }
+            
+            /* compensate the batch */
+            res = bmp384_compensate_batch(&gs_calibration, gs_temperature_raw_batch, gs_pressure_raw_batch, 64, 
+                                          gs_temperature_c_batch, gs_pressure_pa_batch);
+            if (res != 0)
+            {
+                bmp384_interface_debug_print("bmp384: compensate batch failed.\n");
+                (void)bmp384_deinit(&gs_handle);
+                
+                return 1;
+            }
+            
+            /* check the results */
+            for (k = 0; k < 64; k++)
+            {
+                int64_t pressure;
+                uint32_t pressure_check;
+                
+                temperature = a_reference_compensate_temperature(&gs_calibration, gs_temperature_raw_batch[k], &t_fine);
+                pressure = a_reference_compensate_pressure(&gs_calibration, gs_pressure_raw_batch[k], t_fine);
+                res = bmp384_compensate_pressure(&gs_calibration, gs_pressure_raw_batch[k], t_fine, &pressure_check);
+                if ((res != 0) || (pressure_check != (uint32_t)pressure) ||
+                    (gs_temperature_c_batch[k] != (int32_t)temperature) ||
+                    (gs_pressure_pa_batch[k] != (uint32_t)pressure) ||
+                    (gs_frame[k * 2 + 0].data != (int32_t)temperature) || 
+                    (gs_frame[k * 2 + 1].data != (int32_t)pressure))
+                {
+                    bmp384_interface_debug_print("bmp384: temperature raw 0x%06X pressure raw 0x%06X check error.\n", 
+                                                 gs_temperature_raw_batch[k], gs_pressure_raw_batch[k]);
+                    (void)bmp384_deinit(&gs_handle);
+                    
+                    return 1;
+                }
+            }
+        }
+        bmp384_interface_debug_print("bmp384: temperature raw 0x%06X check ok.\n", gs_temperature_raw[i]);
+    }
+    
+    /* finish compensation test */
+    bmp384_interface_debug_print("bmp384: finish compensation test.\n");
+    (void)bmp384_deinit(&gs_handle);
+    
+    return 0;
+}
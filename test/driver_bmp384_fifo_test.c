@@ -39,8 +39,17 @@
 static bmp384_handle_t gs_handle;                      /**< bmp384 handle */
 static volatile uint8_t gs_fifo_full_flag;             /**< fifo full flag */
 static volatile uint8_t gs_fifo_watermark_flag;        /**< fifo watermark flag */
-static uint8_t gs_buf[512];                            /**< local buffer */
+static uint8_t gs_buf[516];                            /**< local buffer with the sensor time frame */
 static bmp384_frame_t gs_frame[256];                   /**< local frame */
+static bmp384_frame_t gs_stream_frame[256];            /**< local stream frame */
+static bmp384_fifo_stream_t gs_stream;                 /**< local fifo stream */
+static bmp384_sample_t gs_sample[128];                 /**< local sample */
+static bmp384_frame_raw_t gs_frame_raw[256];           /**< local raw frame */
+static bmp384_frame_int_t gs_frame_int[256];           /**< local fixed point frame */
+static bmp384_sample_t gs_irq_sample[128];             /**< local irq sample */
+static volatile uint8_t gs_irq_read_flag;              /**< irq read flag */
+static volatile uint8_t gs_irq_read_enable;            /**< irq read enable */
+static uint32_t gs_sensortime_step;                    /**< sensor time step of one fifo sample */
 
 /**
  * @brief  fifo test irq handler
@@ -51,6 +60,21 @@ static bmp384_frame_t gs_frame[256];                   /**< local frame */
  */
 uint8_t bmp384_fifo_test_irq_handler(void)
 {
+    /* run irq handler with the payload */
+    if (gs_irq_read_enable != 0)
+    {
+        /* fill the buffer with fifo empty frames */
+        memset(gs_buf, 0x80, sizeof(gs_buf));
+        if (bmp384_irq_handler_read(&gs_handle, (uint8_t *)gs_buf, 516, (bmp384_sample_t *)gs_irq_sample, 128) != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    
     /* run irq handler */
     if (bmp384_irq_handler(&gs_handle) != 0)
     {
@@ -62,6 +86,300 @@ uint8_t bmp384_fifo_test_irq_handler(void)
     }
 }
 
+/**
+ * @brief     check the fifo stream parser against the one shot parser
+ * @param[in] len fifo data length
+ * @param[in] frame_len one shot frame length
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      gs_buf is split into 13 bytes chunks so that frames cross the chunk boundaries
+ */
+static uint8_t a_bmp384_fifo_stream_check(uint16_t len, uint16_t frame_len)
+{
+    uint16_t i;
+    uint16_t j;
+    uint16_t chunk;
+    uint16_t stream_len;
+    uint16_t stream_total;
+    
+    if (bmp384_fifo_stream_reset(&gs_stream) != 0)
+    {
+        return 1;
+    }
+    stream_total = 0;
+    for (i = 0; i < len; i += chunk)
+    {
+        chunk = (len - i) < 13 ? (len - i) : 13;
+        stream_len = 256 - stream_total;
+        if (bmp384_fifo_stream_parse(&gs_handle, &gs_stream, (uint8_t *)&gs_buf[i], chunk, 
+                                     (bmp384_frame_t *)&gs_stream_frame[stream_total], (uint16_t *)&stream_len) != 0)
+        {
+            return 1;
+        }
+        stream_total += stream_len;
+    }
+    if (stream_total != frame_len)
+    {
+        return 1;
+    }
+    for (j = 0; j < frame_len; j++)
+    {
+        if ((gs_stream_frame[j].type != gs_frame[j].type) || (gs_stream_frame[j].raw != gs_frame[j].raw))
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     check the fifo samples against the fifo frames
+ * @param[in] len fifo data length
+ * @param[in] frame_len fifo frame length
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      each pressure frame must follow its temperature frame,
+ *            back filled sensor times must be gs_sensortime_step apart modulo 2^24
+ */
+static uint8_t a_bmp384_fifo_sample_check(uint16_t len, uint16_t frame_len)
+{
+    uint16_t j;
+    uint16_t int_len;
+    uint16_t sample_len;
+    uint16_t sample_total;
+    
+    int_len = 256;
+    if (bmp384_fifo_parse_int(&gs_handle, (uint8_t *)gs_buf, len, (bmp384_frame_int_t *)gs_frame_int, (uint16_t *)&int_len) != 0)
+    {
+        return 1;
+    }
+    if (int_len != frame_len)
+    {
+        return 1;
+    }
+    sample_len = 128;
+    if (bmp384_fifo_parse_sample(&gs_handle, (uint8_t *)gs_buf, len, (bmp384_sample_t *)gs_sample, (uint16_t *)&sample_len) != 0)
+    {
+        return 1;
+    }
+    sample_total = 0;
+    for (j = 1; j < frame_len; j++)
+    {
+        if (gs_frame[j].type == BMP384_FRAME_TYPE_PRESSURE)
+        {
+            if ((sample_total >= sample_len) || 
+                (BMP384_SAMPLE_RAW(gs_sample[sample_total].temperature_raw) != gs_frame_int[j - 1].raw) ||
+                (BMP384_SAMPLE_RAW(gs_sample[sample_total].pressure_raw) != gs_frame_int[j].raw) ||
+                (gs_sample[sample_total].temperature != gs_frame_int[j - 1].data) ||
+                (gs_sample[sample_total].pressure != (uint32_t)gs_frame_int[j].data))
+            {
+                return 1;
+            }
+            if ((sample_total != 0) && (gs_sample[sample_total].index != gs_sample[sample_total - 1].index + 1))
+            {
+                return 1;
+            }
+            
+            /* check the sensor time step of the back filled samples */
+            if ((sample_total != 0) && 
+                ((gs_sample[sample_total].sensortime & BMP384_SAMPLE_SENSORTIME_VALID) != 0) &&
+                ((gs_sample[sample_total - 1].sensortime & BMP384_SAMPLE_SENSORTIME_VALID) != 0) &&
+                (((gs_sample[sample_total].sensortime - gs_sample[sample_total - 1].sensortime) & 0xFFFFFF) != gs_sensortime_step))
+            {
+                return 1;
+            }
+            sample_total++;
+        }
+        else if ((gs_frame[j].type == BMP384_FRAME_TYPE_SENSORTIME) && (gs_frame[j - 1].type == BMP384_FRAME_TYPE_PRESSURE))
+        {
+            /* the last sample takes the sensor time of the frame */
+            if ((sample_total == 0) || 
+                (gs_sample[sample_total - 1].sensortime != (gs_frame[j].raw | BMP384_SAMPLE_SENSORTIME_VALID)))
+            {
+                return 1;
+            }
+        }
+        else
+        {
+            
+        }
+    }
+    if (sample_total != sample_len)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  check the back filled sensor time across the 24 bits wrap
+ * @return status code
+ *         - 0 success
+ *         - 1 check failed
+ * @note   gs_buf is filled with 16 fifo samples and a sensor time frame of 0x000800
+ */
+static uint8_t a_bmp384_fifo_sensortime_wrap_check(void)
+{
+    uint16_t j;
+    uint16_t len;
+    uint16_t frame_len;
+    
+    /* make the fifo frames */
+    for (j = 0; j < 16; j++)
+    {
+        gs_buf[j * 7 + 0] = 0x94;
+        gs_buf[j * 7 + 1] = 0x00;
+        gs_buf[j * 7 + 2] = 0x00;
+        gs_buf[j * 7 + 3] = 0x80;
+        gs_buf[j * 7 + 4] = 0x00;
+        gs_buf[j * 7 + 5] = 0x00;
+        gs_buf[j * 7 + 6] = 0x60;
+    }
+    gs_buf[16 * 7 + 0] = 0xA0;
+    gs_buf[16 * 7 + 1] = 0x00;
+    gs_buf[16 * 7 + 2] = 0x08;
+    gs_buf[16 * 7 + 3] = 0x00;
+    len = 16 * 7 + 4;
+    
+    /* parse the frames */
+    frame_len = 256;
+    if (bmp384_fifo_parse(&gs_handle, (uint8_t *)gs_buf, len, (bmp384_frame_t *)gs_frame, (uint16_t *)&frame_len) != 0)
+    {
+        return 1;
+    }
+    if (a_bmp384_fifo_sample_check(len, frame_len) != 0)
+    {
+        return 1;
+    }
+    
+    /* the first sample is before the wrap */
+    if (gs_sample[0].sensortime != (((0x000800 - 15 * gs_sensortime_step) & 0xFFFFFF) | BMP384_SAMPLE_SENSORTIME_VALID))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     check the deferred compensation of the raw frames against the fifo frames
+ * @param[in] len fifo data length
+ * @param[in] frame_len fifo frame length
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      gs_stream_frame is reused as the output buffer
+ */
+static uint8_t a_bmp384_fifo_raw_check(uint16_t len, uint16_t frame_len)
+{
+    uint16_t j;
+    uint16_t raw_len;
+    
+    raw_len = 256;
+    if (bmp384_fifo_parse_raw(&gs_handle, (uint8_t *)gs_buf, len, (bmp384_frame_raw_t *)gs_frame_raw, (uint16_t *)&raw_len) != 0)
+    {
+        return 1;
+    }
+    if (raw_len != frame_len)
+    {
+        return 1;
+    }
+    if (bmp384_fifo_compensate_raw(&gs_handle, (const bmp384_frame_raw_t *)gs_frame_raw, raw_len, (bmp384_frame_t *)gs_stream_frame) != 0)
+    {
+        return 1;
+    }
+    for (j = 0; j < frame_len; j++)
+    {
+        if ((gs_stream_frame[j].type != gs_frame[j].type) || (gs_stream_frame[j].raw != gs_frame[j].raw) ||
+            (gs_stream_frame[j].data != gs_frame[j].data))
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     check the irq payload samples against the fifo samples
+ * @param[in] *sample pointer to a sample buffer
+ * @param[in] len sample length
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      gs_buf holds the fifo data read by bmp384_irq_handler_read padded with fifo empty frames
+ */
+static uint8_t a_bmp384_fifo_irq_sample_check(bmp384_sample_t *sample, uint16_t len)
+{
+    uint16_t j;
+    uint16_t sample_len;
+    
+    sample_len = 128;
+    if (bmp384_fifo_parse_sample(&gs_handle, (uint8_t *)gs_buf, 516, (bmp384_sample_t *)gs_sample, (uint16_t *)&sample_len) != 0)
+    {
+        return 1;
+    }
+    if ((len == 0) || (sample_len != len))
+    {
+        return 1;
+    }
+    for (j = 0; j < len; j++)
+    {
+        if ((gs_sample[j].index != sample[j].index + len) ||
+            (memcmp(gs_sample[j].temperature_raw, sample[j].temperature_raw, 3) != 0) ||
+            (memcmp(gs_sample[j].pressure_raw, sample[j].pressure_raw, 3) != 0) ||
+            (gs_sample[j].temperature != sample[j].temperature) ||
+            (gs_sample[j].pressure != sample[j].pressure) ||
+            (gs_sample[j].sensortime != sample[j].sensortime))
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     interface test receive data callback
+ * @param[in] type interrupt type
+ * @param[in] *sample pointer to a sample buffer
+ * @param[in] len sample length
+ * @note      none
+ */
+static void a_bmp384_interface_test_receive_data_callback(uint8_t type, bmp384_sample_t *sample, uint16_t len)
+{
+    switch (type)
+    {
+        case BMP384_INTERRUPT_STATUS_FIFO_WATERMARK :
+        case BMP384_INTERRUPT_STATUS_FIFO_FULL :
+        {
+            if (gs_irq_read_flag == 0)
+            {
+                /* parse the same fifo data again */
+                if (a_bmp384_fifo_irq_sample_check(sample, len) != 0)
+                {
+                    bmp384_interface_debug_print("bmp384: irq handler read sample check failed.\n");
+                    gs_irq_read_flag = 2;
+                    
+                    return;
+                }
+                bmp384_interface_debug_print("bmp384: irq handler read %d samples.\n", len);
+                gs_irq_read_flag = 1;
+            }
+            
+            break;
+        }
+        default :
+        {
+            break;
+        }
+    }
+}
+
 /**
  * @brief     interface test receive callback
  * @param[in] type interrupt type
@@ -77,7 +395,7 @@ static void a_bmp384_interface_test_receive_callback(uint8_t type)
             {
                 uint16_t len;
                 
-                len = 512;
+                len = 516;
                 /* read fifo */
                 if (bmp384_read_fifo(&gs_handle, (uint8_t *)gs_buf, (uint16_t *)&len) != 0)
                 {
@@ -96,7 +414,7 @@ static void a_bmp384_interface_test_receive_callback(uint8_t type)
             uint16_t len;
             uint16_t frame_len;
             
-            len = 512;
+            len = 516;
             /* read fifo */
             if (bmp384_read_fifo(&gs_handle, (uint8_t *)gs_buf, (uint16_t *)&len) != 0)
             {
@@ -120,6 +438,42 @@ static void a_bmp384_interface_test_receive_callback(uint8_t type)
                 {
                     bmp384_interface_debug_print("bmp384: fifo parse success and total frame is %d.\n", frame_len);
                 }
+                
+                /* parse fifo again in 13 bytes chunks */
+                if (a_bmp384_fifo_stream_check(len, frame_len) != 0)
+                {
+                    bmp384_interface_debug_print("bmp384: fifo stream parse check failed.\n");
+               
+                    return;
+                }
+                else
+                {
+                    bmp384_interface_debug_print("bmp384: fifo stream parse check ok.\n");
+                }
+                
+                /* parse fifo to samples */
+                if (a_bmp384_fifo_sample_check(len, frame_len) != 0)
+                {
+                    bmp384_interface_debug_print("bmp384: fifo parse sample check failed.\n");
+               
+                    return;
+                }
+                else
+                {
+                    bmp384_interface_debug_print("bmp384: fifo parse sample check ok.\n");
+                }
+                
+                /* parse fifo to raw frames */
+                if (a_bmp384_fifo_raw_check(len, frame_len) != 0)
+                {
+                    bmp384_interface_debug_print("bmp384: fifo parse raw check failed.\n");
+               
+                    return;
+                }
+                else
+                {
+                    bmp384_interface_debug_print("bmp384: fifo parse raw check ok.\n");
+                }
             }
             gs_fifo_full_flag = 1;
             
@@ -165,6 +519,7 @@ uint8_t bmp384_fifo_test(bmp384_interface_t interface, bmp384_address_t addr_pin
     DRIVER_BMP384_LINK_DELAY_MS(&gs_handle, bmp384_interface_delay_ms);
     DRIVER_BMP384_LINK_DEBUG_PRINT(&gs_handle, bmp384_interface_debug_print);
     DRIVER_BMP384_LINK_RECEIVE_CALLBACK(&gs_handle, a_bmp384_interface_test_receive_callback);
+    DRIVER_BMP384_LINK_RECEIVE_DATA_CALLBACK(&gs_handle, a_bmp384_interface_test_receive_data_callback);
     
     /* bmp384 info */
     res = bmp384_info(&info);
@@ -430,6 +785,19 @@ uint8_t bmp384_fifo_test(bmp384_interface_t interface, bmp384_address_t addr_pin
         return 1;
     }
     
+    /* odr 12.5Hz and fifo subsampling 0 */
+    gs_sensortime_step = (uint32_t)128 << ((uint32_t)BMP384_ODR_12P5_HZ + 0);
+    
+    /* fifo sensor time wrap test */
+    if (a_bmp384_fifo_sensortime_wrap_check() != 0)
+    {
+        bmp384_interface_debug_print("bmp384: fifo sensor time wrap check failed.\n");
+        (void)bmp384_deinit(&gs_handle); 
+        
+        return 1;
+    }
+    bmp384_interface_debug_print("bmp384: fifo sensor time wrap check ok.\n");
+    
     /* set filter coefficient 15 */
     res = bmp384_set_filter_coefficient(&gs_handle, BMP384_FILTER_COEFFICIENT_15);
     if (res != 0)
@@ -496,6 +864,38 @@ uint8_t bmp384_fifo_test(bmp384_interface_t interface, bmp384_address_t addr_pin
         }
     }
     
+    /* irq handler read test */
+    bmp384_interface_debug_print("bmp384: irq handler read test.\n");
+    
+    for (i = 0; i < times; i++)
+    {
+        uint32_t num;
+        
+        gs_irq_read_flag = 0;
+        gs_irq_read_enable = 1;
+        num = 0;
+        while (gs_irq_read_flag == 0)
+        {
+            num++;
+            if (num > 5000)
+            {
+                bmp384_interface_debug_print("bmp384: fifo interrupt failed.\n");
+                gs_irq_read_enable = 0;
+                (void)bmp384_deinit(&gs_handle); 
+                
+                return 1;
+            }
+            bmp384_interface_delay_ms(10);
+        }
+        gs_irq_read_enable = 0;
+        if (gs_irq_read_flag != 1)
+        {
+            (void)bmp384_deinit(&gs_handle); 
+            
+            return 1;
+        }
+    }
+    
     /* set sleep mode */
     res = bmp384_set_mode(&gs_handle, BMP384_MODE_SLEEP_MODE);
     if (res != 0)
@@ -382,6 +382,41 @@ uint8_t bmp384_read_test(bmp384_interface_t interface, bmp384_address_t addr_pin
         bmp384_interface_delay_ms(1000);
     }
     
+    /* forced trigger read test */
+    bmp384_interface_debug_print("bmp384: forced trigger read test.\n");
+    for (i = 0; i < times; i++)
+    {
+        uint32_t us;
+        uint32_t temperature_raw;
+        uint32_t pressure_raw;
+        float temperature_c;
+        float pressure_pa;
+        
+        /* trigger */
+        if (bmp384_forced_trigger(&gs_handle, (uint32_t *)&us) != 0)
+        {
+            bmp384_interface_debug_print("bmp384: forced trigger failed.\n");
+            (void)bmp384_deinit(&gs_handle);
+            
+            return 1;
+        }
+        bmp384_interface_debug_print("bmp384: conversion time is %dus.\n", us);
+        bmp384_interface_delay_ms(us / 1000 + 1);
+        
+        /* collect */
+        if (bmp384_forced_collect(&gs_handle, (uint32_t *)&temperature_raw, (float *)&temperature_c,
+                                  (uint32_t *)&pressure_raw, (float *)&pressure_pa) != 0)
+        {
+            bmp384_interface_debug_print("bmp384: forced collect failed.\n");
+            (void)bmp384_deinit(&gs_handle);
+            
+            return 1;
+        }
+        bmp384_interface_debug_print("bmp384: temperature is %0.2fC.\n", temperature_c);
+        bmp384_interface_debug_print("bmp384: pressure is %0.2fPa.\n", pressure_pa);
+        bmp384_interface_delay_ms(1000);
+    }
+    
     /* start normal mode read */
     bmp384_interface_debug_print("bmp384: normal mode read test.\n");
     res = bmp384_set_mode(&gs_handle, BMP384_MODE_SLEEP_MODE);
@@ -425,6 +460,79 @@ uint8_t bmp384_read_test(bmp384_interface_t interface, bmp384_address_t addr_pin
         bmp384_interface_delay_ms(1000);
     }
     
+    /* stream read test */
+    bmp384_interface_debug_print("bmp384: stream read test.\n");
+    res = bmp384_stream_start(&gs_handle, BMP384_BOOL_TRUE);
+    if (res != 0)
+    {
+        bmp384_interface_debug_print("bmp384: stream start failed.\n");
+        (void)bmp384_deinit(&gs_handle);
+        
+        return 1;
+    }
+    for (i = 0; i < times; i++)
+    {
+        bmp384_stream_data_t data;
+        
+        /* read stream */
+        bmp384_interface_delay_ms(1000);
+        if (bmp384_stream_read(&gs_handle, &data) != 0)
+        {
+            bmp384_interface_debug_print("bmp384: stream read failed.\n");
+            (void)bmp384_deinit(&gs_handle);
+            
+            return 1;
+        }
+        bmp384_interface_debug_print("bmp384: temperature is %0.2fC.\n", data.temperature_c);
+        bmp384_interface_debug_print("bmp384: pressure is %0.2fPa.\n", data.pressure_pa);
+        bmp384_interface_debug_print("bmp384: sensor time is 0x%06X.\n", (uint32_t)data.sensortime);
+    }
+    (void)bmp384_stream_stop(&gs_handle);
+    
+    /* disable pressure */
+    res = bmp384_set_pressure(&gs_handle, BMP384_BOOL_FALSE);
+    if (res != 0)
+    {
+        bmp384_interface_debug_print("bmp384: set pressure failed.\n");
+        (void)bmp384_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* temperature only stream read test */
+    bmp384_interface_debug_print("bmp384: temperature only stream read test.\n");
+    res = bmp384_stream_start(&gs_handle, BMP384_BOOL_FALSE);
+    if (res != 0)
+    {
+        bmp384_interface_debug_print("bmp384: stream start failed.\n");
+        (void)bmp384_deinit(&gs_handle);
+        
+        return 1;
+    }
+    for (i = 0; i < times; i++)
+    {
+        bmp384_stream_data_t data;
+        
+        /* read stream */
+        bmp384_interface_delay_ms(1000);
+        if (bmp384_stream_read(&gs_handle, &data) != 0)
+        {
+            bmp384_interface_debug_print("bmp384: stream read failed.\n");
+            (void)bmp384_deinit(&gs_handle);
+            
+            return 1;
+        }
+        if (data.pressure_raw != 0)
+        {
+            bmp384_interface_debug_print("bmp384: stream pressure check failed.\n");
+            (void)bmp384_deinit(&gs_handle);
+            
+            return 1;
+        }
+        bmp384_interface_debug_print("bmp384: temperature is %0.2fC.\n", data.temperature_c);
+    }
+    (void)bmp384_stream_stop(&gs_handle);
+    
     /* finish read test */
     bmp384_interface_debug_print("bmp384: finish read test.\n");
     (void)bmp384_deinit(&gs_handle);
@@ -74,6 +74,8 @@ uint8_t bmp384_register_test(bmp384_interface_t interface, bmp384_address_t addr
     bmp384_oversampling_t oversampling;
     bmp384_odr_t odr;
     bmp384_filter_coefficient_t coef;
+    bmp384_config_t config_in;
+    bmp384_config_t config_out;
     
     /* link functions */
     DRIVER_BMP384_LINK_INIT(&gs_handle, bmp384_handle_t);
@@ -1936,6 +1938,124 @@ uint8_t bmp384_register_test(bmp384_interface_t interface, bmp384_address_t addr
     }
     bmp384_interface_debug_print("bmp384: flush fifo %s.\n", res?"error":"ok");
     
+    /* bmp384_set_register_shadow/bmp384_get_register_shadow test */
+    bmp384_interface_debug_print("bmp384: bmp384_set_register_shadow/bmp384_get_register_shadow test.\n");
+    
+    /* enable register shadow */
+    res = bmp384_set_register_shadow(&gs_handle, BMP384_BOOL_TRUE);
+    if (res != 0)
+    {
+        bmp384_interface_debug_print("bmp384: set register shadow failed.\n");
+        (void)bmp384_deinit(&gs_handle);
+        
+        return 1;
+    }
+    bmp384_interface_debug_print("bmp384: enable register shadow.\n");
+    res = bmp384_get_register_shadow(&gs_handle, (bmp384_bool_t *)&enable);
+    if (res != 0)
+    {
+        bmp384_interface_debug_print("bmp384: get register shadow failed.\n");
+        (void)bmp384_deinit(&gs_handle);
+        
+        return 1;
+    }
+    bmp384_interface_debug_print("bmp384: check register shadow %s.\n", enable==BMP384_BOOL_TRUE?"ok":"error");
+    
+    /* set odr 25Hz with the shadow */
+    res = bmp384_set_odr(&gs_handle, BMP384_ODR_25_HZ);
+    if (res != 0)
+    {
+        bmp384_interface_debug_print("bmp384: set odr failed.\n");
+        (void)bmp384_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* disable register shadow */
+    res = bmp384_set_register_shadow(&gs_handle, BMP384_BOOL_FALSE);
+    if (res != 0)
+    {
+        bmp384_interface_debug_print("bmp384: set register shadow failed.\n");
+        (void)bmp384_deinit(&gs_handle);
+        
+        return 1;
+    }
+    bmp384_interface_debug_print("bmp384: disable register shadow.\n");
+    res = bmp384_get_register_shadow(&gs_handle, (bmp384_bool_t *)&enable);
+    if (res != 0)
+    {
+        bmp384_interface_debug_print("bmp384: get register shadow failed.\n");
+        (void)bmp384_deinit(&gs_handle);
+        
+        return 1;
+    }
+    bmp384_interface_debug_print("bmp384: check register shadow %s.\n", enable==BMP384_BOOL_FALSE?"ok":"error");
+    
+    /* read back from the chip */
+    res = bmp384_get_odr(&gs_handle, (bmp384_odr_t *)&odr);
+    if (res != 0)
+    {
+        bmp384_interface_debug_print("bmp384: get odr failed.\n");
+        (void)bmp384_deinit(&gs_handle);
+        
+        return 1;
+    }
+    bmp384_interface_debug_print("bmp384: check shadow write through %s.\n", odr==BMP384_ODR_25_HZ?"ok":"error");
+    
+    /* bmp384_apply_config/bmp384_get_config test */
+    bmp384_interface_debug_print("bmp384: bmp384_apply_config/bmp384_get_config test.\n");
+    
+    /* apply config */
+    config_in.fifo_watermark = rand()%256 + 256;
+    config_in.fifo = BMP384_BOOL_FALSE;
+    config_in.fifo_stop_on_full = BMP384_BOOL_TRUE;
+    config_in.fifo_sensortime_on = BMP384_BOOL_TRUE;
+    config_in.fifo_pressure_on = BMP384_BOOL_TRUE;
+    config_in.fifo_temperature_on = BMP384_BOOL_FALSE;
+    config_in.fifo_subsampling = rand()%7;
+    config_in.fifo_data_source = BMP384_FIFO_DATA_SOURCE_FILTERED;
+    config_in.interrupt_pin_type = BMP384_INTERRUPT_PIN_TYPE_PUSH_PULL;
+    config_in.interrupt_active_level = BMP384_INTERRUPT_ACTIVE_LEVEL_HIGHER;
+    config_in.latch_interrupt_pin_and_interrupt_status = BMP384_BOOL_FALSE;
+    config_in.interrupt_fifo_watermark = BMP384_BOOL_TRUE;
+    config_in.interrupt_fifo_full = BMP384_BOOL_FALSE;
+    config_in.interrupt_data_ready = BMP384_BOOL_TRUE;
+    config_in.spi_wire = BMP384_SPI_WIRE_4;
+    config_in.iic_watchdog_timer = BMP384_BOOL_TRUE;
+    config_in.iic_watchdog_period = BMP384_IIC_WATCHDOG_PERIOD_40_MS;
+    config_in.pressure = BMP384_BOOL_TRUE;
+    config_in.temperature = BMP384_BOOL_TRUE;
+    config_in.mode = BMP384_MODE_SLEEP_MODE;
+    config_in.pressure_oversampling = BMP384_OVERSAMPLING_x8;
+    config_in.temperature_oversampling = BMP384_OVERSAMPLING_x2;
+    config_in.odr = BMP384_ODR_25_HZ;
+    config_in.filter_coefficient = BMP384_FILTER_COEFFICIENT_3;
+    res = bmp384_apply_config(&gs_handle, &config_in);
+    if (res != 0)
+    {
+        bmp384_interface_debug_print("bmp384: apply config failed.\n");
+        (void)bmp384_deinit(&gs_handle);
+        
+        return 1;
+    }
+    bmp384_interface_debug_print("bmp384: apply config.\n");
+    res = bmp384_get_config(&gs_handle, &config_out);
+    if (res != 0)
+    {
+        bmp384_interface_debug_print("bmp384: get config failed.\n");
+        (void)bmp384_deinit(&gs_handle);
+        
+        return 1;
+    }
+    bmp384_interface_debug_print("bmp384: check fifo watermark %s.\n", config_in.fifo_watermark==config_out.fifo_watermark?"ok":"error");
+    bmp384_interface_debug_print("bmp384: check fifo subsampling %s.\n", config_in.fifo_subsampling==config_out.fifo_subsampling?"ok":"error");
+    bmp384_interface_debug_print("bmp384: check interrupt data ready %s.\n", config_in.interrupt_data_ready==config_out.interrupt_data_ready?"ok":"error");
+    bmp384_interface_debug_print("bmp384: check iic watchdog period %s.\n", config_in.iic_watchdog_period==config_out.iic_watchdog_period?"ok":"error");
+    bmp384_interface_debug_print("bmp384: check pressure oversampling %s.\n", config_in.pressure_oversampling==config_out.pressure_oversampling?"ok":"error");
+    bmp384_interface_debug_print("bmp384: check temperature oversampling %s.\n", config_in.temperature_oversampling==config_out.temperature_oversampling?"ok":"error");
+    bmp384_interface_debug_print("bmp384: check odr %s.\n", config_in.odr==config_out.odr?"ok":"error");
+    bmp384_interface_debug_print("bmp384: check filter coefficient %s.\n", config_in.filter_coefficient==config_out.filter_coefficient?"ok":"error");
+    
     /* bmp384_extmode_en_middle */
     bmp384_interface_debug_print("bmp384: bmp384_extmode_en_middle.\n");
     res = bmp384_extmode_en_middle(&gs_handle);
@@ -0,0 +1,227 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_bmp384_batch_host_test.c
+ * @brief     driver bmp384 batch host test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "../../src/driver_bmp384.c"
+#include <stdio.h>
+
+/**
+ * @brief batch length definition
+ */
+#define BATCH_LENGTH 67        /**< not a multiple of the lanes to cover the tail */
+
+static uint32_t gs_temperature_raw[BATCH_LENGTH];        /**< raw temperature buffer */
+static uint32_t gs_pressure_raw[BATCH_LENGTH];           /**< raw pressure buffer */
+static int32_t gs_temperature_c[BATCH_LENGTH];           /**< temperature buffer */
+static uint32_t gs_pressure_pa[BATCH_LENGTH];            /**< pressure buffer */
+static uint32_t gs_seed = 0x12345678;                    /**< random seed */
+
+/**
+ * @brief calibration test sets
+ * @note  t1, t2, p5, p9 and p10 keep their typical values, at their extremes the operating range leaves
+ *        the 24 bits raw temperature or the int64 datasheet formula overflows for some raw pressures
+ */
+static const bmp384_calibration_t gs_calibration[] =
+{
+    {27675, 18846, -10, -7105, 2607, 26, -1, 12035, 27771, 29, -8, -2843, 3, -60},
+    {27675, 18846, 127, 32767, 32767, 127, 127, 12035, 65535, 127, 127, -2843, 3, 127},
+    {27675, 18846, -128, -32768, -32768, -128, -128, 12035, 0, -128, -128, -2843, 3, -128},
+    {27675, 18846, 127, -32768, 32767, -128, 127, 12035, 65535, -128, 127, -2843, 3, -128},
+};
+
+/**
+ * @brief  get a random number
+ * @return random number
+ * @note   xorshift32
+ */
+static uint32_t a_random(void)
+{
+    gs_seed ^= gs_seed << 13;
+    gs_seed ^= gs_seed >> 17;
+    gs_seed ^= gs_seed << 5;
+    
+    return gs_seed;
+}
+
+/**
+ * @brief     get a random raw temperature
+ * @param[in] *calibration pointer to a bmp384 calibration structure
+ * @return    raw temperature in the -40C to 85C operating range
+ * @note      none
+ */
+static uint32_t a_random_temperature(const bmp384_calibration_t *calibration)
+{
+    uint32_t raw;
+    int64_t t_fine;
+    int64_t temperature;
+    
+    do
+    {
+        raw = a_random() & 0xFFFFFF;
+        temperature = a_bmp384_calculate_temperature(calibration, raw, &t_fine);
+    } while ((temperature < (int64_t)(TEMPERATURE_MIN * 100.0f)) || (temperature >= (int64_t)(TEMPERATURE_MAX * 100.0f)));
+    
+    return raw;
+}
+
+/**
+ * @brief     check one batch against the scalar kernel
+ * @param[in] *calibration pointer to a bmp384 calibration structure
+ * @param[in] len batch length
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      none
+ */
+static uint8_t a_bmp384_batch_check(const bmp384_calibration_t *calibration, uint32_t len)
+{
+    uint32_t i;
+    int32_t temperature;
+    uint32_t pressure;
+    int64_t t_fine;
+    
+    if (bmp384_compensate_batch(calibration, gs_temperature_raw, gs_pressure_raw, len, 
+                                gs_temperature_c, gs_pressure_pa) != 0)
+    {
+        printf("bmp384: compensate batch failed.\n");
+        
+        return 1;
+    }
+    for (i = 0; i < len; i++)
+    {
+        temperature = (int32_t)a_bmp384_calculate_temperature(calibration, gs_temperature_raw[i], &t_fine);
+        pressure = (uint32_t)a_bmp384_calculate_pressure(calibration, gs_pressure_raw[i], t_fine);
+        if ((gs_temperature_c[i] != temperature) || (gs_pressure_pa[i] != pressure))
+        {
+            printf("bmp384: temperature raw 0x%08X pressure raw 0x%08X check error.\n", 
+                   (unsigned int)gs_temperature_raw[i], (unsigned int)gs_pressure_raw[i]);
+            
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     check the batch of one calibration set
+ * @param[in] *calibration pointer to a bmp384 calibration structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      none
+ */
+static uint8_t a_bmp384_calibration_check(const bmp384_calibration_t *calibration)
+{
+    uint32_t i;
+    uint32_t j;
+    uint32_t len;
+    
+    /* sweep every raw pressure, the raw temperature drifts, repeats and jumps inside each batch */
+    for (j = 0; j < 0x1000000; j += BATCH_LENGTH)
+    {
+        for (i = 0; i < BATCH_LENGTH; i++)
+        {
+            if ((i % 5) == 0)
+            {
+                gs_temperature_raw[i] = a_random_temperature(calibration);
+            }
+            else if ((i % 5) == 4)
+            {
+                gs_temperature_raw[i] = gs_temperature_raw[i - 1] + 1;
+            }
+            else
+            {
+                gs_temperature_raw[i] = gs_temperature_raw[i - 1];
+            }
+            gs_pressure_raw[i] = (j + i) & 0xFFFFFF;
+        }
+        if (a_bmp384_batch_check(calibration, BATCH_LENGTH) != 0)
+        {
+            return 1;
+        }
+    }
+    
+    /* check random raws and every length up to the batch length */
+    for (j = 0; j < 0x10000; j++)
+    {
+        len = (j % BATCH_LENGTH) + 1;
+        for (i = 0; i < len; i++)
+        {
+            gs_temperature_raw[i] = a_random_temperature(calibration);
+            gs_pressure_raw[i] = a_random() & 0xFFFFFF;
+        }
+        if (a_bmp384_batch_check(calibration, len) != 0)
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  batch host test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   bmp384_compensate_batch is checked bit exact against the scalar kernel
+ *         with raw temperatures in the -40C to 85C operating range
+ */
+int main(void)
+{
+    uint32_t i;
+    
+#if (BMP384_COMPENSATE_BATCH_SIMD == 1) && defined(__AVX2__)
+    printf("bmp384: batch kernel is avx2.\n");
+#elif (BMP384_COMPENSATE_BATCH_SIMD == 1) && defined(__SSE4_1__)
+    printf("bmp384: batch kernel is sse4.1.\n");
+#elif (BMP384_COMPENSATE_BATCH_SIMD == 1) && defined(__ARM_NEON)
+    printf("bmp384: batch kernel is neon.\n");
+#else
+    printf("bmp384: batch kernel is scalar.\n");
+#endif
+    for (i = 0; i < sizeof(gs_calibration) / sizeof(gs_calibration[0]); i++)
+    {
+        if (a_bmp384_calibration_check(&gs_calibration[i]) != 0)
+        {
+            return 1;
+        }
+        printf("bmp384: calibration set %d check ok.\n", (int)i);
+    }
+    printf("bmp384: finish batch host test.\n");
+    
+    return 0;
+}
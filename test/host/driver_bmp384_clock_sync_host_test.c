@@ -0,0 +1,276 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_bmp384_clock_sync_host_test.c
+ * @brief     driver bmp384 clock sync host test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "../../src/driver_bmp384.c"
+#include <stdio.h>
+
+/**
+ * @brief test definition
+ */
+#define SENSORTIME_START     0xFFF000        /**< first sensor time, just before the 24 bits wrap */
+#define PAIR_PERIOD_NS       1000000000LL    /**< host time between two pairs */
+#define JITTER_NS            2000            /**< max host time jitter of a pair */
+
+static bmp384_handle_t gs_handle;            /**< bmp384 handle */
+static bmp384_clock_sync_t gs_sync;          /**< clock sync */
+static uint8_t gs_buf[16 * 7 + 4];           /**< fifo buffer */
+static bmp384_sample_t gs_sample[16];        /**< sample buffer */
+static uint32_t gs_seed = 0x2468ACE1;        /**< random seed */
+static uint64_t gs_sensor_ns;                /**< sensor clock in host ns */
+static int64_t gs_ticks;                     /**< unwrapped sensor time */
+
+/**
+ * @brief  get a random number
+ * @return random number
+ * @note   xorshift32
+ */
+static uint32_t a_random(void)
+{
+    gs_seed ^= gs_seed << 13;
+    gs_seed ^= gs_seed >> 17;
+    gs_seed ^= gs_seed << 5;
+    
+    return gs_seed;
+}
+
+/**
+ * @brief     debug print
+ * @param[in] fmt format data
+ * @note      the driver messages are dropped
+ */
+static void a_debug_print(const char *const fmt, ...)
+{
+    (void)fmt;
+}
+
+/**
+ * @brief     get the host time of an unwrapped sensor time
+ * @param[in] ticks unwrapped sensor time
+ * @param[in] ppm sensor clock drift
+ * @return    host time in ns
+ * @note      the sensor clock starts at 1s host time
+ */
+static double a_host_ns(int64_t ticks, double ppm)
+{
+    return 1000000000.0 + (double)ticks * BMP384_SENSORTIME_TICK_NS * (1.0 + ppm / 1000000.0);
+}
+
+/**
+ * @brief     add pairs with a known drift
+ * @param[in] num pair number
+ * @param[in] ppm sensor clock drift
+ * @return    status code
+ *            - 0 success
+ *            - 1 update failed
+ * @note      the host time of each pair has up to JITTER_NS of jitter
+ */
+static uint8_t a_add_pairs(uint32_t num, double ppm)
+{
+    uint32_t i;
+    uint64_t host_ns;
+    
+    for (i = 0; i < num; i++)
+    {
+        gs_ticks += (int64_t)((double)PAIR_PERIOD_NS / (BMP384_SENSORTIME_TICK_NS * (1.0 + ppm / 1000000.0)));
+        host_ns = (uint64_t)a_host_ns(gs_ticks, ppm) + gs_sensor_ns + (a_random() % (2 * JITTER_NS)) - JITTER_NS;
+        if (bmp384_clock_sync_update(&gs_sync, (uint32_t)(SENSORTIME_START + gs_ticks) & 0xFFFFFF, host_ns) != 0)
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     check the drift estimation
+ * @param[in] ppm expected drift
+ * @param[in] tolerance max drift error in ppm
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      none
+ */
+static uint8_t a_drift_check(double ppm, double tolerance)
+{
+    double drift;
+    
+    if (bmp384_clock_sync_get_drift(&gs_sync, &drift) != 0)
+    {
+        return 1;
+    }
+    printf("bmp384: drift is %0.3fppm, expected %0.3fppm.\n", drift, ppm);
+    if ((drift < ppm - tolerance) || (drift > ppm + tolerance))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     check the conversion of the back filled fifo sensor times
+ * @param[in] ppm sensor clock drift
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      the fifo ends at the sensor time of the last pair and its samples cross the 24 bits wrap
+ */
+static uint8_t a_fifo_convert_check(double ppm)
+{
+    uint16_t j;
+    uint16_t sample_len;
+    uint32_t raw;
+    uint32_t step;
+    uint64_t host_ns;
+    double expect;
+    
+    /* odr 12.5Hz and fifo subsampling 0 in the register shadow */
+    memset(&gs_handle, 0, sizeof(bmp384_handle_t));
+    gs_handle.inited = 1;
+    gs_handle.debug_print = a_debug_print;
+    gs_handle.shadow[BMP384_REG_ODR - BMP384_REG_FIFO_WTM_0] = BMP384_ODR_12P5_HZ;
+    gs_handle.shadow_enable = 1;
+    step = (uint32_t)BMP384_FIFO_SENSORTIME_PERIOD << BMP384_ODR_12P5_HZ;
+    
+    /* make the fifo frames */
+    raw = (uint32_t)(SENSORTIME_START + gs_ticks) & 0xFFFFFF;
+    if (raw >= 15 * step)
+    {
+        printf("bmp384: fifo does not cross the wrap.\n");
+        
+        return 1;
+    }
+    for (j = 0; j < 16; j++)
+    {
+        gs_buf[j * 7 + 0] = 0x94;
+        gs_buf[j * 7 + 1] = 0x00;
+        gs_buf[j * 7 + 2] = 0x00;
+        gs_buf[j * 7 + 3] = 0x80;
+        gs_buf[j * 7 + 4] = 0x00;
+        gs_buf[j * 7 + 5] = 0x00;
+        gs_buf[j * 7 + 6] = 0x60;
+    }
+    gs_buf[16 * 7 + 0] = 0xA0;
+    gs_buf[16 * 7 + 1] = (raw >> 0) & 0xFF;
+    gs_buf[16 * 7 + 2] = (raw >> 8) & 0xFF;
+    gs_buf[16 * 7 + 3] = (raw >> 16) & 0xFF;
+    
+    /* parse the samples */
+    sample_len = 16;
+    if ((bmp384_fifo_parse_sample(&gs_handle, gs_buf, sizeof(gs_buf), gs_sample, &sample_len) != 0) || (sample_len != 16))
+    {
+        printf("bmp384: fifo parse sample failed.\n");
+        
+        return 1;
+    }
+    
+    /* convert each sample to the host time */
+    for (j = 0; j < 16; j++)
+    {
+        if ((gs_sample[j].sensortime & BMP384_SAMPLE_SENSORTIME_VALID) == 0)
+        {
+            printf("bmp384: sample %d has no sensor time.\n", j);
+            
+            return 1;
+        }
+        if (bmp384_clock_sync_convert(&gs_sync, gs_sample[j].sensortime & 0xFFFFFF, &host_ns) != 0)
+        {
+            printf("bmp384: clock sync convert failed.\n");
+            
+            return 1;
+        }
+        expect = a_host_ns(gs_ticks - (int64_t)(15 - j) * step, ppm) + (double)gs_sensor_ns;
+        if (((double)host_ns < expect - 2 * JITTER_NS) || ((double)host_ns > expect + 2 * JITTER_NS))
+        {
+            printf("bmp384: sample %d host time %llu is not %0.0f.\n", j, (unsigned long long)host_ns, expect);
+            
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  clock sync host test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   none
+ */
+int main(void)
+{
+    /* the sensor clock runs 150ppm slow over 2000s, the 24 bits sensor time wraps 3 times */
+    (void)bmp384_clock_sync_reset(&gs_sync);
+    gs_ticks = 0;
+    gs_sensor_ns = 0;
+    if (a_add_pairs(2000, 150.0) != 0)
+    {
+        return 1;
+    }
+    if (a_drift_check(150.0, 0.05) != 0)
+    {
+        return 1;
+    }
+    
+    /* step the sensor time to just after a wrap and check the fifo conversion */
+    gs_ticks += (int64_t)(0x1000000 - ((SENSORTIME_START + gs_ticks) & 0xFFFFFF)) + 0x400 - 
+                (int64_t)((double)PAIR_PERIOD_NS / (BMP384_SENSORTIME_TICK_NS * (1.0 + 150.0 / 1000000.0)));
+    if (a_add_pairs(1, 150.0) != 0)
+    {
+        return 1;
+    }
+    if (a_fifo_convert_check(150.0) != 0)
+    {
+        return 1;
+    }
+    printf("bmp384: fifo sensor time convert check ok.\n");
+    
+    /* the drift changes to 80ppm fast, the old pairs must fade out */
+    gs_sensor_ns = (uint64_t)(a_host_ns(gs_ticks, 150.0) - a_host_ns(gs_ticks, -80.0));
+    if (a_add_pairs(20 * BMP384_CLOCK_SYNC_WINDOW, -80.0) != 0)
+    {
+        return 1;
+    }
+    if (a_drift_check(-80.0, 0.5) != 0)
+    {
+        return 1;
+    }
+    printf("bmp384: finish clock sync host test.\n");
+    
+    return 0;
+}
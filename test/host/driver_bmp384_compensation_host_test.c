@@ -0,0 +1,327 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_bmp384_compensation_host_test.c
+ * @brief     driver bmp384 compensation host test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "../../src/driver_bmp384.c"
+#include <stdio.h>
+
+/**
+ * @brief calibration test sets
+ * @note  a typical set, then the typical set with each coefficient at its type minimum and maximum
+ */
+static const bmp384_calibration_t gs_calibration[] =
+{
+    {27675, 18846, -10, -7105, 2607, 26, -1, 12035, 27771, 29, -8, -2843, 3, -60},
+    {0, 18846, -10, -7105, 2607, 26, -1, 12035, 27771, 29, -8, -2843, 3, -60},
+    {65535, 18846, -10, -7105, 2607, 26, -1, 12035, 27771, 29, -8, -2843, 3, -60},
+    {27675, 0, -10, -7105, 2607, 26, -1, 12035, 27771, 29, -8, -2843, 3, -60},
+    {27675, 65535, -10, -7105, 2607, 26, -1, 12035, 27771, 29, -8, -2843, 3, -60},
+    {27675, 18846, -128, -7105, 2607, 26, -1, 12035, 27771, 29, -8, -2843, 3, -60},
+    {27675, 18846, 127, -7105, 2607, 26, -1, 12035, 27771, 29, -8, -2843, 3, -60},
+    {27675, 18846, -10, -32768, 2607, 26, -1, 12035, 27771, 29, -8, -2843, 3, -60},
+    {27675, 18846, -10, 32767, 2607, 26, -1, 12035, 27771, 29, -8, -2843, 3, -60},
+    {27675, 18846, -10, -7105, -32768, 26, -1, 12035, 27771, 29, -8, -2843, 3, -60},
+    {27675, 18846, -10, -7105, 32767, 26, -1, 12035, 27771, 29, -8, -2843, 3, -60},
+    {27675, 18846, -10, -7105, 2607, -128, -1, 12035, 27771, 29, -8, -2843, 3, -60},
+    {27675, 18846, -10, -7105, 2607, 127, -1, 12035, 27771, 29, -8, -2843, 3, -60},
+    {27675, 18846, -10, -7105, 2607, 26, -128, 12035, 27771, 29, -8, -2843, 3, -60},
+    {27675, 18846, -10, -7105, 2607, 26, 127, 12035, 27771, 29, -8, -2843, 3, -60},
+    {27675, 18846, -10, -7105, 2607, 26, -1, 0, 27771, 29, -8, -2843, 3, -60},
+    {27675, 18846, -10, -7105, 2607, 26, -1, 65535, 27771, 29, -8, -2843, 3, -60},
+    {27675, 18846, -10, -7105, 2607, 26, -1, 12035, 0, 29, -8, -2843, 3, -60},
+    {27675, 18846, -10, -7105, 2607, 26, -1, 12035, 65535, 29, -8, -2843, 3, -60},
+    {27675, 18846, -10, -7105, 2607, 26, -1, 12035, 27771, -128, -8, -2843, 3, -60},
+    {27675, 18846, -10, -7105, 2607, 26, -1, 12035, 27771, 127, -8, -2843, 3, -60},
+    {27675, 18846, -10, -7105, 2607, 26, -1, 12035, 27771, 29, -128, -2843, 3, -60},
+    {27675, 18846, -10, -7105, 2607, 26, -1, 12035, 27771, 29, 127, -2843, 3, -60},
+    {27675, 18846, -10, -7105, 2607, 26, -1, 12035, 27771, 29, -8, -32768, 3, -60},
+    {27675, 18846, -10, -7105, 2607, 26, -1, 12035, 27771, 29, -8, 32767, 3, -60},
+    {27675, 18846, -10, -7105, 2607, 26, -1, 12035, 27771, 29, -8, -2843, -128, -60},
+    {27675, 18846, -10, -7105, 2607, 26, -1, 12035, 27771, 29, -8, -2843, 127, -60},
+    {27675, 18846, -10, -7105, 2607, 26, -1, 12035, 27771, 29, -8, -2843, 3, -128},
+    {27675, 18846, -10, -7105, 2607, 26, -1, 12035, 27771, 29, -8, -2843, 3, 127},
+};
+
+/**
+ * @brief t_fine test points at -40C, 0C, 25C and 85C, t_fine = temperature * 16384 / 25
+ */
+static const int64_t gs_t_fine[] =
+{
+    -2621440LL, -1, 0, 1, 1638400LL, 5570560LL,
+};
+
+/**
+ * @brief      reference pressure terms
+ * @param[in]  *calibration pointer to a bmp384 calibration structure
+ * @param[in]  t_fine t_fine from the temperature calculation
+ * @param[out] *terms pointer to a pressure terms structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 the int64 formula overflows
+ * @note       division based datasheet formula with checked int64 arithmetic
+ */
+static uint8_t a_reference_pressure_terms(const bmp384_calibration_t *calibration, int64_t t_fine, bmp384_pressure_terms_t *terms)
+{
+    uint8_t err;
+    int64_t partial_data1;
+    int64_t partial_data2;
+    int64_t partial_data3;
+    int64_t partial_data4;
+    int64_t partial_data5;
+    int64_t partial_data6;
+    int64_t offset;
+    int64_t sensitivity;
+    int64_t linear;
+    
+    err = 0;
+    err |= __builtin_mul_overflow(t_fine, t_fine, &partial_data1);
+    partial_data2 = partial_data1 / 64;
+    err |= __builtin_mul_overflow(partial_data2, t_fine, &partial_data3);
+    partial_data3 = partial_data3 / 256;
+    err |= __builtin_mul_overflow((int64_t)calibration->p8, partial_data3, &partial_data4);
+    partial_data4 = partial_data4 / 32;
+    err |= __builtin_mul_overflow((int64_t)calibration->p7, partial_data1, &partial_data5);
+    err |= __builtin_mul_overflow(partial_data5, (int64_t)16, &partial_data5);
+    err |= __builtin_mul_overflow((int64_t)calibration->p6, t_fine, &partial_data6);
+    err |= __builtin_mul_overflow(partial_data6, (int64_t)4194304, &partial_data6);
+    err |= __builtin_mul_overflow((int64_t)calibration->p5, (int64_t)140737488355328LL, &offset);
+    err |= __builtin_add_overflow(offset, partial_data4, &offset);
+    err |= __builtin_add_overflow(offset, partial_data5, &offset);
+    err |= __builtin_add_overflow(offset, partial_data6, &offset);
+    err |= __builtin_mul_overflow((int64_t)calibration->p4, partial_data3, &partial_data2);
+    partial_data2 = partial_data2 / 32;
+    err |= __builtin_mul_overflow((int64_t)calibration->p3, partial_data1, &partial_data4);
+    err |= __builtin_mul_overflow(partial_data4, (int64_t)4, &partial_data4);
+    err |= __builtin_mul_overflow((int64_t)calibration->p2 - 16384, t_fine, &partial_data5);
+    err |= __builtin_mul_overflow(partial_data5, (int64_t)2097152, &partial_data5);
+    err |= __builtin_mul_overflow((int64_t)calibration->p1 - 16384, (int64_t)70368744177664LL, &sensitivity);
+    err |= __builtin_add_overflow(sensitivity, partial_data2, &sensitivity);
+    err |= __builtin_add_overflow(sensitivity, partial_data4, &sensitivity);
+    err |= __builtin_add_overflow(sensitivity, partial_data5, &sensitivity);
+    err |= __builtin_mul_overflow((int64_t)calibration->p10, t_fine, &linear);
+    err |= __builtin_add_overflow(linear, (int64_t)65536 * calibration->p9, &linear);
+    terms->t_fine = t_fine;
+    terms->offset = offset / 4;
+    terms->sensitivity = sensitivity / 16777216;
+    terms->linear = linear;
+    
+    return err;
+}
+
+/**
+ * @brief      reference pressure from the terms
+ * @param[in]  *calibration pointer to a bmp384 calibration structure
+ * @param[in]  *terms pointer to a pressure terms structure
+ * @param[in]  data raw pressure
+ * @param[out] *pressure pointer to a compensated pressure buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 the int64 formula overflows
+ * @note       division based datasheet formula with checked int64 arithmetic
+ */
+static uint8_t a_reference_pressure_raw(const bmp384_calibration_t *calibration, const bmp384_pressure_terms_t *terms, 
+                                        uint32_t data, int64_t *pressure)
+{
+    uint8_t err;
+    int64_t partial_data1;
+    int64_t partial_data2;
+    int64_t partial_data3;
+    int64_t partial_data4;
+    int64_t partial_data5;
+    int64_t partial_data6;
+    
+    err = 0;
+    err |= __builtin_mul_overflow(terms->sensitivity, (int64_t)data, &partial_data1);
+    err |= __builtin_mul_overflow(terms->linear, (int64_t)data, &partial_data4);
+    partial_data4 = partial_data4 / 8192;
+    err |= __builtin_mul_overflow(partial_data4, (int64_t)data, &partial_data5);
+    partial_data5 = partial_data5 / 512;
+    partial_data6 = (int64_t)((uint64_t)data * (uint64_t)data);
+    err |= __builtin_mul_overflow((int64_t)calibration->p11, partial_data6, &partial_data2);
+    partial_data2 = partial_data2 / 65536;
+    err |= __builtin_mul_overflow(partial_data2, (int64_t)data, &partial_data3);
+    partial_data3 = partial_data3 / 128;
+    err |= __builtin_add_overflow(terms->offset, partial_data1, &partial_data4);
+    err |= __builtin_add_overflow(partial_data4, partial_data5, &partial_data4);
+    err |= __builtin_add_overflow(partial_data4, partial_data3, &partial_data4);
+    *pressure = (int64_t)(((uint64_t)partial_data4 * 25) / (uint64_t)1099511627776U);
+    
+    return err;
+}
+
+/**
+ * @brief      check the pressure terms of all raw temperatures
+ * @param[in]  *calibration pointer to a bmp384 calibration structure
+ * @param[out] *skip pointer to a skipped raw temperature counter
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      none
+ */
+static uint8_t a_bmp384_terms_check(const bmp384_calibration_t *calibration, uint32_t *skip)
+{
+    uint32_t raw;
+    int64_t t_fine;
+    int64_t temperature;
+    bmp384_pressure_terms_t terms;
+    bmp384_pressure_terms_t terms_check;
+    
+    for (raw = 0; raw < 0x1000000; raw++)
+    {
+        /* skip the raw temperatures outside the operating range */
+        temperature = a_bmp384_calculate_temperature(calibration, raw, &t_fine);
+        if ((temperature < (int64_t)(TEMPERATURE_MIN * 100.0f)) || (temperature > (int64_t)(TEMPERATURE_MAX * 100.0f)))
+        {
+            continue;
+        }
+        
+        /* skip the t_fine where the datasheet formula overflows */
+        if (a_reference_pressure_terms(calibration, t_fine, &terms) != 0)
+        {
+            (*skip)++;
+            
+            continue;
+        }
+        a_bmp384_calculate_pressure_terms(calibration, t_fine, &terms_check);
+        if ((terms_check.offset != terms.offset) || (terms_check.sensitivity != terms.sensitivity) ||
+            (terms_check.linear != terms.linear))
+        {
+            printf("bmp384: temperature raw 0x%06X t_fine %lld terms check error.\n", (unsigned int)raw, (long long)t_fine);
+            
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      check the pressure of all raw pressures at one t_fine
+ * @param[in]  *calibration pointer to a bmp384 calibration structure
+ * @param[in]  t_fine t_fine
+ * @param[out] *skip pointer to a skipped raw pressure counter
+ * @return    status code
+ *            - 0 success
+ *            - 1 check failed
+ * @note      none
+ */
+static uint8_t a_bmp384_pressure_check(const bmp384_calibration_t *calibration, int64_t t_fine, uint32_t *skip)
+{
+    uint32_t raw;
+    int64_t pressure;
+    int64_t pressure_check;
+    bmp384_pressure_terms_t terms;
+    bmp384_pressure_terms_t terms_check;
+    
+    /* skip the t_fine where the datasheet formula overflows */
+    if (a_reference_pressure_terms(calibration, t_fine, &terms) != 0)
+    {
+        (*skip) += 0x1000000;
+        
+        return 0;
+    }
+    a_bmp384_calculate_pressure_terms(calibration, t_fine, &terms_check);
+    for (raw = 0; raw < 0x1000000; raw++)
+    {
+        /* skip the raw pressures where the datasheet formula overflows */
+        if (a_reference_pressure_raw(calibration, &terms, raw, &pressure) != 0)
+        {
+            (*skip)++;
+            
+            continue;
+        }
+        pressure_check = a_bmp384_calculate_pressure_raw(calibration, &terms_check, raw);
+        if (pressure_check != pressure)
+        {
+            printf("bmp384: t_fine %lld pressure raw 0x%06X check error %lld != %lld.\n", (long long)t_fine, 
+                   (unsigned int)raw, (long long)pressure_check, (long long)pressure);
+            
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  compensation host test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   every raw temperature in the -40C to 85C operating range and every raw pressure of each calibration set
+ *         is checked against the division based formula with the full int64 output,
+ *         the inputs where the int64 datasheet formula itself overflows are skipped and counted
+ */
+int main(void)
+{
+    uint32_t i;
+    uint32_t j;
+    uint32_t terms_skip;
+    uint32_t pressure_skip;
+    
+    printf("bmp384: pressure kernel is %s.\n", BMP384_COMPENSATE_PRESSURE_SHIFT == 1 ? "shift" : "division");
+    for (i = 0; i < sizeof(gs_calibration) / sizeof(gs_calibration[0]); i++)
+    {
+        /* check the terms of all raw temperatures */
+        terms_skip = 0;
+        if (a_bmp384_terms_check(&gs_calibration[i], &terms_skip) != 0)
+        {
+            return 1;
+        }
+        
+        /* check all raw pressures at the t_fine points */
+        pressure_skip = 0;
+        for (j = 0; j < sizeof(gs_t_fine) / sizeof(gs_t_fine[0]); j++)
+        {
+            if (a_bmp384_pressure_check(&gs_calibration[i], gs_t_fine[j], &pressure_skip) != 0)
+            {
+                return 1;
+            }
+        }
+        
+        /* the typical set must not overflow */
+        if ((i == 0) && ((terms_skip != 0) || (pressure_skip != 0)))
+        {
+            printf("bmp384: typical calibration set overflows.\n");
+            
+            return 1;
+        }
+        printf("bmp384: calibration set %d check ok, %u terms and %u pressures skipped.\n", (int)i, 
+               (unsigned int)terms_skip, (unsigned int)pressure_skip);
+    }
+    printf("bmp384: finish compensation host test.\n");
+    
+    return 0;
+}
@@ -0,0 +1,487 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_bmp384_spi_fifo_host_test.c
+ * @brief     driver bmp384 spi fifo host test source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-17
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/17  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "../../src/driver_bmp384.c"
+#include <stdio.h>
+
+/**
+ * @brief test definition
+ */
+#define SCRATCH_LENGTH       65         /**< 64 bytes of data per spi chunk */
+#define FIFO_FRAME_NUM       73         /**< 73 temperature and pressure frames fill the 511 bytes fifo counter */
+#define FIFO_LENGTH          (FIFO_FRAME_NUM * 7)        /**< fifo length */
+#define FIFO_SENSORTIME      0x123456   /**< sensor time frame value */
+#define IRQ_BUFFER_LENGTH    100        /**< irq buffer length, not a multiple of the frame length */
+
+static bmp384_handle_t gs_handle;                        /**< bmp384 handle */
+static uint8_t gs_scratch[SCRATCH_LENGTH];               /**< caller scratch buffer */
+static uint8_t gs_buf[FIFO_LENGTH + 4 + 16];             /**< fifo buffer */
+static bmp384_frame_t gs_frame[256];                     /**< frame buffer */
+static bmp384_sample_t gs_sample[128];                   /**< sample buffer */
+static uint8_t gs_reg[128];                              /**< mock registers */
+static uint8_t gs_fifo[FIFO_LENGTH + 4];                 /**< mock fifo with the sensor time frame */
+static uint16_t gs_fifo_pos;                             /**< mock fifo read position */
+static uint16_t gs_fifo_read_num;                        /**< fifo data spi read number */
+static uint8_t gs_spi_error;                             /**< spi error flag */
+static uint8_t gs_irq_buf[IRQ_BUFFER_LENGTH];            /**< irq fifo buffer */
+static bmp384_sample_t gs_irq_sample[128];               /**< irq sample buffer */
+static bmp384_sample_t gs_irq_sample_total[128];         /**< all irq samples */
+static uint16_t gs_irq_sample_num;                       /**< irq sample number */
+static uint16_t gs_irq_call_num;                         /**< irq receive data callback number */
+static uint8_t gs_irq_type;                              /**< irq receive data callback type */
+
+/**
+ * @brief calibration data of the mock
+ */
+static const uint8_t gs_calibration[21] =
+{
+    0x1B, 0x6C, 0x9E, 0x49, 0xF6, 0x3F, 0xE4, 0x2F, 0x0A, 0x1A, 0xFF,
+    0x03, 0x2F, 0x7B, 0x6C, 0x1D, 0xF8, 0xE5, 0xF4, 0x03, 0xC4,
+};
+
+/**
+ * @brief  mock reset
+ * @note   chip id, calibration, command ready and the config reset values
+ */
+static void a_mock_reset(void)
+{
+    memset(gs_reg, 0, sizeof(gs_reg));
+    gs_reg[0x00] = 0x50;
+    gs_reg[0x03] = 0x10;
+    memcpy(&gs_reg[0x31], gs_calibration, 21);
+    gs_reg[0x15] = 0x01;
+    gs_reg[0x16] = 0x01;
+    gs_reg[0x17] = 0x02;
+    gs_reg[0x18] = 0x02;
+    gs_reg[0x19] = 0x02;
+    gs_reg[0x1C] = 0x02;
+}
+
+/**
+ * @brief  mock fifo fill
+ * @note   the fifo holds FIFO_FRAME_NUM frames and the sensor time frame is read after them
+ */
+static void a_mock_fifo_fill(void)
+{
+    uint16_t i;
+    
+    for (i = 0; i < FIFO_FRAME_NUM; i++)
+    {
+        gs_fifo[i * 7 + 0] = 0x94;
+        gs_fifo[i * 7 + 1] = (uint8_t)i;
+        gs_fifo[i * 7 + 2] = 0x00;
+        gs_fifo[i * 7 + 3] = 0x80;
+        gs_fifo[i * 7 + 4] = (uint8_t)i;
+        gs_fifo[i * 7 + 5] = 0x00;
+        gs_fifo[i * 7 + 6] = 0x60;
+    }
+    gs_fifo[FIFO_LENGTH + 0] = 0xA0;
+    gs_fifo[FIFO_LENGTH + 1] = (FIFO_SENSORTIME >> 0) & 0xFF;
+    gs_fifo[FIFO_LENGTH + 2] = (FIFO_SENSORTIME >> 8) & 0xFF;
+    gs_fifo[FIFO_LENGTH + 3] = (FIFO_SENSORTIME >> 16) & 0xFF;
+    gs_fifo_pos = 0;
+    gs_reg[0x12] = FIFO_LENGTH & 0xFF;
+    gs_reg[0x13] = (FIFO_LENGTH >> 8) & 0x01;
+}
+
+/**
+ * @brief     mock register read
+ * @param[in] reg register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @note      the fifo data register returns fifo empty frames after the sensor time frame
+ */
+static void a_mock_read(uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint16_t i;
+    
+    for (i = 0; i < len; i++)
+    {
+        if (reg == BMP384_REG_FIFO_DATA)
+        {
+            buf[i] = (gs_fifo_pos < sizeof(gs_fifo)) ? gs_fifo[gs_fifo_pos++] : 0x80;
+        }
+        else
+        {
+            buf[i] = gs_reg[(reg + i) & 0x7F];
+        }
+    }
+}
+
+/**
+ * @brief     mock register write
+ * @param[in] reg register address
+ * @param[in] data written data
+ * @note      none
+ */
+static void a_mock_write(uint8_t reg, uint8_t data)
+{
+    if (reg == BMP384_REG_CMD)
+    {
+        if (data == 0xB6)
+        {
+            a_mock_reset();
+        }
+        
+        return;
+    }
+    gs_reg[reg & 0x7F] = data;
+}
+
+/**
+ * @brief  mock bus init
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+static uint8_t a_mock_init(void)
+{
+    return 0;
+}
+
+/**
+ * @brief     mock iic read
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 1 read failed
+ * @note      the test runs on spi only
+ */
+static uint8_t a_mock_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    (void)addr;
+    (void)reg;
+    (void)buf;
+    (void)len;
+    
+    return 1;
+}
+
+/**
+ * @brief     mock iic write
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data length
+ * @return    status code
+ *            - 1 write failed
+ * @note      the test runs on spi only
+ */
+static uint8_t a_mock_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    (void)addr;
+    (void)reg;
+    (void)buf;
+    (void)len;
+    
+    return 1;
+}
+
+/**
+ * @brief      mock spi read
+ * @param[in]  reg register address with the read bit
+ * @param[out] *buf pointer to a data buffer, buf[0] is the dummy byte
+ * @param[in]  len data length with the dummy byte
+ * @return     status code
+ *             - 0 success
+ * @note       each call is one chip select
+ */
+static uint8_t a_mock_spi_read(uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    if ((len < 2) || (len > SCRATCH_LENGTH) || (buf != gs_scratch))
+    {
+        gs_spi_error = 1;
+    }
+    if ((reg & 0x7F) == BMP384_REG_FIFO_DATA)
+    {
+        gs_fifo_read_num++;
+    }
+    buf[0] = 0xFF;
+    a_mock_read(reg & 0x7F, buf + 1, len - 1);
+    
+    return 0;
+}
+
+/**
+ * @brief     mock spi write
+ * @param[in] reg first register address
+ * @param[in] *buf pointer to the data and the address data pairs after it
+ * @param[in] len data length
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+static uint8_t a_mock_spi_write(uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint16_t i;
+    
+    a_mock_write(reg & 0x7F, buf[0]);
+    for (i = 1; i + 1 < len; i += 2)
+    {
+        a_mock_write(buf[i] & 0x7F, buf[i + 1]);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     mock delay
+ * @param[in] ms time
+ * @note      none
+ */
+static void a_mock_delay_ms(uint32_t ms)
+{
+    (void)ms;
+}
+
+/**
+ * @brief     debug print
+ * @param[in] fmt format data
+ * @note      none
+ */
+static void a_debug_print(const char *const fmt, ...)
+{
+    (void)fmt;
+}
+
+/**
+ * @brief     receive callback
+ * @param[in] type interrupt type
+ * @note      none
+ */
+static void a_receive_callback(uint8_t type)
+{
+    (void)type;
+}
+
+/**
+ * @brief     receive data callback
+ * @param[in] type interrupt type
+ * @param[in] *sample pointer to a sample buffer
+ * @param[in] len sample length
+ * @note      the samples of all calls are collected in gs_irq_sample_total
+ */
+static void a_receive_data_callback(uint8_t type, bmp384_sample_t *sample, uint16_t len)
+{
+    uint16_t i;
+    
+    for (i = 0; (i < len) && (gs_irq_sample_num < 128); i++)
+    {
+        gs_irq_sample_total[gs_irq_sample_num] = sample[i];
+        gs_irq_sample_num++;
+    }
+    gs_irq_type = type;
+    gs_irq_call_num++;
+}
+
+/**
+ * @brief  spi fifo host test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   a full fifo with the sensor time frame is drained over the spi bounce path in 64 bytes chunks,
+ *         then through the irq handler with a buffer smaller than the fifo
+ */
+int main(void)
+{
+    uint16_t len;
+    uint16_t frame_len;
+    uint16_t sample_len;
+    
+    /* link functions */
+    DRIVER_BMP384_LINK_INIT(&gs_handle, bmp384_handle_t);
+    DRIVER_BMP384_LINK_IIC_INIT(&gs_handle, a_mock_init);
+    DRIVER_BMP384_LINK_IIC_DEINIT(&gs_handle, a_mock_init);
+    DRIVER_BMP384_LINK_IIC_READ(&gs_handle, a_mock_iic_read);
+    DRIVER_BMP384_LINK_IIC_WRITE(&gs_handle, a_mock_iic_write);
+    DRIVER_BMP384_LINK_SPI_INIT(&gs_handle, a_mock_init);
+    DRIVER_BMP384_LINK_SPI_DEINIT(&gs_handle, a_mock_init);
+    DRIVER_BMP384_LINK_SPI_READ(&gs_handle, a_mock_spi_read);
+    DRIVER_BMP384_LINK_SPI_WRITE(&gs_handle, a_mock_spi_write);
+    DRIVER_BMP384_LINK_DELAY_MS(&gs_handle, a_mock_delay_ms);
+    DRIVER_BMP384_LINK_DEBUG_PRINT(&gs_handle, a_debug_print);
+    DRIVER_BMP384_LINK_RECEIVE_CALLBACK(&gs_handle, a_receive_callback);
+    DRIVER_BMP384_LINK_RECEIVE_DATA_CALLBACK(&gs_handle, a_receive_data_callback);
+    DRIVER_BMP384_LINK_SCRATCH(&gs_handle, gs_scratch, SCRATCH_LENGTH);
+    
+    /* bmp384 init */
+    a_mock_reset();
+    if (bmp384_set_interface(&gs_handle, BMP384_INTERFACE_SPI) != 0)
+    {
+        printf("bmp384: set interface failed.\n");
+        
+        return 1;
+    }
+    if (bmp384_init(&gs_handle) != 0)
+    {
+        printf("bmp384: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* enable the fifo with pressure, temperature and sensor time */
+    if ((bmp384_set_fifo(&gs_handle, BMP384_BOOL_TRUE) != 0) ||
+        (bmp384_set_fifo_pressure_on(&gs_handle, BMP384_BOOL_TRUE) != 0) ||
+        (bmp384_set_fifo_temperature_on(&gs_handle, BMP384_BOOL_TRUE) != 0) ||
+        (bmp384_set_fifo_sensortime_on(&gs_handle, BMP384_BOOL_TRUE) != 0))
+    {
+        printf("bmp384: set fifo failed.\n");
+        
+        return 1;
+    }
+    
+    /* drain the full fifo */
+    a_mock_fifo_fill();
+    gs_fifo_read_num = 0;
+    len = sizeof(gs_buf);
+    if (bmp384_read_fifo(&gs_handle, gs_buf, &len) != 0)
+    {
+        printf("bmp384: read fifo failed.\n");
+        
+        return 1;
+    }
+    if ((len != FIFO_LENGTH + 4) || (gs_spi_error != 0) || 
+        (gs_fifo_read_num != (FIFO_LENGTH + 4 + SCRATCH_LENGTH - 2) / (SCRATCH_LENGTH - 1)) ||
+        (memcmp(gs_buf, gs_fifo, FIFO_LENGTH + 4) != 0))
+    {
+        printf("bmp384: read fifo length %d with %d chunks check failed.\n", len, gs_fifo_read_num);
+        
+        return 1;
+    }
+    printf("bmp384: read fifo length %d with %d chunks.\n", len, gs_fifo_read_num);
+    
+    /* parse the frames */
+    frame_len = 256;
+    if ((bmp384_fifo_parse(&gs_handle, gs_buf, len, gs_frame, &frame_len) != 0) ||
+        (frame_len != FIFO_FRAME_NUM * 2 + 1) || (gs_frame[frame_len - 1].type != BMP384_FRAME_TYPE_SENSORTIME) ||
+        (gs_frame[frame_len - 1].raw != FIFO_SENSORTIME))
+    {
+        printf("bmp384: fifo parse frame %d check failed.\n", frame_len);
+        
+        return 1;
+    }
+    
+    /* parse the samples with the odr and subsampling set behind the driver and the shadow disabled */
+    gs_reg[BMP384_REG_ODR] = 0x03;
+    gs_reg[BMP384_REG_FIFO_CONFIG_2] = 0x01;
+    sample_len = 128;
+    if ((bmp384_fifo_parse_sample(&gs_handle, gs_buf, len, gs_sample, &sample_len) != 0) ||
+        (sample_len != FIFO_FRAME_NUM) || 
+        (gs_sample[FIFO_FRAME_NUM - 1].sensortime != (FIFO_SENSORTIME | BMP384_SAMPLE_SENSORTIME_VALID)) ||
+        (gs_sample[0].sensortime != (((FIFO_SENSORTIME - (uint32_t)(FIFO_FRAME_NUM - 1) * (128 << (3 + 1))) & 0xFFFFFF) | 
+                                     BMP384_SAMPLE_SENSORTIME_VALID)))
+    {
+        printf("bmp384: fifo parse sample %d check failed.\n", sample_len);
+        
+        return 1;
+    }
+    printf("bmp384: fifo parse %d frames and %d samples.\n", frame_len, sample_len);
+    
+    /* drain the full fifo from the irq through a small buffer */
+    a_mock_fifo_fill();
+    gs_reg[BMP384_REG_INT_STATUS] = 1 << 1;
+    gs_irq_sample_num = 0;
+    gs_irq_call_num = 0;
+    if (bmp384_irq_handler_read(&gs_handle, gs_irq_buf, IRQ_BUFFER_LENGTH, gs_irq_sample, 128) != 0)
+    {
+        printf("bmp384: irq handler read failed.\n");
+        
+        return 1;
+    }
+    if ((gs_irq_sample_num != FIFO_FRAME_NUM) || (gs_irq_call_num < 2) || (gs_spi_error != 0) ||
+        (gs_irq_type != BMP384_INTERRUPT_STATUS_FIFO_FULL) || (gs_fifo_pos != FIFO_LENGTH + 4) ||
+        (gs_irq_sample_total[FIFO_FRAME_NUM - 1].sensortime != (FIFO_SENSORTIME | BMP384_SAMPLE_SENSORTIME_VALID)))
+    {
+        printf("bmp384: irq handler read %d samples in %d calls check failed.\n", gs_irq_sample_num, gs_irq_call_num);
+        
+        return 1;
+    }
+    for (len = 0; len < FIFO_FRAME_NUM; len++)
+    {
+        if ((gs_irq_sample_total[len].index != gs_irq_sample_total[0].index + len) ||
+            (BMP384_SAMPLE_RAW(gs_irq_sample_total[len].temperature_raw) != (0x800000U | len)) ||
+            (BMP384_SAMPLE_RAW(gs_irq_sample_total[len].pressure_raw) != (0x600000U | len)))
+        {
+            printf("bmp384: irq handler read sample %d check failed.\n", len);
+            
+            return 1;
+        }
+    }
+    printf("bmp384: irq handler read %d samples in %d calls.\n", gs_irq_sample_num, gs_irq_call_num);
+    
+    /* read the data ready sample with the temperature only */
+    gs_reg[BMP384_REG_INT_STATUS] = 1 << 3;
+    gs_reg[BMP384_REG_STATUS] = (1 << 4) | (1 << 6);
+    gs_reg[0x04] = 0x34;
+    gs_reg[0x07] = 0x12;
+    gs_reg[0x09] = 0x80;
+    gs_irq_sample_num = 0;
+    for (len = 0; len < 2; len++)
+    {
+        if (bmp384_irq_handler_read(&gs_handle, gs_irq_buf, IRQ_BUFFER_LENGTH, gs_irq_sample, 128) != 0)
+        {
+            printf("bmp384: irq handler read failed.\n");
+            
+            return 1;
+        }
+    }
+    if ((gs_irq_sample_num != 2) || (gs_irq_type != BMP384_INTERRUPT_STATUS_DATA_READY) ||
+        (gs_irq_sample_total[0].index != 0) || (gs_irq_sample_total[1].index != 1) ||
+        (BMP384_SAMPLE_RAW(gs_irq_sample_total[1].temperature_raw) != 0x800012) ||
+        (BMP384_SAMPLE_RAW(gs_irq_sample_total[1].pressure_raw) != 0) || (gs_irq_sample_total[1].pressure != 0))
+    {
+        printf("bmp384: irq handler read data ready check failed.\n");
+        
+        return 1;
+    }
+    
+    /* skip the data ready sample without ready data */
+    gs_reg[BMP384_REG_STATUS] = 1 << 4;
+    if ((bmp384_irq_handler_read(&gs_handle, gs_irq_buf, IRQ_BUFFER_LENGTH, gs_irq_sample, 128) != 0) ||
+        (gs_irq_sample_num != 2))
+    {
+        printf("bmp384: irq handler read data not ready check failed.\n");
+        
+        return 1;
+    }
+    printf("bmp384: irq handler read data ready samples.\n");
+    (void)bmp384_deinit(&gs_handle);
+    printf("bmp384: finish spi fifo host test.\n");
+    
+    return 0;
+}